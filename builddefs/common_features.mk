@@ -42,6 +42,11 @@ else
     include $(PLATFORM_PATH)/$(PLATFORM_KEY)/printf.mk
 endif
 
+# Task timing, latency trace and the task scheduler share the microsecond clock
+ifneq ($(filter yes,$(strip $(TASK_TIMING_ENABLE) $(LATENCY_TRACE_ENABLE) $(TASK_SCHEDULER_ENABLE))),)
+    US_TIMER_ENABLE := yes
+endif
+
 ifeq ($(strip $(DEBUG_MATRIX_SCAN_RATE_ENABLE)), yes)
     OPT_DEFS += -DDEBUG_MATRIX_SCAN_RATE
     CONSOLE_ENABLE = yes
@@ -651,6 +656,18 @@ ifeq ($(strip $(DYNAMIC_KEYMAP_ENABLE)), yes)
     SEND_STRING_ENABLE := yes
 endif
 
+ifeq ($(strip $(AUTOCORRECT_ENABLE)), yes)
+    # The EEPROM dictionary is enabled from config.h, and checks uploads with crc16_update()
+    CRC_ENABLE := yes
+endif
+
+ifeq ($(strip $(SEND_STRING_ASYNC_ENABLE)), yes)
+    SEND_STRING_ENABLE := yes
+    DEFERRED_EXEC_ENABLE := yes
+    OPT_DEFS += -DSEND_STRING_ASYNC_ENABLE
+    SRC += $(QUANTUM_DIR)/send_string/send_string_async.c
+endif
+
 VALID_CUSTOM_MATRIX_TYPES:= yes lite no
 
 CUSTOM_MATRIX ?= no
@@ -24,6 +24,7 @@ GENERIC_FEATURES = \
     BATTERY \
     BOOTMAGIC \
     CAPS_WORD \
+    CHORD \
     COMBO \
     COMMAND \
     CONNECTION \
@@ -39,6 +40,7 @@ GENERIC_FEATURES = \
     KEYCODE_STRING \
     KEY_LOCK \
     KEY_OVERRIDE \
+    LATENCY_TRACE \
     LAYER_LOCK \
     LEADER \
     MAGIC \
@@ -47,13 +49,17 @@ GENERIC_FEATURES = \
     OS_DETECTION \
     PROGRAMMABLE_BUTTON \
     REPEAT_KEY \
+    REPORT_COALESCE \
     SECURE \
     SEND_STRING \
     SEQUENCER \
     SPACE_CADET \
     SWAP_HANDS \
     TAP_DANCE \
+    TASK_SCHEDULER \
+    TASK_TIMING \
     TRI_LAYER \
+    US_TIMER \
     VIA \
     VIRTSER \
     WPM \
@@ -28,6 +28,18 @@ void soft_serial_target_init(void);
 
 bool soft_serial_transaction(int sstd_index);
 
+#ifdef SPLIT_MATRIX_PUSH
+// target tells the initiator that it has new data, outside of a transaction
+void soft_serial_target_signal(void);
+// whether the target signalled since the last call, true when the driver has no way to tell
+bool soft_serial_initiator_signalled(void);
+#endif
+
+#ifdef SPLIT_LINK_FRAMING
+// link-quality counters of this half
+void soft_serial_link_stats(split_link_stats_t *stats);
+#endif
+
 #ifdef SERIAL_DEBUG
 #    include <debug.h>
 #    include <print.h>
@@ -241,6 +241,101 @@ def encode_link(link: Dict[str, Any]) -> List[int]:
     return [byte_offset & 255, byte_offset >> 8]
 
 
+def read_packed_nodes(data: bytes) -> Dict[bytes, int]:
+    """Finds the nodes reachable from the root of a packed dictionary image.
+  Args:
+    data: A packed dictionary image.
+  Returns:
+    Dict of node bytes to their offset in the image.
+  """
+    offsets = {}
+    visited = set()
+
+    def visit(offset: int) -> None:
+        if offset in visited:
+            return
+        visited.add(offset)
+        code = data[offset]
+        if code & 128:  # Leaf, followed by a null-terminated string.
+            length = data.index(0, offset + 1) + 1 - offset
+        else:
+            count = code & 63
+            links = 1 if code & 64 else count
+            length = 1 + count + 3 * links
+            for i in range(links):
+                link = offset + 1 + count + 3 * i
+                visit(int.from_bytes(data[link:link + 3], 'little'))
+        offsets[bytes(data[offset:offset + length])] = offset
+
+    if data[0:4] != b'ACD\x01':
+        cli.log.error('{fg_red}Error:{fg_reset} The base file is not a packed autocorrection dictionary.')
+        maybe_exit(1)
+    visit(int.from_bytes(data[12:16], 'little'))
+    return offsets
+
+
+def serialize_packed_trie(autocorrections: List[Tuple[str, str]], trie: Dict[str, Any], base: bytes = b'') -> bytes:
+    """Serializes trie and correction data in the packed format read from external flash.
+  Unlike `serialize_trie`, every link is an absolute 24-bit offset, so identical
+  subtrees (typically shared word endings and corrections) are only stored once,
+  and the 64KB limit does not apply.
+  Given a `base` image, its nodes are reused and new nodes are appended after it,
+  so only the bytes past the end of `base` need to be written to update it.
+  Args:
+    autocorrections: List of (typo, correction) tuples.
+    trie: Dict of dicts.
+    base: A previous dictionary image to extend, if any.
+  Returns:
+    The dictionary image, starting with its 16 byte header.
+  """
+    data = bytearray(base) if base else bytearray(16)
+    offsets = read_packed_nodes(base) if base else {}
+
+    def emit(node: bytes) -> int:
+        if node not in offsets:  # Identical nodes are written once.
+            offsets[node] = len(data)
+            data.extend(node)
+        return offsets[node]
+
+    def link(offset: int) -> List[int]:
+        return [offset & 255, (offset >> 8) & 255, offset >> 16]
+
+    # Traverse trie in depth first order, writing children before their parents.
+    def traverse(trie_node) -> int:
+        if 'LEAF' in trie_node:  # Handle a leaf trie node.
+            typo, correction = trie_node['LEAF']
+            word_boundary_ending = typo[-1] == ':'
+            typo = typo.strip(':')
+            i = 0
+            while i < min(len(typo), len(correction)) and typo[i] == correction[i]:
+                i += 1
+            backspaces = len(typo) - i - 1 + word_boundary_ending
+            assert 0 <= backspaces <= 63
+            return emit(bytes([backspaces + 128]) + bytes(correction[i:], 'ascii') + b'\0')
+        elif len(trie_node) == 1:  # Handle a chain of single-child nodes.
+            keys = []
+            while len(trie_node) == 1 and 'LEAF' not in trie_node and len(keys) < 63:
+                c, trie_node = next(iter(trie_node.items()))
+                keys.append(TYPO_CHARS[c])
+            child = traverse(trie_node)
+            return emit(bytes([64 + len(keys)] + keys + link(child)))
+        else:  # Handle trie node with multiple children, ordered by keycode.
+            chars = sorted(trie_node.keys(), key=lambda c: TYPO_CHARS[c])
+            links = [link(traverse(trie_node[c])) for c in chars]
+            return emit(bytes([len(chars)] + [TYPO_CHARS[c] for c in chars] + [b for lnk in links for b in lnk]))
+
+    root = traverse(trie)
+    if len(data) > 0xffffff:
+        cli.log.error('{fg_red}Error:{fg_reset} The autocorrection table is too large, a node link exceeds 16MB limit.')
+        maybe_exit(1)
+
+    min_typo = min(autocorrections, key=typo_len)[0]
+    max_typo = max(autocorrections, key=typo_len)[0]
+    data[0:8] = b'ACD\x01' + bytes([len(min_typo), len(max_typo), 0, 0])
+    data[8:16] = len(data).to_bytes(4, 'little') + root.to_bytes(4, 'little')
+    return bytes(data)
+
+
 def typo_len(e: Tuple[str, str]) -> int:
     return len(e[0])
 
@@ -254,15 +349,35 @@ def to_hex(b: int) -> str:
 @cli.argument('-km', '--keymap', completer=keymap_completer, help='The keymap to build a firmware for. Ignored when a output file is supplied.')
 @cli.argument('-o', '--output', arg_only=True, type=normpath, help='File to write to')
 @cli.argument('-q', '--quiet', arg_only=True, action='store_true', help="Quiet mode, only output error messages")
+@cli.argument('-p', '--packed', arg_only=True, action='store_true', help="Write a packed dictionary image for AUTOCORRECT_EXTERNAL_DICTIONARY instead of a header")
+@cli.argument('-b', '--base', arg_only=True, type=normpath, help="With --packed, the image currently on the keyboard to append the changes to")
 @cli.subcommand('Generate the autocorrection data file from a dictionary file.')
 def generate_autocorrect_data(cli):
     autocorrections = parse_file(cli.args.filename)
     trie = make_trie(autocorrections)
-    data = serialize_trie(autocorrections, trie)
 
     current_keyboard = cli.args.keyboard or cli.config.user.keyboard or cli.config.generate_autocorrect_data.keyboard
     current_keymap = cli.args.keymap or cli.config.user.keymap or cli.config.generate_autocorrect_data.keymap
 
+    if cli.args.packed:
+        if not cli.args.output and current_keyboard and current_keymap:
+            cli.args.output = locate_keymap(current_keyboard, current_keymap).parent / 'autocorrect_dictionary.bin'
+        if not cli.args.output:
+            cli.log.error('{fg_red}Error:{fg_reset} A packed dictionary needs an output file, pass one with -o.')
+            maybe_exit(1)
+
+        base = cli.args.base.read_bytes() if cli.args.base else b''
+        packed = serialize_packed_trie(autocorrections, trie, base)
+        cli.args.output.parent.mkdir(parents=True, exist_ok=True)
+        cli.args.output.write_bytes(packed)
+        if not cli.args.quiet:
+            cli.log.info('Wrote %d entries in %d bytes to %s.', len(autocorrections), len(packed), cli.args.output)
+            if base:
+                cli.log.info('Only the header and bytes %d to %d need to be written over the base.', len(base), len(packed))
+        return
+
+    data = serialize_trie(autocorrections, trie)
+
     if not cli.args.output and current_keyboard and current_keymap:
         cli.args.output = locate_keymap(current_keyboard, current_keymap).parent / 'autocorrect_data.h'
 
@@ -1,5 +1,6 @@
 """Used by the make system to generate info_config.h from info.json.
 """
+import re
 from pathlib import Path
 from dotty_dict import dotty
 
@@ -47,6 +48,36 @@ def pin_array(define, pins, postfix):
     return generate_define(f'{define}_PINS{postfix}', f'{{ {pin_array} }}')
 
 
+def col_pin_runs(pins, postfix):
+    """Return the config.h lines that describe the column pins as runs of consecutive bits on a single port.
+
+    Each run is emitted as `{ first_pin, mask, first_col, same_port }`, with runs sharing a port placed next to each
+    other and flagged with `same_port`, so that the matrix code reads each port once and shifts every run into place.
+    """
+    runs = []
+
+    for col, pin in enumerate(pins):
+        match = re.fullmatch(r'(GP|[A-Z])(\d+)', str(pin)) if pin else None
+        if not match:
+            return ''
+
+        port, bit = match.group(1), int(match.group(2))
+        if runs and runs[-1]['port'] == port and runs[-1]['bit'] + runs[-1]['width'] == bit:
+            runs[-1]['width'] += 1
+        else:
+            runs.append({'pin': pin, 'port': port, 'bit': bit, 'width': 1, 'col': col})
+
+    ports = list(dict.fromkeys(run['port'] for run in runs))
+    runs.sort(key=lambda run: ports.index(run['port']))
+
+    run_array = []
+    for i, run in enumerate(runs):
+        same_port = 'true' if i and runs[i - 1]['port'] == run['port'] else 'false'
+        run_array.append(f'{{ {run["pin"]}, 0x{(1 << run["width"]) - 1:X}, {run["col"]}, {same_port} }}')
+
+    return generate_define(f'MATRIX_COL_PIN_RUNS{postfix}', f'{{ {", ".join(run_array)} }}')
+
+
 def matrix_pins(matrix_pins, postfix=''):
     """Add the matrix config to the config.h.
     """
@@ -57,6 +88,9 @@ def matrix_pins(matrix_pins, postfix=''):
 
     if 'cols' in matrix_pins:
         pins.append(pin_array('MATRIX_COL', matrix_pins['cols'], postfix))
+        col_runs = col_pin_runs(matrix_pins['cols'], postfix)
+        if col_runs:
+            pins.append(col_runs)
 
     if 'rows' in matrix_pins:
         pins.append(pin_array('MATRIX_ROW', matrix_pins['rows'], postfix))
@@ -188,6 +222,9 @@ def generate_config_h(cli):
 
     generate_config_items(kb_info_json, config_h_lines)
 
+    if cli.args.filename and 'leader_sequences' in user_keymap:
+        config_h_lines.append(generate_define('LEADER_SEQUENCE_TABLE'))
+
     generate_matrix_size(kb_info_json, config_h_lines)
 
     if 'matrix_pins' in kb_info_json:
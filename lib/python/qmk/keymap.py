@@ -16,6 +16,7 @@ from qmk.constants import QMK_FIRMWARE, QMK_USERSPACE, HAS_QMK_USERSPACE
 from qmk.keyboard import find_keyboard_from_dir, keyboard_folder, keyboard_aliases
 from qmk.errors import CppError
 from qmk.info import info_json
+from qmk.keycodes import load_spec
 
 # The `keymap.c` template to use when a keyboard doesn't have its own
 DEFAULT_KEYMAP_C = """#include QMK_KEYBOARD_H
@@ -33,6 +34,7 @@ __INCLUDES__
 __KEYMAP_GOES_HERE__
 __ENCODER_MAP_GOES_HERE__
 __DIP_SWITCH_MAP_GOES_HERE__
+__LEADER_SEQUENCES_GO_HERE__
 __MACRO_OUTPUT_GOES_HERE__
 
 #ifdef OTHER_KEYMAP_C
@@ -80,6 +82,30 @@ def _generate_dipswitchmap_table(keymap_json):
     return lines
 
 
+def _generate_leader_sequences_table(keymap_json):
+    sequences = keymap_json['leader_sequences']
+
+    # The firmware walks a table sorted by keycode like a trie, and has to scan every sequence otherwise
+    values = {}
+    for value, keycode in load_spec('latest')['keycodes'].items():
+        for name in [keycode['key'], *keycode.get('aliases', [])]:
+            values[name] = int(value, 16)
+    if all(key in values for sequence in sequences for key in sequence['sequence']):
+        sequences = sorted(sequences, key=lambda sequence: [values[key] for key in sequence['sequence']])
+
+    lines = [
+        '#if defined(LEADER_ENABLE) && defined(LEADER_SEQUENCE_TABLE)',
+        'const leader_sequence_t PROGMEM leader_sequences[] = {',
+    ]
+    for index, sequence in enumerate(sequences):
+        if index != 0:
+            lines[-1] = lines[-1] + ','
+        keys = ', '.join(map(_strip_any, sequence['sequence']))
+        lines.append(f'    LEADER_SEQUENCE({_strip_any(sequence["keycode"])}, {keys})')
+    lines.extend(['};', '#endif // defined(LEADER_ENABLE) && defined(LEADER_SEQUENCE_TABLE)'])
+    return lines
+
+
 def _generate_macros_function(keymap_json):
     macro_txt = [
         'bool process_record_user(uint16_t keycode, keyrecord_t *record) {',
@@ -283,6 +309,9 @@ def generate_c(keymap_json):
         layers
             An array of arrays describing the keymap. Each item in the inner array should be a string that is a valid QMK keycode.
 
+        leader_sequences
+            An array of objects with the `sequence` of keycodes following the leader key, and the `keycode` it sends.
+
         macros
             A sequence of strings containing macros to implement for this keyboard.
     """
@@ -306,6 +335,12 @@ def generate_c(keymap_json):
         dipswitchmap = '\n'.join(dip_txt)
     new_keymap = new_keymap.replace('__DIP_SWITCH_MAP_GOES_HERE__', dipswitchmap)
 
+    leader_sequences = ''
+    if 'leader_sequences' in keymap_json and keymap_json['leader_sequences'] is not None:
+        leader_txt = _generate_leader_sequences_table(keymap_json)
+        leader_sequences = '\n'.join(leader_txt)
+    new_keymap = new_keymap.replace('__LEADER_SEQUENCES_GO_HERE__', leader_sequences)
+
     macros = ''
     if 'macros' in keymap_json and keymap_json['macros'] is not None:
         macro_txt = _generate_macros_function(keymap_json)
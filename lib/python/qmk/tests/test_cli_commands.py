@@ -1,5 +1,7 @@
 import platform
+from pathlib import Path
 from subprocess import DEVNULL
+from tempfile import TemporaryDirectory
 
 from milc import cli
 
@@ -302,6 +304,7 @@ def test_generate_config_h():
     assert '#    define VENDOR_ID 0xFEED' in result.stdout
     assert '#    define MATRIX_COLS 1' in result.stdout
     assert '#    define MATRIX_COL_PINS { F4 }' in result.stdout
+    assert '#    define MATRIX_COL_PIN_RUNS { { F4, 0x1, 0, false } }' in result.stdout
     assert '#    define MATRIX_ROWS 1' in result.stdout
     assert '#    define MATRIX_ROW_PINS { F5 }' in result.stdout
 
@@ -319,6 +322,21 @@ def test_generate_version_h():
     assert '#define QMK_VERSION' in result.stdout
 
 
+def test_generate_autocorrect_data_packed():
+    # tests/autocorrect/external_dictionary loads dictionary.bin into the firmware, it has to be what the CLI writes
+    with TemporaryDirectory() as tmp:
+        output = Path(tmp) / 'dictionary.bin'
+        result = check_subcommand('generate-autocorrect-data', '--packed', '-o', str(output), 'tests/autocorrect/external_dictionary/dictionary.txt')
+        check_returncode(result)
+        assert 'Wrote 6 entries' in result.stdout
+        assert output.read_bytes() == Path('tests/autocorrect/external_dictionary/dictionary.bin').read_bytes()
+
+        # Appending to its own image adds nothing but the header
+        result = check_subcommand('generate-autocorrect-data', '--packed', '-b', str(output), '-o', str(Path(tmp) / 'appended.bin'), 'tests/autocorrect/external_dictionary/dictionary.txt')
+        check_returncode(result)
+        assert (Path(tmp) / 'appended.bin').read_bytes() == output.read_bytes()
+
+
 def test_format_json_keyboard():
     result = check_subcommand('format-json', '--format', 'keyboard', 'lib/python/qmk/tests/minimal_info.json')
     check_returncode(result)
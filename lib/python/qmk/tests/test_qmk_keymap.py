@@ -28,12 +28,32 @@ const uint16_t PROGMEM keymaps[][MATRIX_ROWS][MATRIX_COLS] = {
 
 
 
+
 #ifdef OTHER_KEYMAP_C
 #    include OTHER_KEYMAP_C
 #endif // OTHER_KEYMAP_C
 """
 
 
+def test_generate_c_leader_sequences():
+    keymap_json = {
+        'keyboard': 'handwired/pytest/basic',
+        'layout': 'LAYOUT',
+        'layers': [['QK_LEAD']],
+        'leader_sequences': [
+            {'sequence': ['KC_D', 'KC_D'], 'keycode': 'KC_4'},
+            {'sequence': ['KC_A', 'KC_B'], 'keycode': 'LCTL(KC_C)'},
+            {'sequence': ['KC_A'], 'keycode': 'KC_1'},
+        ],
+    }
+    templ = qmk.keymap.generate_c(keymap_json)
+    assert """const leader_sequence_t PROGMEM leader_sequences[] = {
+    LEADER_SEQUENCE(KC_1, KC_A),
+    LEADER_SEQUENCE(LCTL(KC_C), KC_A, KC_B),
+    LEADER_SEQUENCE(KC_4, KC_D, KC_D)
+};""" in templ
+
+
 def test_generate_json_pytest_basic():
     templ = qmk.keymap.generate_json('default', 'handwired/pytest/basic', 'LAYOUT', [['KC_A']])
     assert templ == {"keyboard": "handwired/pytest/basic", "keymap": "default", "layout": "LAYOUT", "layers": [["KC_A"]]}
@@ -38,3 +38,8 @@ typedef uint8_t pin_t;
 #define gpio_read_pin(pin) ((bool)(PINx_ADDRESS(pin) & _BV((pin) & 0xF)))
 
 #define gpio_toggle_pin(pin) (PORTx_ADDRESS(pin) ^= _BV((pin) & 0xF))
+
+/* Operation of GPIO by port. */
+
+#define gpio_read_port(pin) (PINx_ADDRESS(pin))
+#define gpio_pin_index(pin) ((pin) & 0xF)
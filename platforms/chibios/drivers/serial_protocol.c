@@ -7,9 +7,49 @@
 #include "serial_protocol.h"
 #include "synchronization_util.h"
 
+#ifdef SPLIT_LINK_FRAMING
+#    include <string.h>
+#    include "crc.h"
+#endif
+
 static inline bool initiate_transaction(uint8_t transaction_id);
 static inline bool react_to_transaction(void);
 
+#if defined(SPLIT_MATRIX_PUSH) && defined(SERIAL_USART_FULL_DUPLEX)
+static bool target_signalled = false;
+#endif
+
+/**
+ * @brief Clear the receive queue, keeping note of an attention token the slave sent into it.
+ */
+static inline void clear_receive_queue(void) {
+#if defined(SPLIT_MATRIX_PUSH) && defined(SERIAL_USART_FULL_DUPLEX)
+    /* Reads the queue empty, so a token arriving right after is left for the next read rather than flushed. */
+    target_signalled |= serial_transport_receive_attention();
+#else
+    serial_transport_driver_clear();
+#endif
+}
+
+#ifdef SPLIT_LINK_FRAMING
+static split_link_stats_t link_stats = {0};
+
+/* Advances once a transaction completes, so the retry of a failed one carries the same sequence number. */
+static uint8_t link_sequence = 0;
+
+/* Buffers from the master land here first, so a corrupted one never reaches the shared memory. */
+static uint8_t frame_buffer[UINT8_MAX];
+
+/* The last transaction the slave applied, to apply its retries only once. */
+static uint8_t  applied_id  = 0xFF;
+static uint8_t  applied_seq = 0;
+static uint16_t applied_crc = 0;
+
+static inline bool send_frame(uint8_t transaction_id, uint8_t seq, const uint8_t* source, const size_t size);
+static inline bool receive_frame(uint8_t transaction_id, uint8_t seq, uint8_t* destination, const size_t size, bool slow_start, uint16_t* crc);
+static inline void drain_until_quiet(void);
+#endif
+
 /**
  * @brief This thread runs on the slave and responds to transactions initiated
  * by the master.
@@ -49,11 +89,22 @@ void soft_serial_initiator_init(void) {
  * @brief React to transactions started by the master.
  */
 static inline bool react_to_transaction(void) {
+#ifdef SPLIT_LINK_FRAMING
+    uint8_t header[2] = {0};
+    /* Wait until there is a transaction for us, followed by its sequence number. Only the first byte waits for as
+     * long as it takes, so a byte left over from a failed transaction is dropped rather than taken for a header. */
+    if (unlikely(!serial_transport_receive_blocking(&header[0], 1) || !serial_transport_receive_timeout(&header[1], 1, SPLIT_LINK_BYTE_TIMEOUT))) {
+        return false;
+    }
+    uint8_t transaction_id = header[0];
+    uint8_t seq            = header[1];
+#else
     uint8_t transaction_id = 0;
     /* Wait until there is a transaction for us. */
     if (unlikely(!serial_transport_receive_blocking(&transaction_id, sizeof(transaction_id)))) {
         return false;
     }
+#endif
 
     /* Sanity check that we are actually responding to a valid transaction. */
     if (unlikely(transaction_id >= NUM_TOTAL_TRANSACTIONS)) {
@@ -66,11 +117,44 @@ static inline bool react_to_transaction(void) {
 
     /* Send back the handshake which is XORed as a simple checksum,
      to signal that the slave is ready to receive possible transaction buffers  */
-    transaction_id ^= NUM_TOTAL_TRANSACTIONS;
-    if (unlikely(!serial_transport_send(&transaction_id, sizeof(transaction_id)))) {
+    uint8_t transaction_id_shake = transaction_id ^ NUM_TOTAL_TRANSACTIONS;
+    if (unlikely(!serial_transport_send(&transaction_id_shake, sizeof(transaction_id_shake)))) {
         return false;
     }
 
+#ifdef SPLIT_LINK_FRAMING
+    uint16_t crc = crc16(header, sizeof(header));
+
+    /* Receive transaction buffer from the master. If this transaction requires it.*/
+    if (transaction->initiator2target_buffer_size) {
+        if (unlikely(!receive_frame(transaction_id, seq, frame_buffer, transaction->initiator2target_buffer_size, false, &crc))) {
+            return false;
+        }
+    }
+
+    /* A retry of the last transaction already got its buffer and ran its callback, it only needs the answer again. */
+    if (transaction_id != applied_id || seq != applied_seq || crc != applied_crc) {
+        memcpy(split_trans_initiator2target_buffer(transaction), frame_buffer, transaction->initiator2target_buffer_size);
+
+        /* Allow any slave processing to occur. */
+        if (transaction->slave_callback) {
+            transaction->slave_callback(transaction->initiator2target_buffer_size, split_trans_initiator2target_buffer(transaction), transaction->initiator2target_buffer_size, split_trans_target2initiator_buffer(transaction));
+        }
+
+        applied_id  = transaction_id;
+        applied_seq = seq;
+        applied_crc = crc;
+    }
+
+    /* Send transaction buffer to the master. If this transaction requires it. */
+    if (transaction->target2initiator_buffer_size) {
+        if (unlikely(!send_frame(transaction_id, seq, split_trans_target2initiator_buffer(transaction), transaction->target2initiator_buffer_size))) {
+            return false;
+        }
+    }
+
+    return true;
+#else
     /* Receive transaction buffer from the master. If this transaction requires it.*/
     if (transaction->initiator2target_buffer_size) {
         if (unlikely(!serial_transport_receive(split_trans_initiator2target_buffer(transaction), transaction->initiator2target_buffer_size))) {
@@ -91,6 +175,7 @@ static inline bool react_to_transaction(void) {
     }
 
     return true;
+#endif
 }
 
 /**
@@ -101,10 +186,40 @@ static inline bool react_to_transaction(void) {
  */
 bool soft_serial_transaction(int index) {
     /* Clear the receive queue, to start with a clean slate.
-     * Parts of failed transactions or spurious bytes could still be in it. */
-    serial_transport_driver_clear();
+     * Parts of failed transactions or spurious bytes could still be in it, as well as attention tokens. */
+    clear_receive_queue();
+
+#ifdef SPLIT_LINK_FRAMING
+    systime_t start = chVTGetSystemTimeX();
 
+    if (unlikely(!initiate_transaction((uint8_t)index))) {
+        link_stats.failures++;
+        drain_until_quiet();
+        return false;
+    }
+
+    time_conv_t rtt   = TIME_I2US(chVTTimeElapsedSinceX(start));
+    link_stats.rtt_us = rtt > UINT16_MAX ? UINT16_MAX : (uint16_t)rtt;
+    if (link_stats.rtt_us > link_stats.rtt_max_us) {
+        link_stats.rtt_max_us = link_stats.rtt_us;
+    }
+    link_stats.transactions++;
+    link_sequence++;
+    return true;
+#else
     return initiate_transaction((uint8_t)index);
+#endif
+}
+
+/**
+ * @brief Receive the handshake of the slave, which answers as soon as its thread wakes up.
+ */
+static inline bool receive_handshake(uint8_t* shake) {
+#ifdef SPLIT_LINK_FRAMING
+    return serial_transport_receive_timeout(shake, sizeof(*shake), SPLIT_LINK_BYTE_TIMEOUT);
+#else
+    return serial_transport_receive(shake, sizeof(*shake));
+#endif
 }
 
 /**
@@ -121,11 +236,20 @@ static inline bool initiate_transaction(uint8_t transaction_id) {
 
     split_transaction_desc_t* transaction = &split_transaction_table[transaction_id];
 
+#ifdef SPLIT_LINK_FRAMING
+    /* Send transaction table index to the slave, which doubles as basic handshake token, followed by the sequence number. */
+    const uint8_t header[2] = {transaction_id, link_sequence};
+    if (unlikely(!serial_transport_send(header, sizeof(header)))) {
+        serial_dprintf("SPLIT: sending handshake failed\n");
+        return false;
+    }
+#else
     /* Send transaction table index to the slave, which doubles as basic handshake token. */
     if (unlikely(!serial_transport_send(&transaction_id, sizeof(transaction_id)))) {
         serial_dprintf("SPLIT: sending handshake failed\n");
         return false;
     }
+#endif
 
     uint8_t transaction_id_shake = 0xFF;
 
@@ -133,11 +257,41 @@ static inline bool initiate_transaction(uint8_t transaction_id) {
      *   - due to the half duplex limitations on return codes, we always have to read *something*.
      *   - without the read, write only transactions *always* succeed, even during the boot process where the slave is not ready.
      */
-    if (unlikely(!serial_transport_receive(&transaction_id_shake, sizeof(transaction_id_shake)) || (transaction_id_shake != (transaction_id ^ NUM_TOTAL_TRANSACTIONS)))) {
+    bool shake_received = receive_handshake(&transaction_id_shake);
+
+#if defined(SPLIT_MATRIX_PUSH) && defined(SERIAL_USART_FULL_DUPLEX)
+    /* The slave may have signalled a change right before it saw the transaction. */
+    while (shake_received && transaction_id_shake == SERIAL_ATTENTION_TOKEN) {
+        target_signalled = true;
+        shake_received   = receive_handshake(&transaction_id_shake);
+    }
+#endif
+
+    if (unlikely(!shake_received || (transaction_id_shake != (transaction_id ^ NUM_TOTAL_TRANSACTIONS)))) {
         serial_dprintf("SPLIT: receiving handshake failed\n");
         return false;
     }
 
+#ifdef SPLIT_LINK_FRAMING
+    /* Send transaction buffer to the slave. If this transaction requires it. */
+    if (transaction->initiator2target_buffer_size) {
+        if (unlikely(!send_frame(transaction_id, link_sequence, split_trans_initiator2target_buffer(transaction), transaction->initiator2target_buffer_size))) {
+            serial_dprintf("SPLIT: sending buffer failed\n");
+            return false;
+        }
+    }
+
+    /* Receive transaction buffer from the slave. If this transaction requires it. */
+    if (transaction->target2initiator_buffer_size) {
+        if (unlikely(!receive_frame(transaction_id, link_sequence, split_trans_target2initiator_buffer(transaction), transaction->target2initiator_buffer_size, true, NULL))) {
+            serial_dprintf("SPLIT: receiving buffer failed\n");
+            return false;
+        }
+    }
+
+    return true;
+#else
+
     /* Send transaction buffer to the slave. If this transaction requires it. */
     if (transaction->initiator2target_buffer_size) {
         if (unlikely(!serial_transport_send(split_trans_initiator2target_buffer(transaction), transaction->initiator2target_buffer_size))) {
@@ -155,4 +309,163 @@ static inline bool initiate_transaction(uint8_t transaction_id) {
     }
 
     return true;
+#endif
+}
+
+#if defined(SPLIT_MATRIX_PUSH) && defined(SERIAL_USART_FULL_DUPLEX)
+
+/**
+ * @brief Signal the master that there is new data, outside of a transaction.
+ * Must be called with the split shared memory locked, so the token is never sent in the middle of a transaction.
+ */
+void soft_serial_target_signal(void) {
+    serial_transport_send_attention();
+}
+
+/**
+ * @brief Whether the slave signalled new data since the last call.
+ */
+bool soft_serial_initiator_signalled(void) {
+    bool signalled   = target_signalled | serial_transport_receive_attention();
+    target_signalled = false;
+    return signalled;
+}
+
+#endif
+
+#ifdef SPLIT_LINK_FRAMING
+
+/**
+ * @brief CRC of a buffer, along with the transaction and sequence number it belongs to.
+ */
+static inline uint16_t frame_crc(uint8_t transaction_id, uint8_t seq, const uint8_t* buffer, const size_t size) {
+    const uint8_t header[2] = {transaction_id, seq};
+    return crc16_update(crc16(header, sizeof(header)), buffer, size);
+}
+
+/**
+ * @brief Throw away what the slave sends until it has been quiet for longer than it waits for an answer.
+ * After a failed transaction the slave may still wait for one of its buffers, and would otherwise take the next
+ * transaction for it.
+ */
+static inline void drain_until_quiet(void) {
+    uint8_t dump;
+    for (uint8_t i = 0; i < UINT8_MAX && serial_transport_receive_timeout(&dump, sizeof(dump), 3 * SPLIT_LINK_BYTE_TIMEOUT); i++) {
+#    if defined(SPLIT_MATRIX_PUSH) && defined(SERIAL_USART_FULL_DUPLEX)
+        /* The slave signals once it gave up on the transaction, a leftover byte that looks the same costs one read. */
+        target_signalled |= dump == SERIAL_ATTENTION_TOKEN;
+#    endif
+    }
+}
+
+/**
+ * @brief Receive the answer to a buffer we sent.
+ * A half that lost part of the buffer only answers once its own read timed out, so wait for up to twice as long.
+ */
+static inline bool receive_answer(uint8_t* answer) {
+    for (uint8_t waited = 0; waited < 2;) {
+        if (!serial_transport_receive_timeout(answer, sizeof(*answer), SPLIT_LINK_BYTE_TIMEOUT)) {
+            waited++;
+            continue;
+        }
+#    if defined(SPLIT_MATRIX_PUSH) && defined(SERIAL_USART_FULL_DUPLEX)
+        /* Only sent by a slave that gave up on the transaction, the answer is not coming. */
+        if (*answer == SERIAL_ATTENTION_TOKEN) {
+            target_signalled = true;
+            continue;
+        }
+#    endif
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Send a buffer followed by its CRC, and again for as long as the other half answers that it was corrupted.
+ */
+static inline bool send_frame(uint8_t transaction_id, uint8_t seq, const uint8_t* source, const size_t size) {
+    uint16_t      crc        = frame_crc(transaction_id, seq, source, size);
+    const uint8_t trailer[2] = {crc & 0xFF, crc >> 8};
+
+    for (uint8_t attempt = 0;; attempt++) {
+        uint8_t answer = 0;
+        if (unlikely(!serial_transport_send(source, size) || !serial_transport_send(trailer, sizeof(trailer)))) {
+            return false;
+        }
+
+        if (unlikely(!receive_answer(&answer))) {
+            /* The other half may well have taken the buffer, so leave it to a retry of the whole transaction,
+             * which it applies only once. */
+            clear_receive_queue();
+            link_stats.timeouts++;
+            return false;
+        }
+        if (likely(answer != SERIAL_FRAME_NAK)) {
+            return answer == SERIAL_FRAME_ACK;
+        }
+
+        link_stats.crc_errors++;
+        if (attempt == SPLIT_LINK_RETRANSMITS) {
+            return false;
+        }
+        link_stats.retransmits++;
+    }
 }
+
+/**
+ * @brief Receive a buffer followed by its CRC, asking for it again for as long as it is corrupted or cut short.
+ *
+ * @param slow_start The other half runs its callback first, so its first byte may take up to the driver timeout.
+ * @param crc If not NULL, receives the CRC of the buffer.
+ */
+static inline bool receive_frame(uint8_t transaction_id, uint8_t seq, uint8_t* destination, const size_t size, bool slow_start, uint16_t* crc) {
+    for (uint8_t attempt = 0;; attempt++) {
+        uint8_t  trailer[2] = {0};
+        uint16_t expected   = 0;
+        bool     intact     = false;
+
+        /* Nothing arriving at all means the other half gave up on the transaction, there is no one to answer. */
+        bool started = slow_start && attempt == 0 ? serial_transport_receive(destination, 1) : serial_transport_receive_timeout(destination, 1, SPLIT_LINK_BYTE_TIMEOUT);
+        if (unlikely(!started)) {
+            link_stats.timeouts++;
+            return false;
+        }
+
+        if (likely(serial_transport_receive_timeout(destination + 1, size - 1, SPLIT_LINK_BYTE_TIMEOUT) && serial_transport_receive_timeout(trailer, sizeof(trailer), SPLIT_LINK_BYTE_TIMEOUT))) {
+            expected = frame_crc(transaction_id, seq, destination, size);
+            intact   = expected == (trailer[0] | trailer[1] << 8);
+            if (unlikely(!intact)) {
+                link_stats.crc_errors++;
+            }
+        } else {
+            /* Bytes got lost, drop the rest of them so the NAK is followed by a clean retransmit. */
+            clear_receive_queue();
+            link_stats.timeouts++;
+        }
+
+        uint8_t answer = intact ? SERIAL_FRAME_ACK : SERIAL_FRAME_NAK;
+        if (unlikely(!serial_transport_send(&answer, sizeof(answer)))) {
+            return false;
+        }
+        if (likely(intact)) {
+            if (crc) {
+                *crc = expected;
+            }
+            return true;
+        }
+
+        if (attempt == SPLIT_LINK_RETRANSMITS) {
+            return false;
+        }
+        link_stats.retransmits++;
+    }
+}
+
+/**
+ * @brief Link-quality counters of this half.
+ */
+void soft_serial_link_stats(split_link_stats_t* stats) {
+    *stats = link_stats;
+}
+
+#endif
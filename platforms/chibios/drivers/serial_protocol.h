@@ -40,6 +40,14 @@ bool __attribute__((nonnull, hot)) serial_transport_receive(uint8_t* destination
  */
 bool __attribute__((nonnull, hot)) serial_transport_receive_blocking(uint8_t* destination, const size_t size);
 
+/**
+ * @brief Blocking receive of size * bytes, giving up once no byte arrived for timeout_us microseconds.
+ *
+ * @return true Receive success.
+ * @return false Receive failed, e.g. by timeout or bit errors.
+ */
+bool __attribute__((nonnull, hot)) serial_transport_receive_timeout(uint8_t* destination, const size_t size, uint32_t timeout_us);
+
 /**
  * @brief Blocking send of buffer with timeout.
  *
@@ -47,3 +55,38 @@ bool __attribute__((nonnull, hot)) serial_transport_receive_blocking(uint8_t* de
  * @return false Send failed, e.g. by timeout or bit errors.
  */
 bool __attribute__((nonnull, hot)) serial_transport_send(const uint8_t* source, const size_t size);
+
+/* Never a valid handshake, as those are below 2 * NUM_TOTAL_TRANSACTIONS. */
+#define SERIAL_ATTENTION_TOKEN 0xA5
+
+/**
+ * @brief Send an attention token to the master outside of a transaction.
+ * Only available on full-duplex links, where it cannot collide with a transaction started by the master.
+ */
+void serial_transport_send_attention(void);
+
+/**
+ * @brief Non-blocking receive of everything in the input queue.
+ *
+ * @return true An attention token was received.
+ * @return false No attention token was received.
+ */
+bool serial_transport_receive_attention(void);
+
+#ifdef SPLIT_LINK_FRAMING
+/* How many times a corrupted buffer is sent again before the transaction is given up on. */
+#    ifndef SPLIT_LINK_RETRANSMITS
+#        define SPLIT_LINK_RETRANSMITS 3
+#    endif
+
+/* How long, in microseconds, the halves wait on each other within a framed transaction: for the handshake, between
+ * the bytes of a buffer and for the answer to it. Only the buffer the slave sends after running its callback waits for
+ * the driver timeout before its first byte. */
+#    ifndef SPLIT_LINK_BYTE_TIMEOUT
+#        define SPLIT_LINK_BYTE_TIMEOUT 1000
+#    endif
+
+/* Answers to a framed buffer, telling whether its CRC matched. */
+#    define SERIAL_FRAME_ACK 0x06
+#    define SERIAL_FRAME_NAK 0x15
+#endif
@@ -165,6 +165,29 @@ inline bool serial_transport_receive_blocking(uint8_t* destination, const size_t
     return success;
 }
 
+inline bool serial_transport_receive_timeout(uint8_t* destination, const size_t size, uint32_t timeout_us) {
+    bool success = (size_t)chnReadTimeout(serial_driver, destination, size, TIME_US2I(timeout_us)) == size;
+    return success;
+}
+
+#if defined(SERIAL_USART_FULL_DUPLEX)
+
+void serial_transport_send_attention(void) {
+    const uint8_t token = SERIAL_ATTENTION_TOKEN;
+    (void)serial_transport_send(&token, sizeof(token));
+}
+
+bool serial_transport_receive_attention(void) {
+    bool    attention = false;
+    uint8_t token;
+    while (chnReadTimeout(serial_driver, &token, sizeof(token), TIME_IMMEDIATE) == sizeof(token)) {
+        attention |= token == SERIAL_ATTENTION_TOKEN;
+    }
+    return attention;
+}
+
+#endif
+
 #if !defined(SERIAL_USART_FULL_DUPLEX)
 
 /**
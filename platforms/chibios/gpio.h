@@ -43,3 +43,8 @@ typedef ioline_t pin_t;
 #define gpio_read_pin(pin) palReadLine(pin)
 
 #define gpio_toggle_pin(pin) palToggleLine(pin)
+
+/* Operation of GPIO by port. */
+
+#define gpio_read_port(pin) palReadPort(PAL_PORT(pin))
+#define gpio_pin_index(pin) PAL_PAD(pin)
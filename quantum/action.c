@@ -76,11 +76,21 @@ __attribute__((weak)) bool get_retro_tapping(uint16_t keycode, keyrecord_t *reco
  * FIXME: Needs documentation.
  */
 void action_exec(keyevent_t event) {
+#ifdef SEND_STRING_ASYNC_ENABLE
+    // Key events wait until the strings being typed out are done
+    if (IS_EVENT(event) && send_string_async_hold_event(event)) {
+        return;
+    }
+#endif
+
     if (IS_EVENT(event)) {
         ac_dprintf("\n---- action_exec: start -----\n");
         ac_dprintf("EVENT: ");
         debug_event(event);
         ac_dprintf("\n");
+#ifdef LATENCY_TRACE_ENABLE
+        latency_trace_event(&event);
+#endif
 #if defined(RETRO_TAPPING) || defined(RETRO_TAPPING_PER_KEY) || (defined(AUTO_SHIFT_ENABLE) && defined(RETRO_SHIFT))
         uint16_t event_keycode = get_event_keycode(event, false);
         if (event.pressed) {
@@ -304,7 +314,7 @@ void process_record(keyrecord_t *record) {
 }
 
 void process_record_handler(keyrecord_t *record) {
-#if defined(COMBO_ENABLE) || defined(REPEAT_KEY_ENABLE)
+#if defined(COMBO_ENABLE) || defined(CHORD_ENABLE) || defined(REPEAT_KEY_ENABLE) || defined(LEADER_SEQUENCE_TABLE)
     action_t action;
     if (record->keycode) {
         action = action_for_keycode(record->keycode);
@@ -1150,7 +1160,7 @@ bool is_tap_record(keyrecord_t *record) {
         return false;
     }
 
-#if defined(COMBO_ENABLE) || defined(REPEAT_KEY_ENABLE)
+#if defined(COMBO_ENABLE) || defined(CHORD_ENABLE) || defined(REPEAT_KEY_ENABLE) || defined(LEADER_SEQUENCE_TABLE)
     action_t action;
     if (record->keycode) {
         action = action_for_keycode(record->keycode);
@@ -50,7 +50,7 @@ typedef struct keyrecord_t {
 #ifndef NO_ACTION_TAPPING
     tap_t tap;
 #endif
-#if defined(COMBO_ENABLE) || defined(REPEAT_KEY_ENABLE)
+#if defined(COMBO_ENABLE) || defined(CHORD_ENABLE) || defined(REPEAT_KEY_ENABLE) || defined(LEADER_SEQUENCE_TABLE)
     uint16_t keycode;
 #endif
 } keyrecord_t;
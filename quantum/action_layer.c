@@ -1,11 +1,13 @@
 #include <limits.h>
 #include <stdint.h>
+#include <string.h>
 
 #include "keyboard.h"
 #include "action.h"
 #include "encoder.h"
 #include "util.h"
 #include "action_layer.h"
+#include "matrix.h"
 
 /** \brief Default Layer State
  */
@@ -236,13 +238,42 @@ void layer_debug(void) {
 #endif
 
 #if !defined(NO_ACTION_LAYER) && !defined(STRICT_LAYER_RELEASE)
+#    ifdef SOURCE_LAYERS_CACHE_BYTE_PER_KEY
 /** \brief source layer cache
+ *
+ * One byte per entry, trading RAM for single load/store accesses.
+ */
+
+uint8_t source_layers_cache[MATRIX_ROWS * MATRIX_COLS] = {0};
+#        ifdef ENCODER_MAP_ENABLE
+uint8_t encoder_source_layers_cache[NUM_ENCODERS] = {0};
+#        endif // ENCODER_MAP_ENABLE
+
+/** \brief update source layers cache impl
+ *
+ * Updates the supplied cache when changing layers
+ */
+static inline void update_source_layers_cache_impl(uint8_t layer, uint16_t entry_number, uint8_t cache[]) {
+    cache[entry_number] = layer;
+}
+
+/** \brief read source layers cache
+ *
+ * reads the cached keys stored when the layer was changed
+ */
+static inline uint8_t read_source_layers_cache_impl(uint16_t entry_number, uint8_t cache[]) {
+    return cache[entry_number];
+}
+#    else
+/** \brief source layer cache
+ *
+ * Bit-sliced, with one bit plane per layer bit, to minimise RAM usage.
  */
 
 uint8_t source_layers_cache[((MATRIX_ROWS * MATRIX_COLS) + (CHAR_BIT)-1) / (CHAR_BIT)][MAX_LAYER_BITS] = {{0}};
-#    ifdef ENCODER_MAP_ENABLE
+#        ifdef ENCODER_MAP_ENABLE
 uint8_t encoder_source_layers_cache[(NUM_ENCODERS + (CHAR_BIT)-1) / (CHAR_BIT)][MAX_LAYER_BITS] = {{0}};
-#    endif // ENCODER_MAP_ENABLE
+#        endif // ENCODER_MAP_ENABLE
 
 /** \brief update source layers cache impl
  *
@@ -271,6 +302,7 @@ uint8_t read_source_layers_cache_impl(uint16_t entry_number, uint8_t cache[][MAX
 
     return layer;
 }
+#    endif // SOURCE_LAYERS_CACHE_BYTE_PER_KEY
 
 /** \brief update encoder source layers cache
  *
@@ -335,16 +367,34 @@ action_t store_or_get_action(bool pressed, keypos_t key) {
 #endif
 }
 
-/** \brief Layer switch get layer
+#if !defined(NO_ACTION_LAYER) && defined(LAYER_RESOLUTION_CACHE_ENABLE)
+/** \brief resolved layer cache
  *
- * Gets the layer based on key info
+ * Remembers the topmost non-transparent layer of each matrix position, for the layer state it was resolved against.
+ * Entries are filled in lazily on lookup, and all of them are dropped whenever the layer state differs.
  */
-uint8_t layer_switch_get_layer(keypos_t key) {
+static layer_state_t resolved_layer_cache_state = 0;
+static matrix_row_t  resolved_layer_cache_valid[MATRIX_ROWS];
+static uint8_t       resolved_layer_cache[MATRIX_ROWS][MATRIX_COLS];
+
+/** \brief Layer resolution cache invalidate
+ *
+ * Drops all resolved layers, must be called whenever the keymap contents change.
+ */
+void layer_resolution_cache_invalidate(void) {
+    memset(resolved_layer_cache_valid, 0, sizeof(resolved_layer_cache_valid));
+}
+#endif
+
 #ifndef NO_ACTION_LAYER
+/** \brief Layer switch resolve layer
+ *
+ * Scans the supplied layers from the top down for the first non-transparent action of the key
+ */
+static uint8_t layer_switch_resolve_layer(layer_state_t layers, keypos_t key) {
     action_t action;
     action.code = ACTION_TRANSPARENT;
 
-    layer_state_t layers = layer_state | default_layer_state;
     /* check top layer first */
     for (int8_t i = MAX_LAYER - 1; i >= 0; i--) {
         if (layers & ((layer_state_t)1 << i)) {
@@ -356,6 +406,31 @@ uint8_t layer_switch_get_layer(keypos_t key) {
     }
     /* fall back to layer 0 */
     return 0;
+}
+#endif
+
+/** \brief Layer switch get layer
+ *
+ * Gets the layer based on key info
+ */
+uint8_t layer_switch_get_layer(keypos_t key) {
+#ifndef NO_ACTION_LAYER
+    layer_state_t layers = layer_state | default_layer_state;
+#    ifdef LAYER_RESOLUTION_CACHE_ENABLE
+    if (key.row < MATRIX_ROWS && key.col < MATRIX_COLS) {
+        const matrix_row_t col_mask = (matrix_row_t)1 << key.col;
+        if (layers != resolved_layer_cache_state) {
+            layer_resolution_cache_invalidate();
+            resolved_layer_cache_state = layers;
+        }
+        if (!(resolved_layer_cache_valid[key.row] & col_mask)) {
+            resolved_layer_cache[key.row][key.col] = layer_switch_resolve_layer(layers, key);
+            resolved_layer_cache_valid[key.row] |= col_mask;
+        }
+        return resolved_layer_cache[key.row][key.col];
+    }
+#    endif
+    return layer_switch_resolve_layer(layers, key);
 #else
     return get_highest_layer(default_layer_state);
 #endif
@@ -169,5 +169,10 @@ action_t store_or_get_action(bool pressed, keypos_t key);
 /* return the topmost non-transparent layer currently associated with key */
 uint8_t layer_switch_get_layer(keypos_t key);
 
+#if !defined(NO_ACTION_LAYER) && defined(LAYER_RESOLUTION_CACHE_ENABLE)
+/* forget all layers resolved by layer_switch_get_layer, required after changing the keymap contents */
+void layer_resolution_cache_invalidate(void);
+#endif
+
 /* return action depending on current layer status */
 action_t layer_switch_get_action(keypos_t key);
@@ -19,7 +19,7 @@
 #        error "IGNORE_MOD_TAP_INTERRUPT is no longer necessary as it is now the default behavior of mod-tap keys. Please remove it from your config."
 #    endif
 
-#    ifndef COMBO_ENABLE
+#    if !defined(COMBO_ENABLE) && !defined(CHORD_ENABLE)
 #        define IS_TAPPING_RECORD(r) (KEYEQ(tapping_key.event.key, (r->event.key)))
 #    else
 #        define IS_TAPPING_RECORD(r) (KEYEQ(tapping_key.event.key, (r->event.key)) && tapping_key.keycode == r->keycode)
@@ -520,7 +520,7 @@ bool process_tapping(keyrecord_t *keyp) {
                             .event.time    = event.time,
                             .event.pressed = false,
                             .event.type    = tapping_key.event.type,
-#    ifdef COMBO_ENABLE
+#    if defined(COMBO_ENABLE) || defined(CHORD_ENABLE)
                             .keycode = tapping_key.keycode,
 #    endif
                         });
@@ -571,7 +571,7 @@ bool process_tapping(keyrecord_t *keyp) {
                             .event.time    = event.time,
                             .event.pressed = false,
                             .event.type    = tapping_key.event.type,
-#    ifdef COMBO_ENABLE
+#    if defined(COMBO_ENABLE) || defined(CHORD_ENABLE)
                             .keycode = tapping_key.keycode,
 #    endif
                         });
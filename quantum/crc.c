@@ -73,3 +73,23 @@ __attribute__((weak)) uint8_t crc8(const void *data, size_t data_len) {
     return crc;
 }
 #endif
+
+__attribute__((weak)) uint16_t crc16_update(uint16_t crc, const void *data, size_t data_len) {
+    const uint8_t *d = (const uint8_t *)data;
+    size_t         i, j;
+
+    for (i = 0; i < data_len; i++) {
+        crc ^= (uint16_t)d[i] << 8;
+        for (j = 0; j < 8; j++) {
+            if ((crc & 0x8000) != 0)
+                crc = (uint16_t)((crc << 1) ^ 0x1021);
+            else
+                crc <<= 1;
+        }
+    }
+    return crc;
+}
+
+__attribute__((weak)) uint16_t crc16(const void *data, size_t data_len) {
+    return crc16_update(0xffff, data, data_len);
+}
@@ -43,3 +43,22 @@ __attribute__((weak)) void crc_init(void);
  * \return             The calculated crc value.
  */
 __attribute__((weak)) uint8_t crc8(const void *data, size_t data_len);
+
+/**
+ * Continue a CRC16 value (CRC-16/CCITT-FALSE) with the given data.
+ *
+ * \param[in] crc      The value calculated so far, 0xFFFF to start with.
+ * \param[in] data     Pointer to a buffer of \a data_len bytes.
+ * \param[in] data_len Number of bytes in the \a data buffer.
+ * \return             The calculated crc value.
+ */
+__attribute__((weak)) uint16_t crc16_update(uint16_t crc, const void *data, size_t data_len);
+
+/**
+ * Generate CRC16 value (CRC-16/CCITT-FALSE) from given data.
+ *
+ * \param[in] data     Pointer to a buffer of \a data_len bytes.
+ * \param[in] data_len Number of bytes in the \a data buffer.
+ * \return             The calculated crc value.
+ */
+__attribute__((weak)) uint16_t crc16(const void *data, size_t data_len);
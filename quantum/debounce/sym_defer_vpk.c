@@ -0,0 +1,174 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// Symmetric per-key algorithm using vertical counters. Behaves like sym_defer_pk, but instead of an 8-bit counter
+// per key, each row keeps one matrix_row_t per counter bit ("bit planes"), so a whole row of counters is started,
+// decremented and checked for expiry with a handful of bitwise operations.
+// When no state changes have occured for DEBOUNCE milliseconds, we push the state.
+
+#include "debounce.h"
+#include "timer.h"
+#include "util.h"
+
+#ifndef DEBOUNCE
+#    define DEBOUNCE 5
+#endif
+
+// Maximum debounce: 255ms
+#if DEBOUNCE > UINT8_MAX
+#    undef DEBOUNCE
+#    define DEBOUNCE UINT8_MAX
+#endif
+
+#if DEBOUNCE > 0
+// Number of bit planes needed to hold DEBOUNCE
+#    if DEBOUNCE < 2
+#        define DEBOUNCE_PLANES 1
+#    elif DEBOUNCE < 4
+#        define DEBOUNCE_PLANES 2
+#    elif DEBOUNCE < 8
+#        define DEBOUNCE_PLANES 3
+#    elif DEBOUNCE < 16
+#        define DEBOUNCE_PLANES 4
+#    elif DEBOUNCE < 32
+#        define DEBOUNCE_PLANES 5
+#    elif DEBOUNCE < 64
+#        define DEBOUNCE_PLANES 6
+#    elif DEBOUNCE < 128
+#        define DEBOUNCE_PLANES 7
+#    else
+#        define DEBOUNCE_PLANES 8
+#    endif
+
+// Largest value a counter can hold, any longer elapsed time expires every counter
+#    define DEBOUNCE_PLANES_MAX ((1 << DEBOUNCE_PLANES) - 1)
+
+// Bit n of every key's counter in a row lives in debounce_planes[row][n]
+// Uses MATRIX_ROWS_PER_HAND instead of MATRIX_ROWS to support split keyboards
+static matrix_row_t debounce_planes[MATRIX_ROWS_PER_HAND][DEBOUNCE_PLANES];
+static bool         counters_need_update;
+static bool         cooked_changed;
+
+static inline void update_debounce_counters_and_transfer_if_expired(matrix_row_t raw[], matrix_row_t cooked[], uint8_t elapsed_time);
+static inline void start_debounce_counters(matrix_row_t raw[], matrix_row_t cooked[]);
+
+void debounce_init(void) {}
+
+bool debounce(matrix_row_t raw[], matrix_row_t cooked[], bool changed) {
+    static fast_timer_t last_time;
+    bool                updated_last = false;
+    cooked_changed                   = false;
+
+    if (counters_need_update) {
+        fast_timer_t now          = timer_read_fast();
+        fast_timer_t elapsed_time = TIMER_DIFF_FAST(now, last_time);
+
+        last_time    = now;
+        updated_last = true;
+
+        if (elapsed_time > 0) {
+            // Update debounce counters with elapsed timer clamped to the largest counter value
+            update_debounce_counters_and_transfer_if_expired(raw, cooked, MIN(elapsed_time, DEBOUNCE_PLANES_MAX));
+        }
+    }
+
+    if (changed) {
+        if (!updated_last) {
+            last_time = timer_read_fast();
+        }
+
+        start_debounce_counters(raw, cooked);
+    }
+
+    return cooked_changed;
+}
+
+/**
+ * @brief Updates debounce counters and transfers debounced key states if the debounce period has expired.
+ *
+ * For each row with running counters, subtracts the elapsed time from every counter in the row at once with a
+ * bit-sliced ripple-borrow subtraction. Keys whose counter reaches zero or would underflow have expired: their
+ * counter is cleared and their debounced state is updated to match the raw state.
+ *
+ * @param raw The current raw key state matrix.
+ * @param cooked The debounced key state matrix to be updated.
+ * @param elapsed_time The time elapsed since the last debounce update, in milliseconds.
+ */
+static inline void update_debounce_counters_and_transfer_if_expired(matrix_row_t raw[], matrix_row_t cooked[], uint8_t elapsed_time) {
+    counters_need_update = false;
+    for (uint8_t row = 0; row < MATRIX_ROWS_PER_HAND; row++) {
+        matrix_row_t *planes = debounce_planes[row];
+        matrix_row_t  active = 0;
+
+        for (uint8_t bit = 0; bit < DEBOUNCE_PLANES; bit++) {
+            active |= planes[bit];
+        }
+        if (!active) {
+            continue;
+        }
+
+        matrix_row_t borrow    = 0;
+        matrix_row_t remaining = 0;
+        for (uint8_t bit = 0; bit < DEBOUNCE_PLANES; bit++) {
+            matrix_row_t counter    = planes[bit];
+            matrix_row_t subtrahend = (elapsed_time & (1 << bit)) ? ~(matrix_row_t)0 : 0;
+
+            planes[bit] = (counter ^ subtrahend ^ borrow) & active;
+            borrow      = (~counter & (subtrahend | borrow)) | (subtrahend & borrow);
+            remaining |= planes[bit];
+        }
+
+        matrix_row_t expired = active & (borrow | ~remaining);
+        if (expired) {
+            for (uint8_t bit = 0; bit < DEBOUNCE_PLANES; bit++) {
+                planes[bit] &= ~expired;
+            }
+
+            matrix_row_t cooked_next = (cooked[row] & ~expired) | (raw[row] & expired);
+            cooked_changed |= cooked[row] ^ cooked_next;
+            cooked[row] = cooked_next;
+        }
+
+        if (active & ~expired) {
+            counters_need_update = true;
+        }
+    }
+}
+
+/**
+ * @brief Initializes debounce counters for keys with changed states.
+ *
+ * For each row, keys whose raw state differs from the debounced state and whose counter has elapsed get their
+ * counter set to the debounce period. Counters of keys that match their debounced state are cleared.
+ *
+ * @param raw The current raw key state matrix.
+ * @param cooked The debounced key state matrix.
+ */
+static inline void start_debounce_counters(matrix_row_t raw[], matrix_row_t cooked[]) {
+    for (uint8_t row = 0; row < MATRIX_ROWS_PER_HAND; row++) {
+        matrix_row_t *planes = debounce_planes[row];
+        matrix_row_t  delta  = raw[row] ^ cooked[row];
+        matrix_row_t  active = 0;
+
+        for (uint8_t bit = 0; bit < DEBOUNCE_PLANES; bit++) {
+            active |= planes[bit];
+        }
+
+        matrix_row_t start = delta & ~active;
+        if (start) {
+            counters_need_update = true;
+        }
+
+        for (uint8_t bit = 0; bit < DEBOUNCE_PLANES; bit++) {
+            // Clear stable keys, load DEBOUNCE into newly changed keys
+            planes[bit] &= delta;
+            if (DEBOUNCE & (1 << bit)) {
+                planes[bit] |= start;
+            }
+        }
+    }
+}
+
+#else
+#    include "none.c"
+#endif
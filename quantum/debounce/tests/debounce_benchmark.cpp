@@ -0,0 +1,262 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// Benchmark for a debounce algorithm against generated switch traces.
+//
+// Every profile generates a reproducible trace of key strokes with contact bounce at each edge and optional chatter
+// while the contacts are stable, feeds it through debounce() at several scans per millisecond and prints one table
+// row with the CPU time per debounce() call, the added press/release latency and the number of false or missed
+// events. Each DEBOUNCE_TYPE is built as its own debounce_benchmark_<type> target, so the tables can be collected
+// with `make test:debounce_benchmark_<type>` and diffed across commits.
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+extern "C" {
+#include "debounce.h"
+#include "matrix.h"
+#include "timer.h"
+
+void     reset_access_counter(void);
+void     set_time(uint32_t t);
+void     advance_time(uint32_t ms);
+}
+
+#define DEBOUNCE_BENCHMARK_STR_(x) #x
+#define DEBOUNCE_BENCHMARK_STR(x) DEBOUNCE_BENCHMARK_STR_(x)
+
+#ifndef DEBOUNCE_BENCHMARK_STROKES
+#    define DEBOUNCE_BENCHMARK_STROKES 300
+#endif
+
+#ifndef DEBOUNCE_BENCHMARK_SCANS_PER_MS
+#    define DEBOUNCE_BENCHMARK_SCANS_PER_MS 4
+#endif
+
+namespace {
+
+struct Profile {
+    const char *name;
+    uint8_t     bounce_ms;         // contacts flip randomly for this long after every edge
+    uint16_t    chatter_per_mille; // chance of a 1ms glitch per stable millisecond, in 1/1000
+    uint8_t     chord;             // keys pressed together per stroke
+    uint8_t     rows;              // rows of this hand the strokes are spread over
+};
+
+const Profile profiles[] = {
+    {"clean", 0, 0, 1, MATRIX_ROWS_PER_HAND},
+    {"bounce_2ms", 2, 0, 1, MATRIX_ROWS_PER_HAND},
+    {"bounce_5ms", 5, 0, 1, MATRIX_ROWS_PER_HAND},
+    {"bounce_10ms", 10, 0, 1, MATRIX_ROWS_PER_HAND},
+    {"chatter", 5, 2, 1, MATRIX_ROWS_PER_HAND},
+    {"chord_4", 5, 0, 4, MATRIX_ROWS_PER_HAND},
+    {"chord_10", 5, 0, 10, MATRIX_ROWS_PER_HAND},
+    {"chord_4_one_row", 5, 0, 4, 1},
+    {"chord_4_chatter", 5, 2, 4, MATRIX_ROWS_PER_HAND},
+};
+
+struct Edge {
+    uint32_t time;
+    bool     pressed;
+};
+
+struct Trace {
+    uint32_t                       length;
+    std::vector<matrix_row_t>      raw;   // raw[time * MATRIX_ROWS_PER_HAND + row]
+    std::vector<std::vector<Edge>> edges; // intended edges per key
+};
+
+struct Result {
+    double                ns_per_call;
+    std::vector<uint32_t> press_latency;
+    std::vector<uint32_t> release_latency;
+    uint32_t              false_events;
+    uint32_t              missed_events;
+};
+
+uint16_t key_index(uint8_t row, uint8_t col) {
+    return row * MATRIX_COLS + col;
+}
+
+Trace generate_trace(const Profile &profile) {
+    std::mt19937                            rng(0x5EED);
+    std::vector<std::vector<Edge>>          edges(MATRIX_ROWS_PER_HAND * MATRIX_COLS);
+    std::uniform_int_distribution<uint32_t> hold(30, 120);
+    std::uniform_int_distribution<uint32_t> gap(20, 80);
+    std::uniform_int_distribution<uint32_t> skew(0, 2);
+    std::uniform_int_distribution<uint16_t> row_dist(0, profile.rows - 1);
+    std::uniform_int_distribution<uint16_t> col_dist(0, MATRIX_COLS - 1);
+
+    uint32_t time = 50;
+    for (int stroke = 0; stroke < DEBOUNCE_BENCHMARK_STROKES; stroke++) {
+        std::vector<uint16_t> keys;
+        uint8_t               chord = std::min<uint16_t>(profile.chord, profile.rows * MATRIX_COLS);
+        while (keys.size() < chord) {
+            uint16_t key = key_index(row_dist(rng), col_dist(rng));
+            if (std::find(keys.begin(), keys.end(), key) == keys.end()) {
+                keys.push_back(key);
+            }
+        }
+
+        uint32_t held = hold(rng);
+        for (auto key : keys) {
+            uint32_t press = time + skew(rng);
+            edges[key].push_back({press, true});
+            edges[key].push_back({press + held, false});
+        }
+        time += held + 2 + gap(rng);
+    }
+
+    Trace trace;
+    trace.length = time + 100;
+    trace.raw.assign(trace.length * MATRIX_ROWS_PER_HAND, 0);
+
+    std::uniform_int_distribution<uint16_t> per_mille(0, 999);
+    for (uint16_t key = 0; key < edges.size(); key++) {
+        uint8_t      row   = key / MATRIX_COLS;
+        matrix_row_t mask  = MATRIX_ROW_SHIFTER << (key % MATRIX_COLS);
+        bool         state = false;
+        size_t       next  = 0;
+        uint32_t     edge  = 0;
+
+        for (uint32_t t = 0; t < trace.length; t++) {
+            if (next < edges[key].size() && edges[key][next].time == t) {
+                state = edges[key][next].pressed;
+                edge  = t;
+                next++;
+            }
+
+            bool level = state;
+            if (edge && t < edge + profile.bounce_ms) {
+                level = rng() & 1;
+            } else if (per_mille(rng) < profile.chatter_per_mille) {
+                level = !state;
+            }
+
+            if (level) {
+                trace.raw[t * MATRIX_ROWS_PER_HAND + row] |= mask;
+            }
+        }
+    }
+
+    trace.edges = std::move(edges);
+    return trace;
+}
+
+Result run_trace(const Trace &trace) {
+    Result       result = {};
+    matrix_row_t raw[MATRIX_ROWS_PER_HAND];
+    matrix_row_t cooked[MATRIX_ROWS_PER_HAND];
+    matrix_row_t previous[MATRIX_ROWS_PER_HAND];
+
+    std::vector<size_t> next_edge(trace.edges.size(), 0);
+
+    debounce_init();
+    std::fill(std::begin(raw), std::end(raw), 0);
+    std::fill(std::begin(cooked), std::end(cooked), 0);
+    set_time(10000);
+
+    // Correctness pass: record every cooked change against the intended edges
+    for (uint32_t t = 0; t < trace.length; t++) {
+        for (int scan = 0; scan < DEBOUNCE_BENCHMARK_SCANS_PER_MS; scan++) {
+            const matrix_row_t *next    = &trace.raw[t * MATRIX_ROWS_PER_HAND];
+            bool                changed = !std::equal(next, next + MATRIX_ROWS_PER_HAND, raw);
+            std::copy(next, next + MATRIX_ROWS_PER_HAND, raw);
+            std::copy(std::begin(cooked), std::end(cooked), previous);
+
+            reset_access_counter();
+            if (!debounce(raw, cooked, changed)) {
+                continue;
+            }
+
+            for (uint8_t row = 0; row < MATRIX_ROWS_PER_HAND; row++) {
+                matrix_row_t delta = cooked[row] ^ previous[row];
+                for (uint8_t col = 0; delta; col++, delta >>= 1) {
+                    if (!(delta & 1)) {
+                        continue;
+                    }
+
+                    uint16_t key     = key_index(row, col);
+                    bool     pressed = cooked[row] & (MATRIX_ROW_SHIFTER << col);
+                    size_t  &index   = next_edge[key];
+
+                    if (index < trace.edges[key].size() && trace.edges[key][index].pressed == pressed && trace.edges[key][index].time <= t) {
+                        (pressed ? result.press_latency : result.release_latency).push_back(t - trace.edges[key][index].time);
+                        index++;
+                    } else {
+                        result.false_events++;
+                    }
+                }
+            }
+        }
+        advance_time(1);
+    }
+
+    for (uint16_t key = 0; key < trace.edges.size(); key++) {
+        result.missed_events += trace.edges[key].size() - next_edge[key];
+    }
+
+    // Timing pass: replay the same trace, and subtract the cost of the replay loop itself
+    auto replay = [&](bool call_debounce) {
+        uint32_t calls = 0;
+        debounce_init();
+        std::fill(std::begin(raw), std::end(raw), 0);
+        std::fill(std::begin(cooked), std::end(cooked), 0);
+        set_time(10000);
+
+        auto start = std::chrono::steady_clock::now();
+        for (uint32_t t = 0; t < trace.length; t++) {
+            for (int scan = 0; scan < DEBOUNCE_BENCHMARK_SCANS_PER_MS; scan++) {
+                const matrix_row_t *next    = &trace.raw[t * MATRIX_ROWS_PER_HAND];
+                bool                changed = !std::equal(next, next + MATRIX_ROWS_PER_HAND, raw);
+                std::copy(next, next + MATRIX_ROWS_PER_HAND, raw);
+
+                reset_access_counter();
+                if (call_debounce) {
+                    debounce(raw, cooked, changed);
+                    calls++;
+                }
+            }
+            advance_time(1);
+        }
+        std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+        return std::make_pair(elapsed.count(), calls);
+    };
+
+    auto baseline = replay(false);
+    auto timed    = replay(true);
+
+    result.ns_per_call = std::max(0.0, timed.first - baseline.first) / timed.second;
+    return result;
+}
+
+uint32_t percentile(std::vector<uint32_t> &values, unsigned pct) {
+    if (values.empty()) {
+        return 0;
+    }
+    std::sort(values.begin(), values.end());
+    return values[(values.size() - 1) * pct / 100];
+}
+
+} // namespace
+
+TEST(DebounceBenchmark, Profiles) {
+    printf("debounce benchmark: %s, DEBOUNCE=%d, %d rows x %d cols per hand, %d scans/ms\n", DEBOUNCE_BENCHMARK_STR(DEBOUNCE_BENCHMARK_TYPE), DEBOUNCE, MATRIX_ROWS_PER_HAND, MATRIX_COLS, DEBOUNCE_BENCHMARK_SCANS_PER_MS);
+    printf("| %-20s | %-16s | %6s | %10s | %4s | %5s | %8s | %-17s | %-19s | %5s | %6s |\n", "algorithm", "profile", "bounce", "chatter/1k", "rows", "chord", "ns/call", "press p50/p99/max", "release p50/p99/max", "false", "missed");
+
+    for (auto &profile : profiles) {
+        Trace  trace  = generate_trace(profile);
+        Result result = run_trace(trace);
+
+        char press[32], release[32];
+        snprintf(press, sizeof(press), "%u/%u/%u", percentile(result.press_latency, 50), percentile(result.press_latency, 99), percentile(result.press_latency, 100));
+        snprintf(release, sizeof(release), "%u/%u/%u", percentile(result.release_latency, 50), percentile(result.release_latency, 99), percentile(result.release_latency, 100));
+
+        printf("| %-20s | %-16s | %4ums | %10u | %4u | %5u | %8.1f | %-17s | %-19s | %5u | %6u |\n", DEBOUNCE_BENCHMARK_STR(DEBOUNCE_BENCHMARK_TYPE), profile.name, profile.bounce_ms, profile.chatter_per_mille, profile.rows, profile.chord, result.ns_per_call, press, release, result.false_events, result.missed_events);
+    }
+}
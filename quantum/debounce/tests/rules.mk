@@ -34,6 +34,12 @@ debounce_sym_defer_pk_SRC := $(DEBOUNCE_COMMON_SRC) \
 	$(QUANTUM_PATH)/debounce/sym_defer_pk.c \
 	$(QUANTUM_PATH)/debounce/tests/sym_defer_pk_tests.cpp
 
+# Same behaviour as sym_defer_pk, so it runs the same tests
+debounce_sym_defer_vpk_DEFS := $(DEBOUNCE_COMMON_DEFS)
+debounce_sym_defer_vpk_SRC := $(DEBOUNCE_COMMON_SRC) \
+	$(QUANTUM_PATH)/debounce/sym_defer_vpk.c \
+	$(QUANTUM_PATH)/debounce/tests/sym_defer_pk_tests.cpp
+
 debounce_sym_defer_pr_DEFS := $(DEBOUNCE_COMMON_DEFS)
 debounce_sym_defer_pr_SRC := $(DEBOUNCE_COMMON_SRC) \
 	$(QUANTUM_PATH)/debounce/sym_defer_pr.c \
@@ -53,3 +59,17 @@ debounce_asym_eager_defer_pk_DEFS := $(DEBOUNCE_COMMON_DEFS)
 debounce_asym_eager_defer_pk_SRC := $(DEBOUNCE_COMMON_SRC) \
 	$(QUANTUM_PATH)/debounce/asym_eager_defer_pk.c \
 	$(QUANTUM_PATH)/debounce/tests/asym_eager_defer_pk_tests.cpp
+
+# Benchmarks, one per algorithm, on a split matrix with 6 rows per hand
+DEBOUNCE_BENCHMARK_TYPES := none sym_defer_g sym_defer_pk sym_defer_pr sym_defer_vpk sym_eager_pk sym_eager_pr asym_eager_defer_pk
+DEBOUNCE_BENCHMARK_DEFS := -DMATRIX_ROWS=12 -DMATRIX_COLS=16 -DSPLIT_KEYBOARD -DDEBOUNCE=5
+
+define DEBOUNCE_BENCHMARK
+debounce_benchmark_$1_DEFS := $$(DEBOUNCE_BENCHMARK_DEFS) -DDEBOUNCE_BENCHMARK_TYPE=$1
+debounce_benchmark_$1_SRC := $(PLATFORM_PATH)/timer.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c \
+	$(QUANTUM_PATH)/debounce/$1.c \
+	$(QUANTUM_PATH)/debounce/tests/debounce_benchmark.cpp
+endef
+
+$(foreach TYPE,$(DEBOUNCE_BENCHMARK_TYPES),$(eval $(call DEBOUNCE_BENCHMARK,$(TYPE))))
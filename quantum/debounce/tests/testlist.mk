@@ -2,7 +2,16 @@ TEST_LIST += \
 	debounce_none \
 	debounce_sym_defer_g \
 	debounce_sym_defer_pk \
+	debounce_sym_defer_vpk \
 	debounce_sym_defer_pr \
 	debounce_sym_eager_pk \
 	debounce_sym_eager_pr \
-	debounce_asym_eager_defer_pk
+	debounce_asym_eager_defer_pk \
+	debounce_benchmark_none \
+	debounce_benchmark_sym_defer_g \
+	debounce_benchmark_sym_defer_pk \
+	debounce_benchmark_sym_defer_pr \
+	debounce_benchmark_sym_defer_vpk \
+	debounce_benchmark_sym_eager_pk \
+	debounce_benchmark_sym_eager_pr \
+	debounce_benchmark_asym_eager_defer_pk
@@ -16,11 +16,14 @@
  */
 
 #include "dynamic_keymap.h"
+#include "compiler_support.h"
 #include "keymap_introspection.h"
 #include "action.h"
+#include "action_layer.h"
 #include "send_string.h"
 #include "keycodes.h"
 #include "nvm_dynamic_keymap.h"
+#include "util.h"
 
 #ifdef ENCODER_ENABLE
 #    include "encoder.h"
@@ -32,31 +35,136 @@
 #    define DYNAMIC_KEYMAP_MACRO_DELAY TAP_CODE_DELAY
 #endif
 
+#ifndef DYNAMIC_KEYMAP_MACRO_PREFETCH_SIZE
+#    define DYNAMIC_KEYMAP_MACRO_PREFETCH_SIZE 32
+#endif
+
+STATIC_ASSERT(DYNAMIC_KEYMAP_MACRO_PREFETCH_SIZE > 0 && DYNAMIC_KEYMAP_MACRO_PREFETCH_SIZE <= 255, "DYNAMIC_KEYMAP_MACRO_PREFETCH_SIZE must be between 1 and 255");
+
+// Start of every macro in the buffer, the entry after the last macro being the end of the buffer.
+// Found once after the buffer changes rather than on every send.
+static bool     dynamic_keymap_macro_index_valid = false;
+static bool     dynamic_keymap_macro_buffer_busy = false;
+static uint16_t dynamic_keymap_macro_offsets[DYNAMIC_KEYMAP_MACRO_COUNT + 1];
+
+#ifdef DYNAMIC_KEYMAP_CACHE_ENABLE
+#    ifndef DYNAMIC_KEYMAP_CACHE_LAYER_COUNT
+#        define DYNAMIC_KEYMAP_CACHE_LAYER_COUNT DYNAMIC_KEYMAP_LAYER_COUNT
+#    endif
+
+STATIC_ASSERT(DYNAMIC_KEYMAP_CACHE_LAYER_COUNT > 0 && DYNAMIC_KEYMAP_CACHE_LAYER_COUNT <= DYNAMIC_KEYMAP_LAYER_COUNT, "DYNAMIC_KEYMAP_CACHE_LAYER_COUNT must be between 1 and DYNAMIC_KEYMAP_LAYER_COUNT");
+
+// Write-through RAM mirror of the first DYNAMIC_KEYMAP_CACHE_LAYER_COUNT layers.
+// Populated from NVM on first use; every setter updates NVM and the mirror together.
+static bool     dynamic_keymap_cache_loaded = false;
+static uint16_t dynamic_keymap_cache[DYNAMIC_KEYMAP_CACHE_LAYER_COUNT][MATRIX_ROWS][MATRIX_COLS];
+#    ifdef ENCODER_MAP_ENABLE
+static uint16_t dynamic_encodermap_cache[DYNAMIC_KEYMAP_CACHE_LAYER_COUNT][NUM_ENCODERS][NUM_DIRECTIONS];
+#    endif // ENCODER_MAP_ENABLE
+
+static void dynamic_keymap_cache_load(void) {
+    for (uint8_t layer = 0; layer < DYNAMIC_KEYMAP_CACHE_LAYER_COUNT; layer++) {
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t column = 0; column < MATRIX_COLS; column++) {
+                dynamic_keymap_cache[layer][row][column] = nvm_dynamic_keymap_read_keycode(layer, row, column);
+            }
+        }
+#    ifdef ENCODER_MAP_ENABLE
+        for (uint8_t encoder = 0; encoder < NUM_ENCODERS; encoder++) {
+            dynamic_encodermap_cache[layer][encoder][0] = nvm_dynamic_keymap_read_encoder(layer, encoder, true);
+            dynamic_encodermap_cache[layer][encoder][1] = nvm_dynamic_keymap_read_encoder(layer, encoder, false);
+        }
+#    endif // ENCODER_MAP_ENABLE
+    }
+    dynamic_keymap_cache_loaded = true;
+}
+
+static inline void dynamic_keymap_cache_ensure_loaded(void) {
+    if (!dynamic_keymap_cache_loaded) {
+        dynamic_keymap_cache_load();
+    }
+}
+
+// Mirrors a raw buffer write, which is big-endian and may start or end on either byte of a keycode.
+static void dynamic_keymap_cache_update_buffer(uint16_t offset, uint16_t size, const uint8_t *data) {
+    const uint32_t cache_size = sizeof(dynamic_keymap_cache);
+    uint16_t      *keycodes   = &dynamic_keymap_cache[0][0][0];
+    for (uint32_t i = 0; i < size; i++) {
+        uint32_t position = (uint32_t)offset + i;
+        if (position >= cache_size) {
+            break;
+        }
+        uint16_t *keycode = &keycodes[position / 2];
+        if (position & 1) {
+            *keycode = (*keycode & 0xFF00) | data[i];
+        } else {
+            *keycode = (*keycode & 0x00FF) | ((uint16_t)data[i] << 8);
+        }
+    }
+}
+
+void dynamic_keymap_cache_invalidate(void) {
+    dynamic_keymap_cache_loaded = false;
+}
+#endif // DYNAMIC_KEYMAP_CACHE_ENABLE
+
 uint8_t dynamic_keymap_get_layer_count(void) {
     return DYNAMIC_KEYMAP_LAYER_COUNT;
 }
 
 uint16_t dynamic_keymap_get_keycode(uint8_t layer, uint8_t row, uint8_t column) {
+#ifdef DYNAMIC_KEYMAP_CACHE_ENABLE
+    if (layer < DYNAMIC_KEYMAP_CACHE_LAYER_COUNT && row < MATRIX_ROWS && column < MATRIX_COLS) {
+        dynamic_keymap_cache_ensure_loaded();
+        return dynamic_keymap_cache[layer][row][column];
+    }
+#endif // DYNAMIC_KEYMAP_CACHE_ENABLE
     return nvm_dynamic_keymap_read_keycode(layer, row, column);
 }
 
 void dynamic_keymap_set_keycode(uint8_t layer, uint8_t row, uint8_t column, uint16_t keycode) {
     nvm_dynamic_keymap_update_keycode(layer, row, column, keycode);
+#ifdef DYNAMIC_KEYMAP_CACHE_ENABLE
+    if (layer < DYNAMIC_KEYMAP_CACHE_LAYER_COUNT && row < MATRIX_ROWS && column < MATRIX_COLS) {
+        dynamic_keymap_cache[layer][row][column] = keycode;
+    }
+#endif // DYNAMIC_KEYMAP_CACHE_ENABLE
+#if !defined(NO_ACTION_LAYER) && defined(LAYER_RESOLUTION_CACHE_ENABLE)
+    layer_resolution_cache_invalidate();
+#endif
+#ifdef MATRIX_HAS_GHOST
+    if (layer == 0) {
+        matrix_real_keys_invalidate();
+    }
+#endif
 }
 
 #ifdef ENCODER_MAP_ENABLE
 uint16_t dynamic_keymap_get_encoder(uint8_t layer, uint8_t encoder_id, bool clockwise) {
+#    ifdef DYNAMIC_KEYMAP_CACHE_ENABLE
+    if (layer < DYNAMIC_KEYMAP_CACHE_LAYER_COUNT && encoder_id < NUM_ENCODERS) {
+        dynamic_keymap_cache_ensure_loaded();
+        return dynamic_encodermap_cache[layer][encoder_id][clockwise ? 0 : 1];
+    }
+#    endif // DYNAMIC_KEYMAP_CACHE_ENABLE
     return nvm_dynamic_keymap_read_encoder(layer, encoder_id, clockwise);
 }
 
 void dynamic_keymap_set_encoder(uint8_t layer, uint8_t encoder_id, bool clockwise, uint16_t keycode) {
     nvm_dynamic_keymap_update_encoder(layer, encoder_id, clockwise, keycode);
+#    ifdef DYNAMIC_KEYMAP_CACHE_ENABLE
+    if (layer < DYNAMIC_KEYMAP_CACHE_LAYER_COUNT && encoder_id < NUM_ENCODERS) {
+        dynamic_encodermap_cache[layer][encoder_id][clockwise ? 0 : 1] = keycode;
+    }
+#    endif // DYNAMIC_KEYMAP_CACHE_ENABLE
 }
 #endif // ENCODER_MAP_ENABLE
 
 void dynamic_keymap_reset(void) {
     // Erase the keymaps, if necessary.
     nvm_dynamic_keymap_erase();
+    // The erase may have taken the macros with it
+    dynamic_keymap_macro_index_valid = false;
 
     // Reset the keymaps in EEPROM to what is in flash.
     for (int layer = 0; layer < DYNAMIC_KEYMAP_LAYER_COUNT; layer++) {
@@ -80,6 +188,15 @@ void dynamic_keymap_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
 
 void dynamic_keymap_set_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
     nvm_dynamic_keymap_update_buffer(offset, size, data);
+#ifdef DYNAMIC_KEYMAP_CACHE_ENABLE
+    dynamic_keymap_cache_update_buffer(offset, size, data);
+#endif // DYNAMIC_KEYMAP_CACHE_ENABLE
+#if !defined(NO_ACTION_LAYER) && defined(LAYER_RESOLUTION_CACHE_ENABLE)
+    layer_resolution_cache_invalidate();
+#endif
+#ifdef MATRIX_HAS_GHOST
+    matrix_real_keys_invalidate();
+#endif
 }
 
 uint16_t keycode_at_keymap_location(uint8_t layer_num, uint8_t row, uint8_t column) {
@@ -110,31 +227,69 @@ void dynamic_keymap_macro_get_buffer(uint16_t offset, uint16_t size, uint8_t *da
     nvm_dynamic_keymap_macro_read_buffer(offset, size, data);
 }
 
-void dynamic_keymap_macro_set_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
-    nvm_dynamic_keymap_macro_update_buffer(offset, size, data);
+static void dynamic_keymap_macro_build_index(void) {
+    uint16_t end = nvm_dynamic_keymap_macro_size();
+    uint8_t  id  = 0;
+    uint8_t  chunk[DYNAMIC_KEYMAP_MACRO_PREFETCH_SIZE];
+
+    // The last byte of the buffer is its valid flag
+    nvm_dynamic_keymap_macro_read_buffer(end - 1, 1, chunk);
+    dynamic_keymap_macro_buffer_busy = chunk[0] != 0;
+
+    dynamic_keymap_macro_offsets[0] = 0;
+    for (uint16_t offset = 0; offset < end && id < DYNAMIC_KEYMAP_MACRO_COUNT; offset += sizeof(chunk)) {
+        uint16_t size = MIN(sizeof(chunk), end - offset);
+        nvm_dynamic_keymap_macro_read_buffer(offset, size, chunk);
+        for (uint16_t i = 0; i < size && id < DYNAMIC_KEYMAP_MACRO_COUNT; i++) {
+            if (chunk[i] == 0) {
+                dynamic_keymap_macro_offsets[++id] = offset + i + 1;
+            }
+        }
+    }
+    // Macros past the last terminator are empty
+    while (id < DYNAMIC_KEYMAP_MACRO_COUNT) {
+        dynamic_keymap_macro_offsets[++id] = end;
+    }
+    dynamic_keymap_macro_index_valid = true;
 }
 
-static uint8_t dynamic_keymap_read_byte(uint32_t offset) {
-    uint8_t d;
-    nvm_dynamic_keymap_macro_read_buffer(offset, 1, &d);
-    return d;
+void dynamic_keymap_macro_set_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
+    nvm_dynamic_keymap_macro_update_buffer(offset, size, data);
+    dynamic_keymap_macro_index_valid = false;
+    // Clearing the valid flag completes an upload, index the new macros right away
+    if (size > 0 && offset + size == nvm_dynamic_keymap_macro_size() && data[size - 1] == 0) {
+        dynamic_keymap_macro_build_index();
+    }
 }
 
 typedef struct send_string_nvm_state_t {
-    uint32_t offset;
+    uint16_t offset; // next byte to fetch
+    uint16_t end;    // one past the terminator of the macro
+    uint8_t  index;
+    uint8_t  count;
+    char     buffer[DYNAMIC_KEYMAP_MACRO_PREFETCH_SIZE];
 } send_string_nvm_state_t;
 
+/* Hands out the macro from RAM, refilling it from NVM a chunk at a time */
 char send_string_get_next_nvm(void *arg) {
     send_string_nvm_state_t *state = (send_string_nvm_state_t *)arg;
-    char                     ret   = dynamic_keymap_read_byte(state->offset);
-    state->offset++;
-    return ret;
+    if (state->index == state->count) {
+        if (state->offset == state->end) {
+            return 0;
+        }
+        state->count = MIN(sizeof(state->buffer), state->end - state->offset);
+        state->index = 0;
+        nvm_dynamic_keymap_macro_read_buffer(state->offset, state->count, (uint8_t *)state->buffer);
+        state->offset += state->count;
+    }
+    return state->buffer[state->index++];
 }
 
 void dynamic_keymap_macro_reset(void) {
     // Erase the macros, if necessary.
     nvm_dynamic_keymap_macro_erase();
     nvm_dynamic_keymap_macro_reset();
+    dynamic_keymap_macro_index_valid = false;
 }
 
 void dynamic_keymap_macro_send(uint8_t id) {
@@ -142,30 +297,20 @@ void dynamic_keymap_macro_send(uint8_t id) {
         return;
     }
 
-    // Check the last byte of the buffer.
-    // If it's not zero, then we are in the middle
-    // of buffer writing, possibly an aborted buffer
-    // write. So do nothing.
-    if (dynamic_keymap_read_byte(nvm_dynamic_keymap_macro_size() - 1) != 0) {
-        return;
+    if (!dynamic_keymap_macro_index_valid) {
+        dynamic_keymap_macro_build_index();
     }
 
-    // Skip N null characters
-    // p will then point to the Nth macro
-    uint32_t offset = 0;
-    uint32_t end    = nvm_dynamic_keymap_macro_size();
-    while (id > 0) {
-        // If we are past the end of the buffer, then there is
-        // no Nth macro in the buffer.
-        if (offset == end) {
-            return;
-        }
-        if (dynamic_keymap_read_byte(offset) == 0) {
-            --id;
-        }
-        ++offset;
+    // If the last byte of the buffer is not zero, then we are in
+    // the middle of buffer writing, possibly an aborted buffer
+    // write. So do nothing.
+    if (dynamic_keymap_macro_buffer_busy) {
+        return;
     }
 
-    send_string_nvm_state_t state = {.offset = offset};
+    send_string_nvm_state_t state = {
+        .offset = dynamic_keymap_macro_offsets[id],
+        .end    = dynamic_keymap_macro_offsets[id + 1],
+    };
     send_string_with_delay_impl(send_string_get_next_nvm, &state, DYNAMIC_KEYMAP_MACRO_DELAY);
 }
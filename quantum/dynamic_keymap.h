@@ -34,6 +34,11 @@ uint16_t dynamic_keymap_get_encoder(uint8_t layer, uint8_t encoder_id, bool cloc
 void     dynamic_keymap_set_encoder(uint8_t layer, uint8_t encoder_id, bool clockwise, uint16_t keycode);
 #endif // ENCODER_MAP_ENABLE
 void dynamic_keymap_reset(void);
+#ifdef DYNAMIC_KEYMAP_CACHE_ENABLE
+// Forces the RAM keymap mirror to be reloaded from NVM on the next lookup.
+// Only needed if the keymap region of NVM is written without going through dynamic_keymap_*().
+void dynamic_keymap_cache_invalidate(void);
+#endif // DYNAMIC_KEYMAP_CACHE_ENABLE
 // These get/set the keycodes as stored in the EEPROM buffer
 // Data is big-endian 16-bit values (the keycodes)
 // Order is by layer/row/column
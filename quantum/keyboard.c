@@ -73,6 +73,9 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifdef COMBO_ENABLE
 #    include "process_combo.h"
 #endif
+#ifdef CHORD_ENABLE
+#    include "process_chord.h"
+#endif
 #ifdef TAP_DANCE_ENABLE
 #    include "process_tap_dance.h"
 #endif
@@ -151,6 +154,22 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifdef CONNECTION_ENABLE
 #    include "connection.h"
 #endif
+#ifdef SEND_STRING_ASYNC_ENABLE
+#    include "send_string_async.h"
+#endif
+#ifdef TASK_TIMING_ENABLE
+#    include "task_timing.h"
+#    define TASK_TIMING_STAGE(stage) (stage)
+#else
+#    define TASK_TIMING_MEASURE(stage)
+#    define TASK_TIMING_STAGE(stage) TASK_SCHEDULER_UNTIMED
+#endif
+#ifdef TASK_SCHEDULER_ENABLE
+#    include "task_scheduler.h"
+#endif
+#ifdef LATENCY_TRACE_ENABLE
+#    include "latency_trace.h"
+#endif
 
 static uint32_t last_input_modification_time = 0;
 uint32_t        last_input_activity_time(void) {
@@ -228,16 +247,33 @@ uint32_t get_matrix_scan_rate(void) {
 #endif
 
 #ifdef MATRIX_HAS_GHOST
-static matrix_row_t get_real_keys(uint8_t row, matrix_row_t rowdata) {
-    matrix_row_t out = 0;
-    for (uint8_t col = 0; col < MATRIX_COLS; col++) {
-        // read each key in the row data and check if the keymap defines it as a real key
-        if (keycode_at_keymap_location(0, row, col) && (rowdata & (((matrix_row_t)1) << col))) {
-            // this creates new row data, if a key is defined in the keymap, it will be set here
-            out |= ((matrix_row_t)1) << col;
+// Keys defined on the base layer, built on first use so a ghost check doesn't read the keymap
+static matrix_row_t real_keys_mask[MATRIX_ROWS];
+static bool         real_keys_mask_valid = false;
+
+void matrix_real_keys_invalidate(void) {
+    real_keys_mask_valid = false;
+}
+
+static void build_real_keys_mask(void) {
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        matrix_row_t mask = 0;
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            // check if the keymap defines each key as a real key
+            if (keycode_at_keymap_location(0, row, col)) {
+                mask |= ((matrix_row_t)1) << col;
+            }
         }
+        real_keys_mask[row] = mask;
+    }
+    real_keys_mask_valid = true;
+}
+
+static inline matrix_row_t get_real_keys(uint8_t row, matrix_row_t rowdata) {
+    if (!real_keys_mask_valid) {
+        build_real_keys_mask();
     }
-    return out;
+    return rowdata & real_keys_mask[row];
 }
 
 static inline bool popcount_more_than_one(matrix_row_t rowdata) {
@@ -456,6 +492,10 @@ void quantum_init(void) {
  *
  * FIXME: needs doc
  */
+#ifdef TASK_SCHEDULER_ENABLE
+static void keyboard_task_scheduler_init(void);
+#endif
+
 void keyboard_init(void) {
     timer_init();
     sync_timer_init();
@@ -544,6 +584,9 @@ void keyboard_init(void) {
 #ifdef HAPTIC_ENABLE
     haptic_init();
 #endif
+#ifdef TASK_SCHEDULER_ENABLE
+    keyboard_task_scheduler_init();
+#endif
 
 #if defined(DEBUG_MATRIX_SCAN_RATE) && defined(CONSOLE_ENABLE)
     debug_enable = true;
@@ -595,6 +638,9 @@ static bool matrix_task(void) {
         return false;
     }
 
+#ifdef LATENCY_TRACE_ENABLE
+    latency_trace_mark_scan();
+#endif
     matrix_scan();
     bool matrix_changed = false;
     for (uint8_t row = 0; row < MATRIX_ROWS && !matrix_changed; row++) {
@@ -653,153 +699,286 @@ void quantum_task(void) {
 #endif
 
 #ifdef AUDIO_ENABLE
-    audio_task();
+    TASK_TIMING_MEASURE(TASK_TIMING_AUDIO) audio_task();
 #endif
 
 #if defined(AUDIO_ENABLE) && !defined(NO_MUSIC_MODE)
-    music_task();
+    TASK_TIMING_MEASURE(TASK_TIMING_MUSIC) music_task();
 #endif
 
 #ifdef KEY_OVERRIDE_ENABLE
-    key_override_task();
+    TASK_TIMING_MEASURE(TASK_TIMING_KEY_OVERRIDE) key_override_task();
 #endif
 
 #ifdef SEQUENCER_ENABLE
-    sequencer_task();
+    TASK_TIMING_MEASURE(TASK_TIMING_SEQUENCER) sequencer_task();
 #endif
 
 #ifdef TAP_DANCE_ENABLE
-    tap_dance_task();
+    TASK_TIMING_MEASURE(TASK_TIMING_TAP_DANCE) tap_dance_task();
 #endif
 
 #ifdef COMBO_ENABLE
-    combo_task();
+    TASK_TIMING_MEASURE(TASK_TIMING_COMBO) combo_task();
+#endif
+
+#ifdef CHORD_ENABLE
+    TASK_TIMING_MEASURE(TASK_TIMING_CHORD) chord_task();
 #endif
 
 #ifdef LEADER_ENABLE
-    leader_task();
+    TASK_TIMING_MEASURE(TASK_TIMING_LEADER) leader_task();
 #endif
 
 #ifdef WPM_ENABLE
-    decay_wpm();
+    TASK_TIMING_MEASURE(TASK_TIMING_WPM) decay_wpm();
 #endif
 
 #ifdef DIP_SWITCH_ENABLE
-    dip_switch_task();
+    TASK_TIMING_MEASURE(TASK_TIMING_DIP_SWITCH) dip_switch_task();
 #endif
 
 #ifdef AUTO_SHIFT_ENABLE
-    autoshift_matrix_scan();
+    TASK_TIMING_MEASURE(TASK_TIMING_AUTO_SHIFT) autoshift_matrix_scan();
 #endif
 
 #ifdef CAPS_WORD_ENABLE
-    caps_word_task();
+    TASK_TIMING_MEASURE(TASK_TIMING_CAPS_WORD) caps_word_task();
 #endif
 
 #ifdef SECURE_ENABLE
-    secure_task();
+    TASK_TIMING_MEASURE(TASK_TIMING_SECURE) secure_task();
 #endif
 
 #ifdef LAYER_LOCK_ENABLE
-    layer_lock_task();
+    TASK_TIMING_MEASURE(TASK_TIMING_LAYER_LOCK) layer_lock_task();
 #endif
 
-    host_task();
+#ifdef SEND_STRING_ASYNC_ENABLE
+    TASK_TIMING_MEASURE(TASK_TIMING_SEND_STRING_ASYNC) send_string_async_task();
+#endif
+
+    TASK_TIMING_MEASURE(TASK_TIMING_HOST) host_task();
 }
 
-/** \brief Main task that is repeatedly called as fast as possible. */
-void keyboard_task(void) {
-    __attribute__((unused)) bool activity_has_occurred = false;
+#ifdef TASK_SCHEDULER_ENABLE
+static bool keyboard_task_activity;
+
+static void matrix_scheduled_task(void) {
     if (matrix_task()) {
         last_matrix_activity_trigger();
-        activity_has_occurred = true;
+        keyboard_task_activity = true;
     }
+}
 
-    quantum_task();
+#    ifdef ENCODER_ENABLE
+static void encoder_scheduled_task(void) {
+    if (encoder_task()) {
+        last_encoder_activity_trigger();
+        keyboard_task_activity = true;
+    }
+}
+#    endif
 
-#if defined(SPLIT_WATCHDOG_ENABLE)
-    split_watchdog_task();
-#endif
+#    ifdef POINTING_DEVICE_ENABLE
+static void pointing_device_scheduled_task(void) {
+    if (pointing_device_task()) {
+        last_pointing_device_activity_trigger();
+        keyboard_task_activity = true;
+    }
+}
+#    endif
 
-#if defined(RGBLIGHT_ENABLE)
-    rgblight_task();
-#endif
+#    define INPUT_TASK(function, stage) \
+        { .task = (function), .task_class = TASK_CLASS_INPUT, .timing_stage = TASK_TIMING_STAGE(stage) }
+#    define COSMETIC_TASK(function, stage) \
+        { .task = (function), .task_class = TASK_CLASS_COSMETIC, .timing_stage = TASK_TIMING_STAGE(stage) }
+#    define COSMETIC_TASK_WHEN(function, pending, stage) \
+        { .task = (function), .has_pending_work = (pending), .task_class = TASK_CLASS_COSMETIC, .timing_stage = TASK_TIMING_STAGE(stage) }
+#    define COSMETIC_TASK_EVERY(function, period, stage) \
+        { .task = (function), .period_ms = (period), .task_class = TASK_CLASS_COSMETIC, .timing_stage = TASK_TIMING_STAGE(stage) }
+
+// The stages of keyboard_task(), input tasks keep their relative order, as do cosmetic ones
+static const task_scheduler_task_t keyboard_scheduled_tasks[] = {
+    INPUT_TASK(matrix_scheduled_task, TASK_TIMING_MATRIX),
+    INPUT_TASK(quantum_task, TASK_TIMING_QUANTUM),
+#    if defined(SPLIT_WATCHDOG_ENABLE)
+    INPUT_TASK(split_watchdog_task, TASK_TIMING_SPLIT_WATCHDOG),
+#    endif
+#    if defined(RGBLIGHT_ENABLE)
+    COSMETIC_TASK(rgblight_task, TASK_TIMING_RGBLIGHT),
+#    endif
+#    ifdef LED_MATRIX_ENABLE
+    COSMETIC_TASK(led_matrix_task, TASK_TIMING_LED_MATRIX),
+#    endif
+#    ifdef RGB_MATRIX_ENABLE
+    COSMETIC_TASK(rgb_matrix_task, TASK_TIMING_RGB_MATRIX),
+#    endif
+#    if defined(BACKLIGHT_ENABLE) && (defined(BACKLIGHT_PIN) || defined(BACKLIGHT_PINS))
+    COSMETIC_TASK(backlight_task, TASK_TIMING_BACKLIGHT),
+#    endif
+#    ifdef ENCODER_ENABLE
+    INPUT_TASK(encoder_scheduled_task, TASK_TIMING_ENCODER),
+#    endif
+#    ifdef POINTING_DEVICE_ENABLE
+    INPUT_TASK(pointing_device_scheduled_task, TASK_TIMING_POINTING_DEVICE),
+#    endif
+#    ifdef OLED_ENABLE
+    COSMETIC_TASK(oled_task, TASK_TIMING_OLED),
+#    endif
+#    ifdef ST7565_ENABLE
+    COSMETIC_TASK(st7565_task, TASK_TIMING_ST7565),
+#    endif
+#    ifdef MOUSEKEY_ENABLE
+    INPUT_TASK(mousekey_task, TASK_TIMING_MOUSEKEY),
+#    endif
+#    ifdef PS2_MOUSE_ENABLE
+    INPUT_TASK(ps2_mouse_task, TASK_TIMING_PS2_MOUSE),
+#    endif
+#    ifdef MIDI_ENABLE
+    INPUT_TASK(midi_task, TASK_TIMING_MIDI),
+#    endif
+#    ifdef JOYSTICK_ENABLE
+    INPUT_TASK(joystick_task, TASK_TIMING_JOYSTICK),
+#    endif
+#    ifdef BATTERY_ENABLE
+    COSMETIC_TASK(battery_task, TASK_TIMING_BATTERY),
+#    endif
+#    ifdef BLUETOOTH_ENABLE
+    INPUT_TASK(bluetooth_task, TASK_TIMING_BLUETOOTH),
+#    endif
+#    ifdef HAPTIC_ENABLE
+    COSMETIC_TASK(haptic_task, TASK_TIMING_HAPTIC),
+#    endif
+    // Only runs when the host changed the lock LEDs
+    COSMETIC_TASK_WHEN(led_task, led_task_pending, TASK_TIMING_LED),
+#    ifdef OS_DETECTION_ENABLE
+    // Only waits out a debounce of 250ms or more, checking it on every loop is wasted time
+    COSMETIC_TASK_EVERY(os_detection_task, 10, TASK_TIMING_OS_DETECTION),
+#    endif
+};
 
-#ifdef LED_MATRIX_ENABLE
-    led_matrix_task();
+static void keyboard_task_scheduler_init(void) {
+    for (uint8_t i = 0; i < ARRAY_SIZE(keyboard_scheduled_tasks); i++) {
+        task_scheduler_register(&keyboard_scheduled_tasks[i]);
+    }
+}
 #endif
-#ifdef RGB_MATRIX_ENABLE
-    rgb_matrix_task();
+
+/** \brief Main task that is repeatedly called as fast as possible. */
+void keyboard_task(void) {
+#ifdef TASK_TIMING_ENABLE
+    uint32_t keyboard_task_start_us = us_timer_read();
 #endif
+    __attribute__((unused)) bool activity_has_occurred = false;
+#ifdef TASK_SCHEDULER_ENABLE
+    keyboard_task_activity = false;
+    task_scheduler_run();
+    activity_has_occurred = keyboard_task_activity;
+#else
+    TASK_TIMING_MEASURE(TASK_TIMING_MATRIX) {
+        if (matrix_task()) {
+            last_matrix_activity_trigger();
+            activity_has_occurred = true;
+        }
+    }
 
-#if defined(BACKLIGHT_ENABLE)
-#    if defined(BACKLIGHT_PIN) || defined(BACKLIGHT_PINS)
-    backlight_task();
+    TASK_TIMING_MEASURE(TASK_TIMING_QUANTUM) quantum_task();
+
+#    if defined(SPLIT_WATCHDOG_ENABLE)
+    TASK_TIMING_MEASURE(TASK_TIMING_SPLIT_WATCHDOG) split_watchdog_task();
 #    endif
-#endif
 
-#ifdef ENCODER_ENABLE
-    if (encoder_task()) {
-        last_encoder_activity_trigger();
-        activity_has_occurred = true;
+#    if defined(RGBLIGHT_ENABLE)
+    TASK_TIMING_MEASURE(TASK_TIMING_RGBLIGHT) rgblight_task();
+#    endif
+
+#    ifdef LED_MATRIX_ENABLE
+    TASK_TIMING_MEASURE(TASK_TIMING_LED_MATRIX) led_matrix_task();
+#    endif
+#    ifdef RGB_MATRIX_ENABLE
+    TASK_TIMING_MEASURE(TASK_TIMING_RGB_MATRIX) rgb_matrix_task();
+#    endif
+
+#    if defined(BACKLIGHT_ENABLE)
+#        if defined(BACKLIGHT_PIN) || defined(BACKLIGHT_PINS)
+    TASK_TIMING_MEASURE(TASK_TIMING_BACKLIGHT) backlight_task();
+#        endif
+#    endif
+
+#    ifdef ENCODER_ENABLE
+    TASK_TIMING_MEASURE(TASK_TIMING_ENCODER) {
+        if (encoder_task()) {
+            last_encoder_activity_trigger();
+            activity_has_occurred = true;
+        }
     }
-#endif
+#    endif
 
-#ifdef POINTING_DEVICE_ENABLE
-    if (pointing_device_task()) {
-        last_pointing_device_activity_trigger();
-        activity_has_occurred = true;
+#    ifdef POINTING_DEVICE_ENABLE
+    TASK_TIMING_MEASURE(TASK_TIMING_POINTING_DEVICE) {
+        if (pointing_device_task()) {
+            last_pointing_device_activity_trigger();
+            activity_has_occurred = true;
+        }
     }
-#endif
+#    endif
 
-#ifdef OLED_ENABLE
-    oled_task();
-#    if OLED_TIMEOUT > 0
-    // Wake up oled if user is using those fabulous keys or spinning those encoders!
-    if (activity_has_occurred) oled_on();
+#    ifdef OLED_ENABLE
+    TASK_TIMING_MEASURE(TASK_TIMING_OLED) oled_task();
 #    endif
-#endif
 
-#ifdef ST7565_ENABLE
-    st7565_task();
-#    if ST7565_TIMEOUT > 0
-    // Wake up display if user is using those fabulous keys or spinning those encoders!
-    if (activity_has_occurred) st7565_on();
+#    ifdef ST7565_ENABLE
+    TASK_TIMING_MEASURE(TASK_TIMING_ST7565) st7565_task();
 #    endif
-#endif
 
-#ifdef MOUSEKEY_ENABLE
+#    ifdef MOUSEKEY_ENABLE
     // mousekey repeat & acceleration
-    mousekey_task();
-#endif
+    TASK_TIMING_MEASURE(TASK_TIMING_MOUSEKEY) mousekey_task();
+#    endif
 
-#ifdef PS2_MOUSE_ENABLE
-    ps2_mouse_task();
-#endif
+#    ifdef PS2_MOUSE_ENABLE
+    TASK_TIMING_MEASURE(TASK_TIMING_PS2_MOUSE) ps2_mouse_task();
+#    endif
 
-#ifdef MIDI_ENABLE
-    midi_task();
-#endif
+#    ifdef MIDI_ENABLE
+    TASK_TIMING_MEASURE(TASK_TIMING_MIDI) midi_task();
+#    endif
 
-#ifdef JOYSTICK_ENABLE
-    joystick_task();
-#endif
+#    ifdef JOYSTICK_ENABLE
+    TASK_TIMING_MEASURE(TASK_TIMING_JOYSTICK) joystick_task();
+#    endif
 
-#ifdef BATTERY_ENABLE
-    battery_task();
-#endif
+#    ifdef BATTERY_ENABLE
+    TASK_TIMING_MEASURE(TASK_TIMING_BATTERY) battery_task();
+#    endif
 
-#ifdef BLUETOOTH_ENABLE
-    bluetooth_task();
+#    ifdef BLUETOOTH_ENABLE
+    TASK_TIMING_MEASURE(TASK_TIMING_BLUETOOTH) bluetooth_task();
+#    endif
+
+#    ifdef HAPTIC_ENABLE
+    TASK_TIMING_MEASURE(TASK_TIMING_HAPTIC) haptic_task();
+#    endif
+
+    TASK_TIMING_MEASURE(TASK_TIMING_LED) led_task();
+
+#    ifdef OS_DETECTION_ENABLE
+    TASK_TIMING_MEASURE(TASK_TIMING_OS_DETECTION) os_detection_task();
+#    endif
 #endif
 
-#ifdef HAPTIC_ENABLE
-    haptic_task();
+#if defined(OLED_ENABLE) && OLED_TIMEOUT > 0
+    // Wake up oled if user is using those fabulous keys or spinning those encoders!
+    if (activity_has_occurred) oled_on();
 #endif
 
-    led_task();
+#if defined(ST7565_ENABLE) && ST7565_TIMEOUT > 0
+    // Wake up display if user is using those fabulous keys or spinning those encoders!
+    if (activity_has_occurred) st7565_on();
+#endif
 
-#ifdef OS_DETECTION_ENABLE
-    os_detection_task();
+#ifdef TASK_TIMING_ENABLE
+    task_timing_record(TASK_TIMING_KEYBOARD_TASK, keyboard_task_start_us);
 #endif
 }
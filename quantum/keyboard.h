@@ -40,6 +40,9 @@ typedef struct {
     uint16_t        time;
     keyevent_type_t type;
     bool            pressed;
+#ifdef LATENCY_TRACE_ENABLE
+    uint32_t scan_time_us; // Start of the matrix scan that produced the event
+#endif
 } keyevent_t;
 
 /* equivalent test of keypos_t */
@@ -74,7 +77,12 @@ static inline bool IS_DIPSWITCHEVENT(const keyevent_t event) {
 #define MAKE_KEYPOS(row_num, col_num) ((keypos_t){.row = (row_num), .col = (col_num)})
 
 /* Common keyevent_t object factory */
-#define MAKE_EVENT(row_num, col_num, press, event_type) ((keyevent_t){.key = MAKE_KEYPOS((row_num), (col_num)), .pressed = (press), .time = timer_read(), .type = (event_type)})
+#ifdef LATENCY_TRACE_ENABLE
+uint32_t latency_trace_scan_time_us(void);
+#    define MAKE_EVENT(row_num, col_num, press, event_type) ((keyevent_t){.key = MAKE_KEYPOS((row_num), (col_num)), .pressed = (press), .time = timer_read(), .type = (event_type), .scan_time_us = latency_trace_scan_time_us()})
+#else
+#    define MAKE_EVENT(row_num, col_num, press, event_type) ((keyevent_t){.key = MAKE_KEYPOS((row_num), (col_num)), .pressed = (press), .time = timer_read(), .type = (event_type)})
+#endif
 
 /**
  * @brief Constructs a key event for a pressed or released key.
@@ -139,6 +147,10 @@ void set_activity_timestamps(uint32_t matrix_timestamp, uint32_t encoder_timesta
 
 uint32_t get_matrix_scan_rate(void);
 
+#ifdef MATRIX_HAS_GHOST
+void matrix_real_keys_invalidate(void); // Rebuild the real-key masks used for ghost detection after a base layer keymap change
+#endif
+
 #ifdef __cplusplus
 }
 #endif
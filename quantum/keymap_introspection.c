@@ -119,8 +119,88 @@ __attribute__((weak)) combo_t* combo_get(uint16_t combo_idx) {
     return combo_get_raw(combo_idx);
 }
 
+#    if defined(COMBO_KEYCODE_INDEX)
+#        ifndef COMBO_KEYCODE_INDEX_SIZE
+// No combo has more than MAX_COMBO_LENGTH keys, so every combo of the keymap fits
+#            define COMBO_KEYCODE_INDEX_SIZE (ARRAY_SIZE(key_combos) * MAX_COMBO_LENGTH)
+#        endif
+
+STATIC_ASSERT(COMBO_KEYCODE_INDEX_SIZE >= ARRAY_SIZE(key_combos) * 2, "COMBO_KEYCODE_INDEX_SIZE is too small to hold two keys per combo");
+STATIC_ASSERT(COMBO_KEYCODE_INDEX_SIZE <= UINT16_MAX, "COMBO_KEYCODE_INDEX_SIZE must fit in 16 bits");
+
+combo_keycode_index_entry_t combo_keycode_index[COMBO_KEYCODE_INDEX_SIZE];
+const uint16_t              combo_keycode_index_size = COMBO_KEYCODE_INDEX_SIZE;
+#    endif // defined(COMBO_KEYCODE_INDEX)
+
 #endif // defined(COMBO_ENABLE)
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Chords
+
+#if defined(CHORD_ENABLE)
+
+uint8_t chord_key_count_raw(void) {
+    return ARRAY_SIZE(chord_keys);
+}
+__attribute__((weak)) uint8_t chord_key_count(void) {
+    return chord_key_count_raw();
+}
+
+STATIC_ASSERT(ARRAY_SIZE(chord_keys) <= CHORD_MAX_KEYS, "Number of chord keys exceeds the width of chord_keys_t");
+
+uint16_t chord_key_get_raw(uint8_t chord_key_idx) {
+    if (chord_key_idx >= chord_key_count_raw()) {
+        return KC_NO;
+    }
+    return pgm_read_word(&chord_keys[chord_key_idx]);
+}
+__attribute__((weak)) uint16_t chord_key_get(uint8_t chord_key_idx) {
+    return chord_key_get_raw(chord_key_idx);
+}
+
+uint16_t chord_count_raw(void) {
+    return ARRAY_SIZE(key_chords);
+}
+__attribute__((weak)) uint16_t chord_count(void) {
+    return chord_count_raw();
+}
+
+const chord_t* chord_get_raw(uint16_t chord_idx) {
+    if (chord_idx >= chord_count_raw()) {
+        return NULL;
+    }
+    return &key_chords[chord_idx];
+}
+__attribute__((weak)) const chord_t* chord_get(uint16_t chord_idx) {
+    return chord_get_raw(chord_idx);
+}
+
+#endif // defined(CHORD_ENABLE)
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Leader Sequences
+
+#if defined(LEADER_ENABLE) && defined(LEADER_SEQUENCE_TABLE)
+
+uint16_t leader_sequence_count_raw(void) {
+    return ARRAY_SIZE(leader_sequences);
+}
+__attribute__((weak)) uint16_t leader_sequence_count(void) {
+    return leader_sequence_count_raw();
+}
+
+const leader_sequence_t* leader_sequence_get_raw(uint16_t leader_sequence_idx) {
+    if (leader_sequence_idx >= leader_sequence_count_raw()) {
+        return NULL;
+    }
+    return &leader_sequences[leader_sequence_idx];
+}
+__attribute__((weak)) const leader_sequence_t* leader_sequence_get(uint16_t leader_sequence_idx) {
+    return leader_sequence_get_raw(leader_sequence_idx);
+}
+
+#endif // defined(LEADER_ENABLE) && defined(LEADER_SEQUENCE_TABLE)
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Tap Dance
 
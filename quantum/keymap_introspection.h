@@ -68,6 +68,58 @@ combo_t* combo_get(uint16_t combo_idx);
 
 #endif // defined(COMBO_ENABLE)
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Chords
+
+#if defined(CHORD_ENABLE)
+
+// Forward declaration of chord_t so we don't need to deal with header reordering
+struct chord_t;
+typedef struct chord_t chord_t;
+
+// Get the number of chord keys defined in the user's keymap, stored in firmware rather than any other persistent storage
+uint8_t chord_key_count_raw(void);
+// Get the number of chord keys defined in the user's keymap, potentially stored dynamically
+uint8_t chord_key_count(void);
+
+// Get the keycode of a chord key, stored in firmware rather than any other persistent storage
+uint16_t chord_key_get_raw(uint8_t chord_key_idx);
+// Get the keycode of a chord key, potentially stored dynamically
+uint16_t chord_key_get(uint8_t chord_key_idx);
+
+// Get the number of chords defined in the user's keymap, stored in firmware rather than any other persistent storage
+uint16_t chord_count_raw(void);
+// Get the number of chords defined in the user's keymap, potentially stored dynamically
+uint16_t chord_count(void);
+
+// Get the chord definition, stored in firmware rather than any other persistent storage
+const chord_t* chord_get_raw(uint16_t chord_idx);
+// Get the chord definition, potentially stored dynamically
+const chord_t* chord_get(uint16_t chord_idx);
+
+#endif // defined(CHORD_ENABLE)
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Leader Sequences
+
+#if defined(LEADER_ENABLE) && defined(LEADER_SEQUENCE_TABLE)
+
+// Forward declaration of leader_sequence_t so we don't need to deal with header reordering
+struct leader_sequence_t;
+typedef struct leader_sequence_t leader_sequence_t;
+
+// Get the number of leader sequences defined in the user's keymap, stored in firmware rather than any other persistent storage
+uint16_t leader_sequence_count_raw(void);
+// Get the number of leader sequences defined in the user's keymap, potentially stored dynamically
+uint16_t leader_sequence_count(void);
+
+// Get the leader sequence definition, stored in firmware rather than any other persistent storage
+const leader_sequence_t* leader_sequence_get_raw(uint16_t leader_sequence_idx);
+// Get the leader sequence definition, potentially stored dynamically
+const leader_sequence_t* leader_sequence_get(uint16_t leader_sequence_idx);
+
+#endif // defined(LEADER_ENABLE) && defined(LEADER_SEQUENCE_TABLE)
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Tap Dance
 
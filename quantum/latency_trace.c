@@ -0,0 +1,125 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+#include "latency_trace.h"
+#include "keycodes.h"
+#include "us_timer.h"
+#include "util.h"
+
+typedef struct {
+    uint32_t count;
+    uint32_t total_us;
+    uint32_t min_us;
+    uint32_t max_us;
+    uint16_t histogram[LATENCY_TRACE_HISTOGRAM_BUCKETS];
+} latency_trace_stats_t;
+
+static latency_trace_stats_t latency_trace_stats[LATENCY_TRACE_PATH_COUNT];
+static uint32_t              latency_trace_scan_us;
+static uint32_t              latency_trace_pending_us;
+static bool                  latency_trace_pending;
+static latency_trace_path_t  latency_trace_path;
+
+void latency_trace_mark_scan(void) {
+    latency_trace_scan_us = us_timer_read();
+}
+
+uint32_t latency_trace_scan_time_us(void) {
+    return latency_trace_scan_us;
+}
+
+void latency_trace_event(keyevent_t *event) {
+    // The newest input is what the user waits for, e.g. the release that resolves a mod-tap as a tap
+    latency_trace_pending_us = event->scan_time_us;
+    latency_trace_pending    = true;
+    latency_trace_path       = LATENCY_TRACE_PLAIN;
+}
+
+void latency_trace_process_record(keyrecord_t *record, uint16_t keycode) {
+    if (IS_COMBOEVENT(record->event)) {
+        latency_trace_path = LATENCY_TRACE_COMBO;
+    } else if (IS_QK_TAP_DANCE(keycode)) {
+        latency_trace_path = LATENCY_TRACE_TAP_DANCE;
+    } else if (IS_QK_MOD_TAP(keycode) || IS_QK_LAYER_TAP(keycode)) {
+        latency_trace_path = LATENCY_TRACE_MOD_TAP;
+    } else {
+        latency_trace_path = LATENCY_TRACE_PLAIN;
+    }
+}
+
+void latency_trace_report_sent(void) {
+    // Only the first report after an event counts, later ones are follow-ups such as the release of a tap
+    if (!latency_trace_pending) {
+        return;
+    }
+    latency_trace_pending = false;
+
+    uint32_t               latency_us = us_timer_read() - latency_trace_pending_us;
+    latency_trace_stats_t *stats      = &latency_trace_stats[latency_trace_path];
+
+    if (!stats->count) {
+        stats->min_us = UINT32_MAX;
+    }
+    us_timer_accumulate(&stats->count, &stats->total_us, latency_us);
+    stats->min_us = MIN(stats->min_us, latency_us);
+    stats->max_us = MAX(stats->max_us, latency_us);
+    us_timer_histogram_add(stats->histogram, LATENCY_TRACE_HISTOGRAM_BUCKETS, latency_us);
+}
+
+void latency_trace_reset(void) {
+    memset(latency_trace_stats, 0, sizeof(latency_trace_stats));
+    latency_trace_pending = false;
+}
+
+bool latency_trace_raw_hid_receive(uint8_t *data, uint8_t length) {
+    // data = [ command_id, sub_command_id, args... ]
+    if (data[0] != LATENCY_TRACE_RAW_HID_COMMAND_ID) {
+        return false;
+    }
+
+    uint8_t *command_data = &data[2];
+    switch (data[1]) {
+        case id_latency_trace_get_info: {
+            command_data[0] = LATENCY_TRACE_PROTOCOL_VERSION;
+            command_data[1] = LATENCY_TRACE_PATH_COUNT;
+            command_data[2] = LATENCY_TRACE_HISTOGRAM_BUCKETS;
+            break;
+        }
+        case id_latency_trace_get_path: {
+            uint8_t path = command_data[0];
+            if (path >= LATENCY_TRACE_PATH_COUNT) {
+                data[0] = 0xFF;
+                break;
+            }
+
+            latency_trace_stats_t *stats = &latency_trace_stats[path];
+            uint8_t               *out   = &command_data[1];
+
+            out = us_timer_put_u32(out, stats->count);
+            out = us_timer_put_u32(out, stats->total_us);
+            out = us_timer_put_u32(out, stats->min_us);
+            out = us_timer_put_u32(out, stats->count ? stats->total_us / stats->count : 0);
+            us_timer_put_u32(out, stats->max_us);
+            break;
+        }
+        case id_latency_trace_get_histogram: {
+            uint8_t path = command_data[0];
+            if (path >= LATENCY_TRACE_PATH_COUNT || !us_timer_histogram_page(command_data, latency_trace_stats[path].histogram, LATENCY_TRACE_HISTOGRAM_BUCKETS, length)) {
+                data[0] = 0xFF;
+            }
+            break;
+        }
+        case id_latency_trace_reset: {
+            latency_trace_reset();
+            break;
+        }
+        default: {
+            // The sub-command is not known
+            // Return the unhandled state
+            data[0] = 0xFF;
+            break;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,88 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "action.h"
+
+/**
+ * \file
+ *
+ * \defgroup latency_trace Latency Trace
+ *
+ * Measures the time from the matrix scan that saw a key change to the keyboard report it caused,
+ * keeping min/avg/max and a log2 histogram per feature path that a host tool can read back over raw HID.
+ * \{
+ */
+
+/**
+ * \brief The feature that handled the key when its report was sent, as reported over raw HID.
+ *
+ * New paths must only ever be appended.
+ */
+typedef enum {
+    LATENCY_TRACE_PLAIN = 0,
+    LATENCY_TRACE_MOD_TAP, // Mod-tap and layer-tap keys
+    LATENCY_TRACE_COMBO,
+    LATENCY_TRACE_TAP_DANCE,
+    LATENCY_TRACE_PATH_COUNT,
+} latency_trace_path_t;
+
+/**
+ * \brief Raw HID sub-commands, sent as `[ LATENCY_TRACE_RAW_HID_COMMAND_ID, sub-command, ... ]`.
+ */
+enum latency_trace_command_id {
+    id_latency_trace_get_info      = 0x01, // -> [ version, path count, bucket count ]
+    id_latency_trace_get_path      = 0x02, // [ path ] -> [ path, count:4, total_us:4, min_us:4, avg_us:4, max_us:4 ]
+    id_latency_trace_get_histogram = 0x03, // [ path, first bucket ] -> [ path, first bucket, bucket count, buckets:2... ]
+    id_latency_trace_reset         = 0x04,
+};
+
+#ifndef LATENCY_TRACE_RAW_HID_COMMAND_ID
+#    define LATENCY_TRACE_RAW_HID_COMMAND_ID 0xFD
+#endif
+
+// Bucket n counts latencies of [2^(n-1), 2^n) microseconds, the last bucket everything longer
+#ifndef LATENCY_TRACE_HISTOGRAM_BUCKETS
+#    define LATENCY_TRACE_HISTOGRAM_BUCKETS 20
+#endif
+
+#define LATENCY_TRACE_PROTOCOL_VERSION 0x01
+
+/**
+ * \brief Timestamp the matrix read that is about to happen, events created afterwards carry it.
+ */
+void latency_trace_mark_scan(void);
+
+/**
+ * \brief Start tracing an event passed to `action_exec()`, replacing any trace still waiting for its report.
+ */
+void latency_trace_event(keyevent_t *event);
+
+/**
+ * \brief Attribute the traced event to the feature path of the record being processed.
+ */
+void latency_trace_process_record(keyrecord_t *record, uint16_t keycode);
+
+/**
+ * \brief Mark that a keyboard report has been handed to the host driver, called from `host.c`.
+ */
+void latency_trace_report_sent(void);
+
+/**
+ * \brief Clear all recorded statistics and any event still waiting for its report.
+ */
+void latency_trace_reset(void);
+
+/**
+ * \brief Handle a latency trace raw HID command in place.
+ *
+ * \param data The received report, overwritten with the reply.
+ * \param length The length of the report.
+ * \return true if the report was a latency trace command and a reply should be sent.
+ */
+bool latency_trace_raw_hid_receive(uint8_t *data, uint8_t length);
+
+/** \} */
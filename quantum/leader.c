@@ -7,15 +7,133 @@
 
 #include <string.h>
 
+#ifdef LEADER_SEQUENCE_TABLE
+#    include "action.h"
+#    include "keycodes.h"
+#    include "keymap_introspection.h"
+#    include "progmem.h"
+#endif
+
 #ifndef LEADER_TIMEOUT
 #    define LEADER_TIMEOUT 300
 #endif
 
 // Leader key stuff
-bool     leading              = false;
-uint16_t leader_time          = 0;
-uint16_t leader_sequence[5]   = {0, 0, 0, 0, 0};
-uint8_t  leader_sequence_size = 0;
+bool     leading                                 = false;
+uint16_t leader_time                             = 0;
+uint16_t leader_sequence[LEADER_SEQUENCE_LENGTH] = {0};
+uint8_t  leader_sequence_size                    = 0;
+
+#ifdef LEADER_SEQUENCE_TABLE
+// In a sorted table, the sequences starting with the buffer are [first, last)
+static uint16_t leader_table_first  = 0;
+static uint16_t leader_table_last   = 0;
+static uint16_t leader_table_match  = LEADER_SEQUENCE_NOT_FOUND;
+static bool     leader_table_valid  = false;
+static bool     leader_table_sorted = false;
+
+static inline uint16_t leader_table_key(uint16_t index, uint8_t depth) {
+    return pgm_read_word(&leader_sequence_get(index)->keys[depth]);
+}
+
+void leader_sequence_table_invalidate(void) {
+    leader_table_valid = false;
+}
+
+uint16_t leader_sequence_table_match(void) {
+    return leader_table_match;
+}
+
+static void leader_table_check(void) {
+    leader_table_sorted = true;
+    for (uint16_t i = 1; i < leader_sequence_count() && leader_table_sorted; i++) {
+        for (uint8_t depth = 0; depth < LEADER_SEQUENCE_LENGTH; depth++) {
+            uint16_t previous = leader_table_key(i - 1, depth);
+            uint16_t current  = leader_table_key(i, depth);
+            if (previous != current) {
+                leader_table_sorted = previous < current;
+                break;
+            }
+        }
+    }
+    leader_table_valid = true;
+}
+
+static void leader_table_start(void) {
+    if (!leader_table_valid) {
+        leader_table_check();
+    }
+    leader_table_first = 0;
+    leader_table_last  = leader_sequence_count();
+    leader_table_match = LEADER_SEQUENCE_NOT_FOUND;
+}
+
+/* First sequence in [first, last) whose key at `depth` is not below `keycode`, or above it if `upper` */
+static uint16_t leader_table_bound(uint16_t first, uint16_t last, uint8_t depth, uint16_t keycode, bool upper) {
+    while (first < last) {
+        uint16_t middle = first + (last - first) / 2;
+        uint16_t key    = leader_table_key(middle, depth);
+        if (key < keycode || (upper && key == keycode)) {
+            first = middle + 1;
+        } else {
+            last = middle;
+        }
+    }
+    return first;
+}
+
+/* Follows the last key of the buffer down the table, returns whether a longer sequence starts with the buffer */
+static bool leader_table_advance(void) {
+    uint8_t  depth   = leader_sequence_size - 1;
+    uint16_t keycode = leader_sequence[depth];
+    bool     longer  = false;
+
+    leader_table_match = LEADER_SEQUENCE_NOT_FOUND;
+    if (leader_table_sorted) {
+        // Within the range every sequence has the same first `depth` keys, so the next key is sorted too
+        leader_table_first = leader_table_bound(leader_table_first, leader_table_last, depth, keycode, false);
+        leader_table_last  = leader_table_bound(leader_table_first, leader_table_last, depth, keycode, true);
+        if (leader_table_first == leader_table_last) {
+            return false;
+        }
+        // Shorter sequences are padded with KC_NO and sort first
+        if (leader_sequence_size == LEADER_SEQUENCE_LENGTH || leader_table_key(leader_table_first, leader_sequence_size) == KC_NO) {
+            leader_table_match = leader_table_first;
+        }
+        return leader_sequence_size < LEADER_SEQUENCE_LENGTH && leader_table_key(leader_table_last - 1, leader_sequence_size) != KC_NO;
+    }
+
+    for (uint16_t i = 0; i < leader_sequence_count(); i++) {
+        uint8_t matched = 0;
+        while (matched < leader_sequence_size && leader_table_key(i, matched) == leader_sequence[matched]) {
+            matched++;
+        }
+        if (matched < leader_sequence_size) {
+            continue;
+        }
+        if (leader_sequence_size < LEADER_SEQUENCE_LENGTH && leader_table_key(i, leader_sequence_size) != KC_NO) {
+            longer = true;
+        } else if (leader_table_match == LEADER_SEQUENCE_NOT_FOUND) {
+            leader_table_match = i;
+        }
+    }
+    return longer;
+}
+
+/* Taps the keycode of the matched sequence through the regular keycode handling */
+static void leader_table_send(void) {
+    if (leader_table_match == LEADER_SEQUENCE_NOT_FOUND) {
+        return;
+    }
+    keyrecord_t record = {
+        .event   = MAKE_COMBOEVENT(true),
+        .keycode = pgm_read_word(&leader_sequence_get(leader_table_match)->keycode),
+    };
+    process_record(&record);
+    record.event = MAKE_COMBOEVENT(false);
+    process_record(&record);
+}
+#endif
 
 __attribute__((weak)) void leader_start_user(void) {}
 
@@ -34,10 +152,16 @@ void leader_start(void) {
     leader_time          = timer_read();
     leader_sequence_size = 0;
     memset(leader_sequence, 0, sizeof(leader_sequence));
+#ifdef LEADER_SEQUENCE_TABLE
+    leader_table_start();
+#endif
 }
 
 void leader_end(void) {
     leading = false;
+#ifdef LEADER_SEQUENCE_TABLE
+    leader_table_send();
+#endif
     leader_end_user();
 }
 
@@ -65,7 +189,14 @@ bool leader_sequence_add(uint16_t keycode) {
     leader_sequence[leader_sequence_size] = keycode;
     leader_sequence_size++;
 
-    if (leader_add_user(keycode)) {
+#ifdef LEADER_SEQUENCE_TABLE
+    // A match that no longer sequence extends is sent right away, without waiting for the timeout
+    bool complete = !leader_table_advance() && leader_table_match != LEADER_SEQUENCE_NOT_FOUND;
+#else
+    bool complete = false;
+#endif
+
+    if (leader_add_user(keycode) || complete) {
         leader_end();
     }
     return true;
@@ -1,6 +1,8 @@
 // Copyright 2023 QMK
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#pragma once
+
 #include <stdbool.h>
 #include <stdint.h>
 
@@ -11,6 +13,21 @@
  * \{
  */
 
+/** Maximum number of keys in a leader sequence, excluding the leader key. */
+#define LEADER_SEQUENCE_LENGTH 5
+
+#ifdef LEADER_SEQUENCE_TABLE
+typedef struct leader_sequence_t {
+    /** Keys of the sequence, padded with `KC_NO`. The table must be sorted by these, key by key, ascending. */
+    uint16_t keys[LEADER_SEQUENCE_LENGTH];
+    uint16_t keycode;
+} leader_sequence_t;
+
+#    define LEADER_SEQUENCE(kc, ...) {.keys = {__VA_ARGS__}, .keycode = (kc)}
+
+#    define LEADER_SEQUENCE_NOT_FOUND UINT16_MAX
+#endif
+
 /**
  * \brief User callback, invoked when the leader sequence begins.
  */
@@ -125,4 +142,21 @@ bool leader_sequence_four_keys(uint16_t kc1, uint16_t kc2, uint16_t kc3, uint16_
  */
 bool leader_sequence_five_keys(uint16_t kc1, uint16_t kc2, uint16_t kc3, uint16_t kc4, uint16_t kc5);
 
+#ifdef LEADER_SEQUENCE_TABLE
+/**
+ * \brief The entry of `leader_sequences` matching the sequence buffer.
+ *
+ * Valid from the key that completes the sequence until the next leader sequence begins, so it can be
+ * checked in `leader_end_user()`.
+ *
+ * \return The index of the sequence, or `LEADER_SEQUENCE_NOT_FOUND`.
+ */
+uint16_t leader_sequence_table_match(void);
+
+/**
+ * \brief Re-check the sequence table, call after `leader_sequence_count()` or `leader_sequence_get()` start returning something else.
+ */
+void leader_sequence_table_invalidate(void);
+#endif
+
 /** \} */
@@ -164,13 +164,19 @@ void led_wakeup(void) {
     led_set(host_keyboard_leds());
 }
 
+static uint8_t last_led_status = 0;
+
+/** \brief Whether the host led state changed since led_task() last ran
+ */
+bool led_task_pending(void) {
+    return host_keyboard_leds() != last_led_status;
+}
+
 /** \brief set host led state
  *
  * Only sets state if change detected
  */
 void led_task(void) {
-    static uint8_t last_led_status = 0;
-
     // update LED
     uint8_t led_status = host_keyboard_leds();
     if (last_led_status != led_status) {
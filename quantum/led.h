@@ -47,6 +47,7 @@ void led_suspend(void);
 void led_wakeup(void);
 
 void led_task(void);
+bool led_task_pending(void);
 
 /* Callbacks */
 bool led_update_user(led_t led_state);
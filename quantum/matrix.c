@@ -56,6 +56,23 @@ static SPLIT_MUTABLE_ROW pin_t row_pins[MATRIX_ROWS_PER_HAND] = MATRIX_ROW_PINS;
 #    ifdef MATRIX_COL_PINS
 static SPLIT_MUTABLE_COL pin_t col_pins[MATRIX_COLS] = MATRIX_COL_PINS;
 #    endif // MATRIX_COL_PINS
+#    if defined(MATRIX_PARALLEL_COL_READ) && (DIODE_DIRECTION == COL2ROW) && defined(MATRIX_COL_PIN_RUNS) && (!defined(MATRIX_COL_PINS_RIGHT) || defined(MATRIX_COL_PIN_RUNS_RIGHT))
+#        define MATRIX_READ_COLS_BY_PORT
+// A run of column pins occupying consecutive bits of the same port, read with a single port access
+typedef struct {
+    pin_t        pin;       // first pin of the run
+    matrix_row_t mask;      // one bit per pin in the run, unshifted
+    uint8_t      col;       // column of the first pin
+    bool         same_port; // on the same port as the previous run, so reuse its read
+} matrix_col_run_t;
+
+static const matrix_col_run_t col_runs_left[] = MATRIX_COL_PIN_RUNS;
+#        ifdef MATRIX_COL_PIN_RUNS_RIGHT
+static const matrix_col_run_t col_runs_right[] = MATRIX_COL_PIN_RUNS_RIGHT;
+#        endif
+static const matrix_col_run_t *col_runs       = col_runs_left;
+static uint8_t                 col_runs_count = ARRAY_SIZE(col_runs_left);
+#    endif // MATRIX_PARALLEL_COL_READ
 #endif
 
 /* matrix state(1:on, 0:off) */
@@ -168,14 +185,29 @@ __attribute__((weak)) void matrix_init_pins(void) {
     }
 }
 
-__attribute__((weak)) void matrix_read_cols_on_row(matrix_row_t current_matrix[], uint8_t current_row) {
-    // Start with a clear matrix row
-    matrix_row_t current_row_value = 0;
+#            ifdef MATRIX_EVENT_DRIVEN_SCAN
+static void matrix_idle_select_all(void) {
+    for (uint8_t x = 0; x < MATRIX_ROWS_PER_HAND; x++) {
+        select_row(x);
+    }
+}
 
-    if (!select_row(current_row)) { // Select row
-        return;                     // skip NO_PIN row
+static void matrix_idle_unselect_all(void) {
+    unselect_rows();
+}
+
+static bool matrix_idle_any_pressed(void) {
+    for (uint8_t x = 0; x < MATRIX_COLS; x++) {
+        if (readMatrixPin(col_pins[x]) == 0) {
+            return true;
+        }
     }
-    matrix_output_select_delay();
+    return false;
+}
+#            endif // MATRIX_EVENT_DRIVEN_SCAN
+
+static matrix_row_t read_cols_by_pin(void) {
+    matrix_row_t row_value = 0;
 
     // For each col...
     matrix_row_t row_shifter = MATRIX_ROW_SHIFTER;
@@ -183,8 +215,61 @@ __attribute__((weak)) void matrix_read_cols_on_row(matrix_row_t current_matrix[]
         uint8_t pin_state = readMatrixPin(col_pins[col_index]);
 
         // Populate the matrix row with the state of the col pin
-        current_row_value |= pin_state ? 0 : row_shifter;
+        row_value |= pin_state ? 0 : row_shifter;
+    }
+    return row_value;
+}
+
+#            ifdef MATRIX_READ_COLS_BY_PORT
+static matrix_row_t read_cols_by_port(void) {
+    matrix_row_t row_value = 0;
+
+    // Read each port once, then shift every run of cols on it into place
+    uint32_t port_state = 0;
+    for (uint8_t i = 0; i < col_runs_count; i++) {
+        const matrix_col_run_t *run = &col_runs[i];
+        if (!run->same_port) {
+            port_state = gpio_read_port(run->pin);
+#                if MATRIX_INPUT_PRESSED_STATE == 0
+            port_state = ~port_state;
+#                endif
+        }
+        row_value |= (matrix_row_t)((port_state >> gpio_pin_index(run->pin)) & run->mask) << run->col;
     }
+    return row_value;
+}
+
+// Whether the runs cover every col with the pin col_pins has for it, which a config.h that overrides the pins
+// generated from info.json breaks. The pins of a run are consecutive pin_t values on every platform.
+static bool col_runs_match_col_pins(void) {
+    matrix_row_t covered = 0;
+    uint8_t      count   = 0;
+    for (uint8_t i = 0; i < col_runs_count; i++) {
+        const matrix_col_run_t *run = &col_runs[i];
+        for (uint8_t bit = 0; (run->mask >> bit) & 1; bit++) {
+            uint8_t col = run->col + bit;
+            if (col >= MATRIX_COLS || (covered & (MATRIX_ROW_SHIFTER << col)) || col_pins[col] != (pin_t)(run->pin + bit)) {
+                return false;
+            }
+            covered |= MATRIX_ROW_SHIFTER << col;
+            count++;
+        }
+    }
+    return count == MATRIX_COLS;
+}
+#            endif // MATRIX_READ_COLS_BY_PORT
+
+__attribute__((weak)) void matrix_read_cols_on_row(matrix_row_t current_matrix[], uint8_t current_row) {
+    if (!select_row(current_row)) { // Select row
+        return;                     // skip NO_PIN row
+    }
+    matrix_output_select_delay();
+
+#            ifdef MATRIX_READ_COLS_BY_PORT
+    matrix_row_t current_row_value = col_runs != NULL ? read_cols_by_port() : read_cols_by_pin();
+#            else
+    matrix_row_t current_row_value = read_cols_by_pin();
+#            endif
 
     // Unselect row
     unselect_row(current_row);
@@ -231,6 +316,27 @@ __attribute__((weak)) void matrix_init_pins(void) {
     }
 }
 
+#            ifdef MATRIX_EVENT_DRIVEN_SCAN
+static void matrix_idle_select_all(void) {
+    for (uint8_t x = 0; x < MATRIX_COLS; x++) {
+        select_col(x);
+    }
+}
+
+static void matrix_idle_unselect_all(void) {
+    unselect_cols();
+}
+
+static bool matrix_idle_any_pressed(void) {
+    for (uint8_t x = 0; x < MATRIX_ROWS_PER_HAND; x++) {
+        if (readMatrixPin(row_pins[x]) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+#            endif // MATRIX_EVENT_DRIVEN_SCAN
+
 __attribute__((weak)) void matrix_read_rows_on_col(matrix_row_t current_matrix[], uint8_t current_col, matrix_row_t row_shifter) {
     bool key_pressed = false;
 
@@ -266,6 +372,79 @@ __attribute__((weak)) void matrix_read_rows_on_col(matrix_row_t current_matrix[]
 #    error DIODE_DIRECTION is not defined!
 #endif
 
+#ifdef MATRIX_EVENT_DRIVEN_SCAN
+#    if defined(DIRECT_PINS) || !defined(MATRIX_ROW_PINS) || !defined(MATRIX_COL_PINS)
+#        error MATRIX_EVENT_DRIVEN_SCAN requires MATRIX_ROW_PINS and MATRIX_COL_PINS
+#    endif
+
+/* While idle, every key is released and all rows (or cols for ROW2COL) are
+ * held selected, so any press shows up on the input pins without scanning. */
+static bool          matrix_idle         = false;
+static volatile bool matrix_idle_wake_up = false;
+
+/** \brief matrix_idle_enter_kb
+ *
+ * Called once all lines have been selected for idle. Override to arm
+ * pin-change interrupts on the input pins, which should call matrix_idle_wakeup().
+ */
+__attribute__((weak)) void matrix_idle_enter_kb(void) {}
+
+/** \brief matrix_idle_exit_kb
+ *
+ * Called before full scanning resumes. Override to disarm pin-change interrupts.
+ */
+__attribute__((weak)) void matrix_idle_exit_kb(void) {}
+
+void matrix_idle_wakeup(void) {
+    matrix_idle_wake_up = true;
+}
+
+static bool matrix_is_released(void) {
+    for (uint8_t row = 0; row < MATRIX_ROWS_PER_HAND; row++) {
+#    ifdef SPLIT_KEYBOARD
+        if (raw_matrix[row] || matrix[thisHand + row]) {
+#    else
+        if (raw_matrix[row] || matrix[row]) {
+#    endif
+            return false;
+        }
+    }
+    return true;
+}
+
+static void matrix_idle_enter(void) {
+    matrix_idle_select_all();
+    matrix_output_select_delay();
+    matrix_idle_wake_up = false;
+    matrix_idle         = true;
+    matrix_idle_enter_kb();
+#    ifdef MATRIX_EVENT_DRIVEN_SCAN_INTERRUPT
+    // A press from before the interrupts were armed raised no edge for them
+    if (matrix_idle_any_pressed()) {
+        matrix_idle_wake_up = true;
+    }
+#    endif
+}
+
+/* Returns true if a full scan is required. */
+static bool matrix_idle_exit(void) {
+#    ifdef MATRIX_EVENT_DRIVEN_SCAN_INTERRUPT
+    if (!matrix_idle_wake_up) {
+        return false;
+    }
+    matrix_idle_wake_up = false;
+#    endif
+    if (!matrix_idle_any_pressed()) {
+        return false;
+    }
+    matrix_idle_exit_kb();
+    matrix_idle_unselect_all();
+    matrix_output_unselect_delay(0, true);
+    matrix_idle = false;
+    return true;
+}
+#endif // MATRIX_EVENT_DRIVEN_SCAN
+
 void matrix_init(void) {
 #ifdef SPLIT_KEYBOARD
     // Set pinout for right half if pinout for that half is defined
@@ -289,15 +468,30 @@ void matrix_init(void) {
         for (uint8_t i = 0; i < MATRIX_COLS; i++) {
             col_pins[i] = col_pins_right[i];
         }
+#        ifdef MATRIX_READ_COLS_BY_PORT
+        col_runs       = col_runs_right;
+        col_runs_count = ARRAY_SIZE(col_runs_right);
+#        endif
 #    endif
     }
 
     thisHand = isLeftHand ? 0 : (MATRIX_ROWS_PER_HAND);
     thatHand = MATRIX_ROWS_PER_HAND - thisHand;
 #endif
+#ifdef MATRIX_READ_COLS_BY_PORT
+    // Fall back to reading every pin when the runs describe other pins
+    if (!col_runs_match_col_pins()) {
+        col_runs       = NULL;
+        col_runs_count = 0;
+    }
+#endif
 
     // initialize key pins
     matrix_init_pins();
+#ifdef MATRIX_EVENT_DRIVEN_SCAN
+    // The pins are back to unselected, so start out scanning
+    matrix_idle = false;
+#endif
 
     // initialize matrix state: all keys off
     memset(matrix, 0, sizeof(matrix));
@@ -316,9 +510,7 @@ __attribute__((weak)) bool transport_master_if_connected(matrix_row_t master_mat
 }
 #endif
 
-uint8_t matrix_scan(void) {
-    matrix_row_t curr_matrix[MATRIX_ROWS] = {0};
-
+static inline void matrix_read(matrix_row_t curr_matrix[]) {
 #if defined(DIRECT_PINS) || (DIODE_DIRECTION == COL2ROW)
     // Set row, read cols
     for (uint8_t current_row = 0; current_row < MATRIX_ROWS_PER_HAND; current_row++) {
@@ -331,6 +523,19 @@ uint8_t matrix_scan(void) {
         matrix_read_rows_on_col(curr_matrix, current_col, row_shifter);
     }
 #endif
+}
+
+uint8_t matrix_scan(void) {
+    matrix_row_t curr_matrix[MATRIX_ROWS] = {0};
+
+#ifdef MATRIX_EVENT_DRIVEN_SCAN
+    // While idle nothing is pressed, so the cleared matrix is already the result of a scan.
+    if (!matrix_idle || matrix_idle_exit()) {
+        matrix_read(curr_matrix);
+    }
+#else
+    matrix_read(curr_matrix);
+#endif
 
     bool changed = memcmp(raw_matrix, curr_matrix, sizeof(curr_matrix)) != 0;
     if (changed) memcpy(raw_matrix, curr_matrix, sizeof(curr_matrix));
@@ -341,5 +546,12 @@ uint8_t matrix_scan(void) {
     changed = debounce(raw_matrix, matrix, changed);
     matrix_scan_kb();
 #endif
+
+#ifdef MATRIX_EVENT_DRIVEN_SCAN
+    // Only go idle once debouncing has settled on every key being released.
+    if (!matrix_idle && matrix_is_released()) {
+        matrix_idle_enter();
+    }
+#endif
     return (uint8_t)changed;
 }
@@ -75,6 +75,13 @@ void matrix_io_delay(void);
 void matrix_power_up(void);
 void matrix_power_down(void);
 
+#ifdef MATRIX_EVENT_DRIVEN_SCAN
+void matrix_idle_enter_kb(void);
+void matrix_idle_exit_kb(void);
+// Signals a change on the input pins while idle, safe to call from an interrupt handler.
+void matrix_idle_wakeup(void);
+#endif
+
 void matrix_init_kb(void);
 void matrix_scan_kb(void);
 
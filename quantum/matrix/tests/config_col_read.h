@@ -0,0 +1,48 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#define MATRIX_ROWS 4
+#define MATRIX_COLS 8
+
+// Pins named like AVR pins, as (port << 4) | index
+#define A0 0x00
+#define A1 0x01
+#define A2 0x02
+#define A3 0x03
+#define B4 0x14
+#define B5 0x15
+#define B6 0x16
+#define B7 0x17
+#define B10 0x1A
+#define C0 0x20
+#define C1 0x21
+#define C5 0x25
+
+#define DIODE_DIRECTION COL2ROW
+
+#define MATRIX_ROW_PINS {A0, A1, A2, A3}
+
+#ifdef MATRIX_COL_PINS_OVERRIDE
+// The keyboard's config.h swaps two cols after info.json was written
+#    define MATRIX_COL_PINS {B4, B5, B6, C5, B7, C1, C0, B10}
+#endif
+
+// What generate-config-h writes to info_config.h for "cols": ["B4", "B5", "B6", "C5", "B7", "C0", "C1", "B10"]
+#ifndef MATRIX_COL_PINS
+#    define MATRIX_COL_PINS { B4, B5, B6, C5, B7, C0, C1, B10 }
+#endif // MATRIX_COL_PINS
+#ifndef MATRIX_COL_PIN_RUNS
+#    define MATRIX_COL_PIN_RUNS { { B4, 0x7, 0, false }, { B7, 0x1, 4, true }, { B10, 0x1, 7, true }, { C5, 0x1, 3, false }, { C0, 0x3, 5, true } }
+#endif // MATRIX_COL_PIN_RUNS
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "mock.h"
+
+#ifdef __cplusplus
+};
+#endif
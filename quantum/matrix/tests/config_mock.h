@@ -0,0 +1,22 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#define MATRIX_ROWS 2
+#define MATRIX_COLS 3
+
+#define MATRIX_ROW_PINS {0, 1}
+#define MATRIX_COL_PINS {2, 3, 4}
+
+#define DIODE_DIRECTION COL2ROW
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "mock.h"
+
+#ifdef __cplusplus
+};
+#endif
@@ -0,0 +1,70 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+#include <cstring>
+
+extern "C" {
+#include "matrix.h"
+}
+
+class MatrixColRead : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        memset(mock_switches, 0, sizeof(mock_switches));
+        matrix_init();
+        mock_pin_reads  = 0;
+        mock_port_reads = 0;
+    }
+
+    /* Scans the matrix with the given switches down, and checks every row against them */
+    void scan_and_compare(const matrix_row_t (&rows)[MATRIX_ROWS]) {
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                mock_switches[row][col] = rows[row] & (MATRIX_ROW_SHIFTER << col);
+            }
+        }
+        matrix_scan();
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            EXPECT_EQ(matrix_get_row(row), rows[row]) << "row " << (int)row;
+        }
+    }
+};
+
+TEST_F(MatrixColRead, EveryColLandsInItsBit) {
+    for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            matrix_row_t rows[MATRIX_ROWS] = {0};
+            rows[row]                      = MATRIX_ROW_SHIFTER << col;
+            scan_and_compare(rows);
+        }
+    }
+}
+
+TEST_F(MatrixColRead, MixedRowsMatchTheSwitches) {
+    // A fixed sequence rather than every combination, each scan changing every row
+    uint32_t state = 0x1234567;
+    for (int i = 0; i < 256; i++) {
+        matrix_row_t rows[MATRIX_ROWS];
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            state     = state * 1103515245 + 12345;
+            rows[row] = state >> 16;
+        }
+        scan_and_compare(rows);
+    }
+}
+
+TEST_F(MatrixColRead, ReadsPortsOrPins) {
+    matrix_row_t rows[MATRIX_ROWS] = {0x81, 0x24, 0x18, 0xFF};
+    scan_and_compare(rows);
+#if defined(MATRIX_PARALLEL_COL_READ) && !defined(MATRIX_COL_PINS_OVERRIDE)
+    // One read of port B and one of port C per row
+    EXPECT_EQ(mock_port_reads, 2u * MATRIX_ROWS);
+    EXPECT_EQ(mock_pin_reads, 0u);
+#else
+    // The generic path, which an override of the col pins falls back to
+    EXPECT_EQ(mock_port_reads, 0u);
+    EXPECT_EQ(mock_pin_reads, 1u * MATRIX_ROWS * MATRIX_COLS);
+#endif
+}
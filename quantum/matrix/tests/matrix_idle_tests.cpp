@@ -0,0 +1,105 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+#include <cstring>
+#include <functional>
+
+extern "C" {
+#include "matrix.h"
+}
+
+static int                   idle_enters = 0;
+static int                   idle_exits  = 0;
+static std::function<void()> on_idle_enter;
+
+extern "C" {
+void matrix_idle_enter_kb(void) {
+    idle_enters++;
+    // Runs right before the keyboard would arm its pin-change interrupts
+    if (on_idle_enter) {
+        on_idle_enter();
+    }
+}
+
+void matrix_idle_exit_kb(void) {
+    idle_exits++;
+}
+}
+
+class MatrixIdle : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        memset(mock_switches, 0, sizeof(mock_switches));
+        idle_enters   = 0;
+        idle_exits    = 0;
+        on_idle_enter = nullptr;
+        matrix_init();
+    }
+
+    /* Scans the released matrix, which goes idle right away without debouncing */
+    void scan_released() {
+        matrix_scan();
+        ASSERT_EQ(idle_enters, idle_exits + 1);
+    }
+};
+
+TEST_F(MatrixIdle, EntersIdleOnceEverythingIsReleased) {
+    scan_released();
+
+    mock_pin_reads = 0;
+    for (int i = 0; i < 10; i++) {
+        EXPECT_FALSE(matrix_scan());
+    }
+    EXPECT_EQ(idle_enters, 1);
+#ifdef MATRIX_EVENT_DRIVEN_SCAN_INTERRUPT
+    // Nothing is read until an interrupt wakes the matrix up
+    EXPECT_EQ(mock_pin_reads, 0u);
+#else
+    // Only the inputs are read, with every row selected at once
+    EXPECT_EQ(mock_pin_reads, 10u * MATRIX_COLS);
+#endif
+}
+
+TEST_F(MatrixIdle, PressWakesUpAndReleaseParksAgain) {
+    scan_released();
+
+    mock_switches[1][2] = true;
+#ifdef MATRIX_EVENT_DRIVEN_SCAN_INTERRUPT
+    EXPECT_FALSE(matrix_scan());
+    matrix_idle_wakeup();
+#endif
+    EXPECT_TRUE(matrix_scan());
+    EXPECT_EQ(matrix_get_row(1), 1u << 2);
+    EXPECT_EQ(matrix_get_row(0), 0u);
+    EXPECT_EQ(idle_exits, 1);
+
+    // Held keys keep the matrix scanning
+    EXPECT_FALSE(matrix_scan());
+    EXPECT_EQ(idle_enters, 1);
+
+    mock_switches[1][2] = false;
+    EXPECT_TRUE(matrix_scan());
+    EXPECT_EQ(matrix_get_row(1), 0u);
+    EXPECT_EQ(idle_enters, 2);
+}
+
+TEST_F(MatrixIdle, PressWhileEnteringIdleIsNotLost) {
+    scan_released();
+
+    mock_switches[0][0] = true;
+#ifdef MATRIX_EVENT_DRIVEN_SCAN_INTERRUPT
+    matrix_idle_wakeup();
+#endif
+    EXPECT_TRUE(matrix_scan());
+
+    // A key pressed after the rows were selected, but before the interrupts were armed, raises no edge
+    on_idle_enter       = [] { mock_switches[0][1] = true; };
+    mock_switches[0][0] = false;
+    EXPECT_TRUE(matrix_scan());
+    EXPECT_EQ(idle_enters, 2);
+
+    EXPECT_TRUE(matrix_scan());
+    EXPECT_EQ(matrix_get_row(0), 1u << 1);
+}
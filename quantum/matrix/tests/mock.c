@@ -0,0 +1,55 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "mock.h"
+
+static const pin_t row_pins[MATRIX_ROWS] = MATRIX_ROW_PINS;
+static const pin_t col_pins[MATRIX_COLS] = MATRIX_COL_PINS;
+
+static bool pin_output[64] = {0};
+static bool pin_level[64]  = {0};
+
+bool     mock_switches[MATRIX_ROWS][MATRIX_COLS] = {0};
+uint32_t mock_pin_reads                          = 0;
+uint32_t mock_port_reads                         = 0;
+
+void mock_set_pin_output(pin_t pin) {
+    pin_output[pin] = true;
+}
+
+void mock_write_pin(pin_t pin, bool level) {
+    pin_level[pin] = level;
+}
+
+void mock_set_pin_input_high(pin_t pin) {
+    pin_output[pin] = false;
+    pin_level[pin]  = true;
+}
+
+static bool level_of(pin_t pin) {
+    for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+        if (col_pins[col] != pin) {
+            continue;
+        }
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            if (pin_output[row_pins[row]] && !pin_level[row_pins[row]] && mock_switches[row][col]) {
+                return false;
+            }
+        }
+    }
+    return pin_level[pin];
+}
+
+bool mock_read_pin(pin_t pin) {
+    mock_pin_reads++;
+    return level_of(pin);
+}
+
+uint32_t mock_read_port(pin_t pin) {
+    mock_port_reads++;
+    uint32_t levels = 0;
+    for (uint8_t index = 0; index < 16; index++) {
+        levels |= (uint32_t)level_of((pin & 0xF0) | index) << index;
+    }
+    return levels;
+}
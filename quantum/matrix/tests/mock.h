@@ -0,0 +1,30 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef uint8_t pin_t;
+
+#define gpio_set_pin_output(pin) (mock_set_pin_output(pin))
+#define gpio_write_pin_low(pin) (mock_write_pin(pin, false))
+#define gpio_write_pin_high(pin) (mock_write_pin(pin, true))
+#define gpio_set_pin_input_high(pin) (mock_set_pin_input_high(pin))
+#define gpio_read_pin(pin) (mock_read_pin(pin))
+#define gpio_read_port(pin) (mock_read_port(pin))
+#define gpio_pin_index(pin) ((pin) & 0xF)
+
+void mock_set_pin_output(pin_t pin);
+void mock_write_pin(pin_t pin, bool level);
+void mock_set_pin_input_high(pin_t pin);
+bool mock_read_pin(pin_t pin);
+// Levels of the 16 pins on the port of the pin, with ports laid out like AVR pins, as (port << 4) | index
+uint32_t mock_read_port(pin_t pin);
+
+// Switch states of the mocked matrix, which pull a column low while their row is driven low
+extern bool mock_switches[MATRIX_ROWS][MATRIX_COLS];
+// Number of input pins and ports read so far
+extern uint32_t mock_pin_reads;
+extern uint32_t mock_port_reads;
@@ -0,0 +1,42 @@
+# Copyright 2026 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+MATRIX_IDLE_SRC := \
+	platforms/test/timer.c \
+	$(QUANTUM_PATH)/matrix/tests/mock.c \
+	$(QUANTUM_PATH)/matrix/tests/matrix_idle_tests.cpp \
+	$(QUANTUM_PATH)/debounce/none.c \
+	$(QUANTUM_PATH)/bitwise.c \
+	$(QUANTUM_PATH)/matrix_common.c \
+	$(QUANTUM_PATH)/matrix.c
+
+matrix_idle_DEFS := -DMATRIX_EVENT_DRIVEN_SCAN -DIGNORE_ATOMIC_BLOCK
+matrix_idle_CONFIG := $(QUANTUM_PATH)/matrix/tests/config_mock.h
+matrix_idle_SRC := $(MATRIX_IDLE_SRC)
+
+matrix_idle_interrupt_DEFS := -DMATRIX_EVENT_DRIVEN_SCAN -DMATRIX_EVENT_DRIVEN_SCAN_INTERRUPT -DIGNORE_ATOMIC_BLOCK
+matrix_idle_interrupt_CONFIG := $(QUANTUM_PATH)/matrix/tests/config_mock.h
+matrix_idle_interrupt_SRC := $(MATRIX_IDLE_SRC)
+
+# The same switches read through the generic per-pin path, the port runs generated from info.json, and a config.h
+# override of the col pins that the runs do not match
+MATRIX_COL_READ_SRC := \
+	platforms/test/timer.c \
+	$(QUANTUM_PATH)/matrix/tests/mock.c \
+	$(QUANTUM_PATH)/matrix/tests/matrix_col_read_tests.cpp \
+	$(QUANTUM_PATH)/debounce/none.c \
+	$(QUANTUM_PATH)/bitwise.c \
+	$(QUANTUM_PATH)/matrix_common.c \
+	$(QUANTUM_PATH)/matrix.c
+
+matrix_col_read_pins_DEFS := -DIGNORE_ATOMIC_BLOCK
+matrix_col_read_pins_CONFIG := $(QUANTUM_PATH)/matrix/tests/config_col_read.h
+matrix_col_read_pins_SRC := $(MATRIX_COL_READ_SRC)
+
+matrix_col_read_ports_DEFS := -DMATRIX_PARALLEL_COL_READ -DIGNORE_ATOMIC_BLOCK
+matrix_col_read_ports_CONFIG := $(QUANTUM_PATH)/matrix/tests/config_col_read.h
+matrix_col_read_ports_SRC := $(MATRIX_COL_READ_SRC)
+
+matrix_col_read_override_DEFS := -DMATRIX_PARALLEL_COL_READ -DMATRIX_COL_PINS_OVERRIDE -DIGNORE_ATOMIC_BLOCK
+matrix_col_read_override_CONFIG := $(QUANTUM_PATH)/matrix/tests/config_col_read.h
+matrix_col_read_override_SRC := $(MATRIX_COL_READ_SRC)
@@ -0,0 +1,6 @@
+TEST_LIST += \
+	matrix_idle \
+	matrix_idle_interrupt \
+	matrix_col_read_pins \
+	matrix_col_read_ports \
+	matrix_col_read_override
@@ -0,0 +1,42 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "compiler_support.h"
+#include "eeprom.h"
+#include "util.h"
+#include "nvm_autocorrect.h"
+#include "nvm_eeprom_eeconfig_internal.h"
+#include "nvm_eeprom_autocorrect_internal.h"
+
+#ifdef AUTOCORRECT_NVM_DICTIONARY_SIZE
+STATIC_ASSERT(AUTOCORRECT_EEPROM_ADDR >= EECONFIG_SIZE, "AUTOCORRECT_NVM_DICTIONARY_SIZE is larger than the EEPROM left after eeconfig");
+STATIC_ASSERT(AUTOCORRECT_EEPROM_ADDR + AUTOCORRECT_NVM_DICTIONARY_SIZE <= TOTAL_EEPROM_BYTE_COUNT, "AUTOCORRECT_NVM_DICTIONARY_SIZE is configured to use more space than what is available for the selected EEPROM driver");
+#endif
+
+uint32_t nvm_autocorrect_read_dictionary(void *buf, uint32_t offset, uint32_t length) {
+#ifdef AUTOCORRECT_NVM_DICTIONARY_SIZE
+    if (offset >= AUTOCORRECT_NVM_DICTIONARY_SIZE) {
+        return 0;
+    }
+    void *ee_start = (void *)(uintptr_t)(AUTOCORRECT_EEPROM_ADDR + offset);
+    void *ee_end   = (void *)(uintptr_t)(AUTOCORRECT_EEPROM_ADDR + MIN(AUTOCORRECT_NVM_DICTIONARY_SIZE, offset + length));
+    eeprom_read_block(buf, ee_start, ee_end - ee_start);
+    return ee_end - ee_start;
+#else
+    return 0;
+#endif
+}
+
+uint32_t nvm_autocorrect_update_dictionary(const void *buf, uint32_t offset, uint32_t length) {
+#ifdef AUTOCORRECT_NVM_DICTIONARY_SIZE
+    if (offset >= AUTOCORRECT_NVM_DICTIONARY_SIZE) {
+        return 0;
+    }
+    void *ee_start = (void *)(uintptr_t)(AUTOCORRECT_EEPROM_ADDR + offset);
+    void *ee_end   = (void *)(uintptr_t)(AUTOCORRECT_EEPROM_ADDR + MIN(AUTOCORRECT_NVM_DICTIONARY_SIZE, offset + length));
+    eeprom_update_block(buf, ee_start, ee_end - ee_start);
+    return ee_end - ee_start;
+#else
+    return 0;
+#endif
+}
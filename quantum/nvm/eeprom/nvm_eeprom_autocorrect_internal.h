@@ -0,0 +1,11 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+// The runtime-updatable autocorrect dictionary takes the top of EEPROM,
+// dynamic keymaps and macros end below it.
+#if defined(AUTOCORRECT_ENABLE) && defined(AUTOCORRECT_NVM_DICTIONARY_SIZE)
+#    ifndef AUTOCORRECT_EEPROM_ADDR
+#        define AUTOCORRECT_EEPROM_ADDR (TOTAL_EEPROM_BYTE_COUNT - (AUTOCORRECT_NVM_DICTIONARY_SIZE))
+#    endif
+#endif
@@ -0,0 +1,8 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include <stdint.h>
+
+uint32_t nvm_autocorrect_read_dictionary(void *buf, uint32_t offset, uint32_t length);
+uint32_t nvm_autocorrect_update_dictionary(const void *buf, uint32_t offset, uint32_t length);
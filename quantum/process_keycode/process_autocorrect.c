@@ -12,7 +12,18 @@
 #include "send_string.h"
 #include "action_util.h"
 
-#if __has_include("autocorrect_data.h")
+#ifdef AUTOCORRECT_EXTERNAL_DICTIONARY
+#    include "debug.h"
+#    include "util.h"
+#    ifdef AUTOCORRECT_NVM_DICTIONARY_SIZE
+#        include <stddef.h>
+#        include "nvm_autocorrect.h"
+#        include "crc.h"
+#    elif defined(FLASH_ENABLE)
+#        include "flash.h"
+#    endif
+#    define AUTOCORRECT_MIN_LENGTH autocorrect_dictionary_min_length()
+#elif __has_include("autocorrect_data.h")
 #    include "autocorrect_data.h"
 #else
 #    pragma message "Autocorrect is using the default library."
@@ -22,6 +33,547 @@
 static uint8_t typo_buffer[AUTOCORRECT_MAX_LENGTH] = {KC_SPC};
 static uint8_t typo_buffer_size                    = 1;
 
+#ifdef AUTOCORRECT_EXTERNAL_DICTIONARY
+#    define AUTOCORRECT_DICTIONARY_HEADER_SIZE 16
+
+typedef struct {
+    uint32_t address; // block aligned, UINT32_MAX while unused
+    uint16_t used;
+    uint8_t  data[AUTOCORRECT_DICTIONARY_CACHE_BLOCK_SIZE];
+} autocorrect_cache_block_t;
+
+_Static_assert((AUTOCORRECT_DICTIONARY_CACHE_BLOCK_SIZE & (AUTOCORRECT_DICTIONARY_CACHE_BLOCK_SIZE - 1)) == 0, "AUTOCORRECT_DICTIONARY_CACHE_BLOCK_SIZE must be a power of two");
+_Static_assert(AUTOCORRECT_DICTIONARY_CACHE_BLOCK_SIZE <= 32768, "AUTOCORRECT_DICTIONARY_CACHE_BLOCK_SIZE must be at most 32768");
+
+static autocorrect_cache_block_t autocorrect_cache[AUTOCORRECT_DICTIONARY_CACHE_BLOCKS];
+static autocorrect_cache_block_t *autocorrect_cache_last  = NULL;
+static uint16_t                   autocorrect_cache_clock = 0;
+
+static bool     autocorrect_dictionary_loaded = false;
+static uint8_t  autocorrect_dictionary_min    = UINT8_MAX;
+static uint32_t autocorrect_dictionary_size   = 0;
+static uint32_t autocorrect_dictionary_root   = 0;
+static char     autocorrect_changes[AUTOCORRECT_MAX_CORRECTION_LENGTH + 1];
+
+#    ifdef AUTOCORRECT_NVM_DICTIONARY_SIZE
+/* The NVM region holds two slots with a dictionary header each, followed by an
+ * area for the rest of the images. Each header records where its image starts in
+ * the area, so a full upload goes next to the live image rather than over it. A
+ * commit writes the header to the slot that is not live, so an interrupted update
+ * leaves the previous dictionary in place. */
+#        define AUTOCORRECT_NVM_SLOT_SIZE (AUTOCORRECT_DICTIONARY_HEADER_SIZE + 8)
+#        define AUTOCORRECT_NVM_AREA_OFFSET (2 * AUTOCORRECT_NVM_SLOT_SIZE)
+#        define AUTOCORRECT_NVM_AREA_SIZE ((uint32_t)(AUTOCORRECT_NVM_DICTIONARY_SIZE) - AUTOCORRECT_NVM_AREA_OFFSET)
+#        define AUTOCORRECT_NVM_CAPACITY (AUTOCORRECT_NVM_AREA_SIZE + AUTOCORRECT_DICTIONARY_HEADER_SIZE)
+
+typedef struct {
+    uint8_t header[AUTOCORRECT_DICTIONARY_HEADER_SIZE]; // generation in the reserved bytes 6-7
+    uint8_t base[4];                                    // where byte 16 of the image is in the area
+    uint8_t image_crc[2];
+    uint8_t slot_crc[2];
+} autocorrect_nvm_slot_t;
+
+_Static_assert(sizeof(autocorrect_nvm_slot_t) == AUTOCORRECT_NVM_SLOT_SIZE, "autocorrect_nvm_slot_t has an unexpected size");
+
+static autocorrect_nvm_slot_t autocorrect_nvm_live;
+static int8_t                 autocorrect_nvm_live_slot = -1;
+static bool                   autocorrect_nvm_loaded    = false;
+
+/* A full upload started with id_autocorrect_begin, written next to the live image */
+static bool     autocorrect_nvm_upload_full = false;
+static uint32_t autocorrect_nvm_upload_base = 0;
+static uint32_t autocorrect_nvm_upload_size = 0;
+
+static uint8_t  autocorrect_nvm_buffer[AUTOCORRECT_NVM_WRITE_BUFFER_SIZE];
+static uint32_t autocorrect_nvm_buffer_offset = 0;
+static uint16_t autocorrect_nvm_buffer_length = 0;
+
+static uint32_t autocorrect_get_u32_le(const uint8_t *data) {
+    return data[0] | (uint32_t)data[1] << 8 | (uint32_t)data[2] << 16 | (uint32_t)data[3] << 24;
+}
+
+static uint32_t autocorrect_get_u32_be(const uint8_t *data) {
+    return (uint32_t)data[0] << 24 | (uint32_t)data[1] << 16 | (uint32_t)data[2] << 8 | data[3];
+}
+
+static uint32_t autocorrect_nvm_live_size(void) {
+    // a removed dictionary is live, but has no magic
+    return memcmp(autocorrect_nvm_live.header, "ACD\x01", 4) != 0 ? 0 : autocorrect_get_u32_le(&autocorrect_nvm_live.header[8]);
+}
+
+static uint32_t autocorrect_nvm_live_base(void) {
+    return autocorrect_get_u32_le(autocorrect_nvm_live.base);
+}
+
+/* Area bytes past the live image, free for its patches */
+static uint32_t autocorrect_nvm_live_end(void) {
+    uint32_t size = autocorrect_nvm_live_size();
+    return autocorrect_nvm_live_base() + (size ? size - AUTOCORRECT_DICTIONARY_HEADER_SIZE : 0);
+}
+
+static uint16_t autocorrect_nvm_live_generation(void) {
+    return autocorrect_nvm_live.header[6] | autocorrect_nvm_live.header[7] << 8;
+}
+
+/* The largest full upload that fits next to the live image */
+static uint32_t autocorrect_nvm_upload_capacity(void) {
+    if (!autocorrect_nvm_live_size()) {
+        return AUTOCORRECT_NVM_CAPACITY;
+    }
+    return MAX(autocorrect_nvm_live_base(), AUTOCORRECT_NVM_AREA_SIZE - autocorrect_nvm_live_end()) + AUTOCORRECT_DICTIONARY_HEADER_SIZE;
+}
+
+static uint32_t autocorrect_nvm_offset(uint32_t base, uint32_t address) {
+    return AUTOCORRECT_NVM_AREA_OFFSET + base + address - AUTOCORRECT_DICTIONARY_HEADER_SIZE;
+}
+
+/* Picks the valid slot with the newest generation */
+static void autocorrect_nvm_load(void) {
+    if (autocorrect_nvm_loaded) {
+        return;
+    }
+    autocorrect_nvm_loaded    = true;
+    autocorrect_nvm_live_slot = -1;
+    memset(&autocorrect_nvm_live, 0, sizeof(autocorrect_nvm_live));
+
+    for (uint8_t i = 0; i < 2; ++i) {
+        autocorrect_nvm_slot_t slot;
+        if (nvm_autocorrect_read_dictionary(&slot, i * AUTOCORRECT_NVM_SLOT_SIZE, sizeof(slot)) != sizeof(slot)) {
+            continue;
+        }
+        uint16_t crc = crc16(&slot, offsetof(autocorrect_nvm_slot_t, slot_crc));
+        if (slot.slot_crc[0] != (crc & 0xFF) || slot.slot_crc[1] != (crc >> 8)) {
+            continue;
+        }
+        uint16_t generation = slot.header[6] | slot.header[7] << 8;
+        if (autocorrect_nvm_live_slot < 0 || (int16_t)(generation - autocorrect_nvm_live_generation()) > 0) {
+            autocorrect_nvm_live      = slot;
+            autocorrect_nvm_live_slot = i;
+        }
+    }
+}
+
+static void autocorrect_nvm_flush(void) {
+    if (autocorrect_nvm_buffer_length) {
+        nvm_autocorrect_update_dictionary(autocorrect_nvm_buffer, autocorrect_nvm_buffer_offset, autocorrect_nvm_buffer_length);
+        autocorrect_nvm_buffer_length = 0;
+    }
+}
+
+/* Collects consecutive writes, so the NVM layer sees blocks rather than single reports */
+static void autocorrect_nvm_write(uint32_t offset, const uint8_t *data, uint8_t length) {
+    if (autocorrect_nvm_buffer_length && offset != autocorrect_nvm_buffer_offset + autocorrect_nvm_buffer_length) {
+        autocorrect_nvm_flush();
+    }
+    while (length) {
+        if (!autocorrect_nvm_buffer_length) {
+            autocorrect_nvm_buffer_offset = offset;
+        }
+        uint16_t count = MIN(length, sizeof(autocorrect_nvm_buffer) - autocorrect_nvm_buffer_length);
+        memcpy(autocorrect_nvm_buffer + autocorrect_nvm_buffer_length, data, count);
+        autocorrect_nvm_buffer_length += count;
+        offset += count;
+        data += count;
+        length -= count;
+        if (autocorrect_nvm_buffer_length == sizeof(autocorrect_nvm_buffer)) {
+            autocorrect_nvm_flush();
+        }
+    }
+}
+
+/* Places a full upload of `size` bytes in the area at the start or the end, whichever side of
+ * the live image has room, so the next one can go on the other side once this one is live */
+static bool autocorrect_nvm_begin(uint32_t size) {
+    autocorrect_nvm_flush();
+    autocorrect_nvm_upload_full = false;
+    if (size <= AUTOCORRECT_DICTIONARY_HEADER_SIZE || size > AUTOCORRECT_NVM_CAPACITY) {
+        return false;
+    }
+
+    uint32_t length = size - AUTOCORRECT_DICTIONARY_HEADER_SIZE;
+    if (!autocorrect_nvm_live_size() || length <= autocorrect_nvm_live_base()) {
+        autocorrect_nvm_upload_base = 0;
+    } else if (autocorrect_nvm_live_end() + length <= AUTOCORRECT_NVM_AREA_SIZE) {
+        autocorrect_nvm_upload_base = AUTOCORRECT_NVM_AREA_SIZE - length;
+    } else {
+        return false;
+    }
+    autocorrect_nvm_upload_full = true;
+    autocorrect_nvm_upload_size = size;
+    return true;
+}
+
+/* Makes `slot` live in the slot that is not, then switches lookups over to it */
+static void autocorrect_nvm_swap(autocorrect_nvm_slot_t *slot) {
+    uint8_t  target     = autocorrect_nvm_live_slot == 0 ? 1 : 0;
+    uint16_t generation = autocorrect_nvm_live_generation() + 1;
+    slot->header[6]     = generation & 0xFF;
+    slot->header[7]     = generation >> 8;
+    uint16_t crc        = crc16(slot, offsetof(autocorrect_nvm_slot_t, slot_crc));
+    slot->slot_crc[0]   = crc & 0xFF;
+    slot->slot_crc[1]   = crc >> 8;
+    nvm_autocorrect_update_dictionary(slot, target * AUTOCORRECT_NVM_SLOT_SIZE, sizeof(*slot));
+
+    autocorrect_nvm_upload_full = false;
+    autocorrect_nvm_loaded      = false;
+    autocorrect_nvm_load();
+    autocorrect_dictionary_invalidate();
+}
+
+static bool autocorrect_nvm_commit(const uint8_t *command_data) {
+    autocorrect_nvm_flush();
+
+    uint32_t size = autocorrect_get_u32_be(&command_data[2]);
+    uint32_t root = autocorrect_get_u32_be(&command_data[6]);
+    uint16_t crc  = command_data[10] << 8 | command_data[11];
+    if (!size) {
+        // removes the dictionary
+        autocorrect_nvm_slot_t slot = {0};
+        autocorrect_nvm_swap(&slot);
+        return true;
+    }
+
+    uint32_t base  = autocorrect_nvm_upload_full ? autocorrect_nvm_upload_base : autocorrect_nvm_live_base();
+    uint32_t limit = autocorrect_nvm_upload_full ? autocorrect_nvm_upload_size : AUTOCORRECT_NVM_CAPACITY - base;
+    if (size <= AUTOCORRECT_DICTIONARY_HEADER_SIZE || size > limit || root < AUTOCORRECT_DICTIONARY_HEADER_SIZE || root >= size || !command_data[0] || command_data[1] > AUTOCORRECT_MAX_LENGTH) {
+        return false;
+    }
+
+    // the whole image must have arrived intact before it goes live
+    uint16_t image_crc = 0xFFFF;
+    for (uint32_t offset = AUTOCORRECT_DICTIONARY_HEADER_SIZE; offset < size;) {
+        uint8_t  chunk[32];
+        uint32_t count = nvm_autocorrect_read_dictionary(chunk, autocorrect_nvm_offset(base, offset), MIN(sizeof(chunk), size - offset));
+        if (!count) {
+            return false;
+        }
+        image_crc = crc16_update(image_crc, chunk, count);
+        offset += count;
+    }
+    if (image_crc != crc) {
+        dprintf("autocorrect: dictionary upload failed its check, keeping the live one\n");
+        return false;
+    }
+
+    autocorrect_nvm_slot_t slot = {
+        .header    = {'A', 'C', 'D', 0x01, command_data[0], command_data[1], 0, 0, size & 0xFF, (size >> 8) & 0xFF, (size >> 16) & 0xFF, size >> 24, root & 0xFF, (root >> 8) & 0xFF, (root >> 16) & 0xFF, root >> 24},
+        .base      = {base & 0xFF, (base >> 8) & 0xFF, (base >> 16) & 0xFF, base >> 24},
+        .image_crc = {crc & 0xFF, crc >> 8},
+    };
+    autocorrect_nvm_swap(&slot);
+    return true;
+}
+
+static uint8_t *autocorrect_put_u16(uint8_t *data, uint16_t value) {
+    *data++ = value >> 8;
+    *data++ = value & 0xFF;
+    return data;
+}
+
+static uint8_t *autocorrect_put_u32(uint8_t *data, uint32_t value) {
+    data = autocorrect_put_u16(data, value >> 16);
+    return autocorrect_put_u16(data, value & 0xFFFF);
+}
+
+bool autocorrect_raw_hid_receive(uint8_t *data, uint8_t length) {
+    // data = [ command_id, sub_command_id, args... ]
+    if (data[0] != AUTOCORRECT_RAW_HID_COMMAND_ID) {
+        return false;
+    }
+
+    autocorrect_nvm_load();
+    uint8_t *command_data = &data[2];
+    uint32_t offset       = autocorrect_get_u32_be(command_data);
+    uint8_t  count        = command_data[4];
+    switch (data[1]) {
+        case id_autocorrect_get_info: {
+            uint8_t *out = &command_data[2];
+            command_data[0] = AUTOCORRECT_PROTOCOL_VERSION;
+            command_data[1] = AUTOCORRECT_MAX_LENGTH;
+            out             = autocorrect_put_u32(out, AUTOCORRECT_NVM_CAPACITY);
+            out             = autocorrect_put_u32(out, autocorrect_nvm_live_size());
+            out             = autocorrect_put_u16(out, autocorrect_nvm_live_generation());
+            autocorrect_put_u32(out, autocorrect_nvm_upload_capacity());
+            break;
+        }
+        case id_autocorrect_read: {
+            if (count > length - 7 || offset + count > AUTOCORRECT_NVM_CAPACITY - autocorrect_nvm_live_base()) {
+                data[0] = 0xFF;
+                break;
+            }
+            autocorrect_nvm_flush();
+            if (!autocorrect_dictionary_read(offset, &command_data[5], count)) {
+                data[0] = 0xFF;
+            }
+            break;
+        }
+        case id_autocorrect_write: {
+            // The header is only written by a commit, and nodes of the live dictionary are never
+            // overwritten: a patch appends its nodes after them, a full upload goes next to them.
+            uint32_t first = AUTOCORRECT_DICTIONARY_HEADER_SIZE;
+            uint32_t limit = autocorrect_nvm_upload_size;
+            uint32_t base  = autocorrect_nvm_upload_base;
+            if (!autocorrect_nvm_upload_full) {
+                first = MAX(autocorrect_nvm_live_size(), AUTOCORRECT_DICTIONARY_HEADER_SIZE);
+                base  = autocorrect_nvm_live_base();
+                limit = AUTOCORRECT_NVM_CAPACITY - base;
+            }
+            if (count > length - 7 || offset < first || offset + count > limit) {
+                data[0] = 0xFF;
+                break;
+            }
+            autocorrect_nvm_write(autocorrect_nvm_offset(base, offset), &command_data[5], count);
+            break;
+        }
+        case id_autocorrect_commit: {
+            if (!autocorrect_nvm_commit(command_data)) {
+                data[0] = 0xFF;
+            }
+            break;
+        }
+        case id_autocorrect_begin: {
+            if (!autocorrect_nvm_begin(offset)) {
+                data[0] = 0xFF;
+            }
+            break;
+        }
+        default: {
+            // The sub-command is not known
+            // Return the unhandled state
+            data[0] = 0xFF;
+            break;
+        }
+    }
+    return true;
+}
+#    endif
+
+/**
+ * @brief Reads raw bytes of the packed dictionary, by default from external flash
+ *
+ * @param address offset from the start of the dictionary
+ * @param data buffer to read into
+ * @param length number of bytes to read
+ * @return true if the bytes were read
+ */
+__attribute__((weak)) bool autocorrect_dictionary_read(uint32_t address, uint8_t *data, uint16_t length) {
+#    if defined(AUTOCORRECT_NVM_DICTIONARY_SIZE)
+    autocorrect_nvm_load();
+    for (; length && address < AUTOCORRECT_DICTIONARY_HEADER_SIZE; --length) {
+        // the header comes from the live slot
+        *data++ = autocorrect_nvm_live.header[address++];
+    }
+    return nvm_autocorrect_read_dictionary(data, autocorrect_nvm_offset(autocorrect_nvm_live_base(), address), length) == length;
+#    elif defined(FLASH_ENABLE)
+    return flash_read_range(AUTOCORRECT_DICTIONARY_FLASH_ADDRESS + address, data, length) == FLASH_STATUS_SUCCESS;
+#    else
+    return false;
+#    endif
+}
+
+/**
+ * @brief Drops the node cache and reloads the dictionary header on the next lookup
+ *
+ */
+void autocorrect_dictionary_invalidate(void) {
+    autocorrect_dictionary_loaded = false;
+}
+
+static autocorrect_cache_block_t *autocorrect_cache_block(uint32_t address) {
+    uint32_t base = address & ~(uint32_t)(AUTOCORRECT_DICTIONARY_CACHE_BLOCK_SIZE - 1);
+    if (autocorrect_cache_last && autocorrect_cache_last->address == base) {
+        // consecutive reads mostly stay within one node
+        return autocorrect_cache_last;
+    }
+
+    autocorrect_cache_block_t *block = &autocorrect_cache[0];
+    for (uint8_t i = 0; i < AUTOCORRECT_DICTIONARY_CACHE_BLOCKS; ++i) {
+        if (autocorrect_cache[i].address == base) {
+            block = &autocorrect_cache[i];
+            break;
+        }
+        if ((uint16_t)(autocorrect_cache_clock - autocorrect_cache[i].used) > (uint16_t)(autocorrect_cache_clock - block->used)) {
+            // least recently used
+            block = &autocorrect_cache[i];
+        }
+    }
+    if (block->address != base) {
+        uint16_t length = MIN(AUTOCORRECT_DICTIONARY_CACHE_BLOCK_SIZE, autocorrect_dictionary_size - base);
+        block->address  = UINT32_MAX;
+        if (!autocorrect_dictionary_read(base, block->data, length)) {
+            return NULL;
+        }
+        block->address = base;
+    }
+    block->used            = ++autocorrect_cache_clock;
+    autocorrect_cache_last = block;
+    return block;
+}
+
+static bool autocorrect_dictionary_fetch(uint32_t address, uint8_t *data, uint16_t length) {
+    if (address + length > autocorrect_dictionary_size) {
+        // a link pointing outside of the dictionary, should not happen unless the data is corrupt
+        return false;
+    }
+    while (length) {
+        autocorrect_cache_block_t *block = autocorrect_cache_block(address);
+        if (!block) {
+            return false;
+        }
+        uint16_t offset = address - block->address;
+        uint16_t count  = MIN(length, AUTOCORRECT_DICTIONARY_CACHE_BLOCK_SIZE - offset);
+        memcpy(data, block->data + offset, count);
+        data += count;
+        address += count;
+        length -= count;
+    }
+    return true;
+}
+
+static bool autocorrect_dictionary_load(void) {
+    if (autocorrect_dictionary_loaded) {
+        return autocorrect_dictionary_min != UINT8_MAX;
+    }
+    autocorrect_dictionary_loaded = true;
+    autocorrect_dictionary_min    = UINT8_MAX;
+    autocorrect_cache_last        = NULL;
+    for (uint8_t i = 0; i < AUTOCORRECT_DICTIONARY_CACHE_BLOCKS; ++i) {
+        autocorrect_cache[i].address = UINT32_MAX;
+    }
+
+    uint8_t header[AUTOCORRECT_DICTIONARY_HEADER_SIZE];
+    if (!autocorrect_dictionary_read(0, header, sizeof(header)) || memcmp(header, "ACD\x01", 4) != 0) {
+        dprintf("autocorrect: no dictionary found\n");
+        return false;
+    }
+    if (header[5] > AUTOCORRECT_MAX_LENGTH) {
+        dprintf("autocorrect: dictionary has typos of %u characters, AUTOCORRECT_MAX_LENGTH is %u\n", header[5], AUTOCORRECT_MAX_LENGTH);
+        return false;
+    }
+    autocorrect_dictionary_size = header[8] | (uint32_t)header[9] << 8 | (uint32_t)header[10] << 16 | (uint32_t)header[11] << 24;
+    autocorrect_dictionary_root = header[12] | (uint32_t)header[13] << 8 | (uint32_t)header[14] << 16 | (uint32_t)header[15] << 24;
+    autocorrect_dictionary_min  = MAX(header[4], 1);
+    return true;
+}
+
+static uint8_t autocorrect_dictionary_min_length(void) {
+    autocorrect_dictionary_load();
+    return autocorrect_dictionary_min;
+}
+
+/**
+ * @brief Looks up the end of the typo buffer in the packed trie read through `autocorrect_dictionary_read`
+ *
+ * @param backspaces set to the number of characters to remove on a match
+ * @return the replacement string in RAM, or NULL if the buffer doesn't end in a typo
+ */
+static const char *autocorrect_find(uint8_t *backspaces) {
+    uint32_t state = autocorrect_dictionary_root;
+    int8_t   i     = typo_buffer_size - 1;
+    uint8_t  code;
+    uint8_t  link[3];
+
+    // Every node takes at least one key off the buffer, a corrupt image can't walk further than that
+    for (uint8_t steps = 0; steps <= typo_buffer_size && autocorrect_dictionary_fetch(state, &code, 1); ++steps) {
+        if (code & 128) { // A typo was found!
+            uint16_t length = 0;
+            *backspaces     = code & 63;
+            while (autocorrect_dictionary_fetch(++state, (uint8_t *)&autocorrect_changes[length], 1)) {
+                if (!autocorrect_changes[length]) {
+                    return autocorrect_changes;
+                }
+                if (++length > AUTOCORRECT_MAX_CORRECTION_LENGTH) {
+                    // typing part of a correction would be worse than leaving the typo
+                    dprintf("autocorrect: correction longer than AUTOCORRECT_MAX_CORRECTION_LENGTH (%u)\n", AUTOCORRECT_MAX_CORRECTION_LENGTH);
+                    return NULL;
+                }
+            }
+            return NULL;
+        }
+
+        uint8_t count = code & 63;
+        uint8_t key;
+        uint8_t j = 0;
+        if (!count) {
+            return NULL;
+        }
+        if (code & 64) { // Chain of single-child nodes, all keys must match.
+            for (; j < count; ++j) {
+                if (i < 0 || !autocorrect_dictionary_fetch(state + 1 + j, &key, 1) || key != typo_buffer[i--]) {
+                    return NULL;
+                }
+            }
+            j = 0;
+        } else { // Node with multiple children, keys are sorted.
+            if (i < 0) {
+                return NULL;
+            }
+            for (; j < count; ++j) {
+                if (!autocorrect_dictionary_fetch(state + 1 + j, &key, 1) || key > typo_buffer[i]) {
+                    return NULL;
+                }
+                if (key == typo_buffer[i]) {
+                    break;
+                }
+            }
+            if (j == count) {
+                return NULL;
+            }
+            --i;
+        }
+
+        // Follow link to child node.
+        if (!autocorrect_dictionary_fetch(state + 1 + count + 3 * j, link, sizeof(link))) {
+            return NULL;
+        }
+        state = link[0] | (uint32_t)link[1] << 8 | (uint32_t)link[2] << 16;
+    }
+    return NULL;
+}
+#else
+/**
+ * @brief Looks up the end of the typo buffer in the trie stored in `autocorrect_data`
+ *
+ * @param backspaces set to the number of characters to remove on a match
+ * @return the PROGMEM replacement string, or NULL if the buffer doesn't end in a typo
+ */
+static const char *autocorrect_find(uint8_t *backspaces) {
+    uint16_t state = 0;
+    uint8_t  code  = pgm_read_byte(autocorrect_data + state);
+    for (int8_t i = typo_buffer_size - 1; i >= 0; --i) {
+        uint8_t const key_i = typo_buffer[i];
+
+        if (code & 64) { // Check for match in node with multiple children.
+            code &= 63;
+            for (; code != key_i; code = pgm_read_byte(autocorrect_data + (state += 3))) {
+                if (!code) return NULL;
+            }
+            // Follow link to child node.
+            state = (pgm_read_byte(autocorrect_data + state + 1) | pgm_read_byte(autocorrect_data + state + 2) << 8);
+            // Check for match in node with single child.
+        } else if (code != key_i) {
+            return NULL;
+        } else if (!(code = pgm_read_byte(autocorrect_data + (++state)))) {
+            ++state;
+        }
+
+        // Stop if `state` becomes an invalid index. This should not normally
+        // happen, it is a safeguard in case of a bug, data corruption, etc.
+        if (state >= DICTIONARY_SIZE) {
+            return NULL;
+        }
+
+        code = pgm_read_byte(autocorrect_data + state);
+
+        if (code & 128) { // A typo was found!
+            *backspaces = code & 63;
+            return (const char *)(autocorrect_data + state + 1);
+        }
+    }
+    return NULL;
+}
+#endif
+
 /**
  * @brief function for querying the enabled state of autocorrect
  *
@@ -280,96 +832,81 @@ bool process_autocorrect(uint16_t keycode, keyrecord_t *record) {
     }
 
     // Check for typo in buffer using a trie stored in `autocorrect_data`.
-    uint16_t state = 0;
-    uint8_t  code  = pgm_read_byte(autocorrect_data + state);
-    for (int8_t i = typo_buffer_size - 1; i >= 0; --i) {
-        uint8_t const key_i = typo_buffer[i];
-
-        if (code & 64) { // Check for match in node with multiple children.
-            code &= 63;
-            for (; code != key_i; code = pgm_read_byte(autocorrect_data + (state += 3))) {
-                if (!code) return true;
+    uint8_t     backspaces;
+    const char *changes = autocorrect_find(&backspaces);
+    if (changes) { // A typo was found! Apply autocorrect.
+        backspaces += !record->event.pressed;
+
+        /* Gather info about the typo'd word
+         *
+         * Since buffer may contain several words, delimited by spaces, we
+         * iterate from the end to find the start and length of the typo
+         */
+        char typo[AUTOCORRECT_MAX_LENGTH + 1] = {0}; // extra char for null terminator
+
+        uint8_t typo_len   = 0;
+        uint8_t typo_start = 0;
+        bool    space_last = typo_buffer[typo_buffer_size - 1] == KC_SPC;
+        for (uint8_t i = typo_buffer_size; i > 0; --i) {
+            // stop counting after finding space (unless it is the last thing)
+            if (typo_buffer[i - 1] == KC_SPC && i != typo_buffer_size) {
+                typo_start = i;
+                break;
             }
-            // Follow link to child node.
-            state = (pgm_read_byte(autocorrect_data + state + 1) | pgm_read_byte(autocorrect_data + state + 2) << 8);
-            // Check for match in node with single child.
-        } else if (code != key_i) {
-            return true;
-        } else if (!(code = pgm_read_byte(autocorrect_data + (++state)))) {
-            ++state;
-        }
 
-        // Stop if `state` becomes an invalid index. This should not normally
-        // happen, it is a safeguard in case of a bug, data corruption, etc.
-        if (state >= DICTIONARY_SIZE) {
-            return true;
+            ++typo_len;
         }
 
-        code = pgm_read_byte(autocorrect_data + state);
-
-        if (code & 128) { // A typo was found! Apply autocorrect.
-            const uint8_t backspaces = (code & 63) + !record->event.pressed;
-            const char   *changes    = (const char *)(autocorrect_data + state + 1);
-
-            /* Gather info about the typo'd word
-             *
-             * Since buffer may contain several words, delimited by spaces, we
-             * iterate from the end to find the start and length of the typo
-             */
-            char typo[AUTOCORRECT_MAX_LENGTH + 1] = {0}; // extra char for null terminator
-
-            uint8_t typo_len   = 0;
-            uint8_t typo_start = 0;
-            bool    space_last = typo_buffer[typo_buffer_size - 1] == KC_SPC;
-            for (uint8_t i = typo_buffer_size; i > 0; --i) {
-                // stop counting after finding space (unless it is the last thing)
-                if (typo_buffer[i - 1] == KC_SPC && i != typo_buffer_size) {
-                    typo_start = i;
-                    break;
-                }
+        // when detecting 'typo:', reduce the length of the string by one
+        if (space_last) {
+            --typo_len;
+        }
 
-                ++typo_len;
-            }
+        // convert buffer of keycodes into a string
+        for (uint8_t i = 0; i < typo_len; ++i) {
+            typo[i] = typo_buffer[typo_start + i] - KC_A + 'a';
+        }
 
-            // when detecting 'typo:', reduce the length of the string by one
-            if (space_last) {
-                --typo_len;
-            }
+        /* Gather the corrected word
+         *
+         * A) Correction of 'typo:' -- Code takes into account
+         * an extra backspace to delete the space (which we dont copy)
+         * for this reason the offset is correct to "skip" the null terminator
+         *
+         * B) When correcting 'typo' -- Need extra offset for terminator
+         */
+#ifdef AUTOCORRECT_EXTERNAL_DICTIONARY
+        char correct[AUTOCORRECT_MAX_LENGTH + sizeof(autocorrect_changes)] = {0};
+#else
+        char correct[AUTOCORRECT_MAX_LENGTH + 10] = {0}; // let's hope this is big enough
+#endif
 
-            // convert buffer of keycodes into a string
-            for (uint8_t i = 0; i < typo_len; ++i) {
-                typo[i] = typo_buffer[typo_start + i] - KC_A + 'a';
-            }
+        uint8_t offset = space_last ? backspaces : backspaces + 1;
+        strcpy(correct, typo);
+#ifdef AUTOCORRECT_EXTERNAL_DICTIONARY
+        strcpy(correct + typo_len - offset, changes);
+#else
+        strcpy_P(correct + typo_len - offset, changes);
+#endif
 
-            /* Gather the corrected word
-             *
-             * A) Correction of 'typo:' -- Code takes into account
-             * an extra backspace to delete the space (which we dont copy)
-             * for this reason the offset is correct to "skip" the null terminator
-             *
-             * B) When correcting 'typo' -- Need extra offset for terminator
-             */
-            char correct[AUTOCORRECT_MAX_LENGTH + 10] = {0}; // let's hope this is big enough
-
-            uint8_t offset = space_last ? backspaces : backspaces + 1;
-            strcpy(correct, typo);
-            strcpy_P(correct + typo_len - offset, changes);
-
-            if (apply_autocorrect(backspaces, changes, typo, correct)) {
-                for (uint8_t i = 0; i < backspaces; ++i) {
-                    tap_code(KC_BSPC);
-                }
-                send_string_P(changes);
+        if (apply_autocorrect(backspaces, changes, typo, correct)) {
+            for (uint8_t i = 0; i < backspaces; ++i) {
+                tap_code(KC_BSPC);
             }
+#ifdef AUTOCORRECT_EXTERNAL_DICTIONARY
+            send_string(changes);
+#else
+            send_string_P(changes);
+#endif
+        }
 
-            if (keycode == KC_SPC) {
-                typo_buffer[0]   = KC_SPC;
-                typo_buffer_size = 1;
-                return true;
-            } else {
-                typo_buffer_size = 0;
-                return false;
-            }
+        if (keycode == KC_SPC) {
+            typo_buffer[0]   = KC_SPC;
+            typo_buffer_size = 1;
+            return true;
+        } else {
+            typo_buffer_size = 0;
+            return false;
         }
     }
     return true;
@@ -10,6 +10,28 @@
 #include <stdbool.h>
 #include "action.h"
 
+#if defined(AUTOCORRECT_NVM_DICTIONARY_SIZE) && !defined(AUTOCORRECT_EXTERNAL_DICTIONARY)
+#    define AUTOCORRECT_EXTERNAL_DICTIONARY
+#endif
+
+#ifdef AUTOCORRECT_EXTERNAL_DICTIONARY
+#    ifndef AUTOCORRECT_MAX_LENGTH
+#        define AUTOCORRECT_MAX_LENGTH 32
+#    endif
+#    ifndef AUTOCORRECT_MAX_CORRECTION_LENGTH
+#        define AUTOCORRECT_MAX_CORRECTION_LENGTH 32
+#    endif
+#    ifndef AUTOCORRECT_DICTIONARY_FLASH_ADDRESS
+#        define AUTOCORRECT_DICTIONARY_FLASH_ADDRESS 0
+#    endif
+#    ifndef AUTOCORRECT_DICTIONARY_CACHE_BLOCKS
+#        define AUTOCORRECT_DICTIONARY_CACHE_BLOCKS 8
+#    endif
+#    ifndef AUTOCORRECT_DICTIONARY_CACHE_BLOCK_SIZE
+#        define AUTOCORRECT_DICTIONARY_CACHE_BLOCK_SIZE 32
+#    endif
+#endif
+
 bool process_autocorrect(uint16_t keycode, keyrecord_t *record);
 bool process_autocorrect_user(uint16_t *keycode, keyrecord_t *record, uint8_t *typo_buffer_size, uint8_t *mods);
 bool process_autocorrect_default_handler(uint16_t *keycode, keyrecord_t *record, uint8_t *typo_buffer_size, uint8_t *mods);
@@ -19,3 +41,32 @@ bool autocorrect_is_enabled(void);
 void autocorrect_enable(void);
 void autocorrect_disable(void);
 void autocorrect_toggle(void);
+
+#ifdef AUTOCORRECT_EXTERNAL_DICTIONARY
+bool autocorrect_dictionary_read(uint32_t address, uint8_t *data, uint16_t length);
+void autocorrect_dictionary_invalidate(void);
+#endif
+
+#ifdef AUTOCORRECT_NVM_DICTIONARY_SIZE
+/**
+ * @brief Raw HID sub-commands, sent as `[ AUTOCORRECT_RAW_HID_COMMAND_ID, sub-command, ... ]`.
+ */
+enum autocorrect_command_id {
+    id_autocorrect_get_info = 0x01, // -> [ version, max length, capacity:4, size:4, generation:2, upload capacity:4 ]
+    id_autocorrect_read     = 0x02, // [ offset:4, count ] -> [ offset:4, count, bytes... ]
+    id_autocorrect_write    = 0x03, // [ offset:4, count, bytes... ]
+    id_autocorrect_commit   = 0x04, // [ min length, max length, size:4, root:4, crc:2 ], size 0 removes the dictionary
+    id_autocorrect_begin    = 0x05, // [ size:4 ], the following writes are a full upload of that size
+};
+
+#    ifndef AUTOCORRECT_RAW_HID_COMMAND_ID
+#        define AUTOCORRECT_RAW_HID_COMMAND_ID 0xFC
+#    endif
+#    ifndef AUTOCORRECT_NVM_WRITE_BUFFER_SIZE
+#        define AUTOCORRECT_NVM_WRITE_BUFFER_SIZE 256
+#    endif
+
+#    define AUTOCORRECT_PROTOCOL_VERSION 0x02
+
+bool autocorrect_raw_hid_receive(uint8_t *data, uint8_t length);
+#endif
@@ -0,0 +1,321 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "process_chord.h"
+#include "action_tapping.h"
+#include "action_util.h"
+#include "bitwise.h"
+#include "debug.h"
+#include "keyboard.h"
+#include "keymap_introspection.h"
+#include "progmem.h"
+#include "timer.h"
+#include "util.h"
+
+#ifdef COMBO_MUST_HOLD_PER_COMBO
+__attribute__((weak)) bool get_chord_must_hold(uint16_t chord_index, uint16_t keycode) {
+    return false;
+}
+#endif
+
+typedef struct {
+    keyrecord_t  record;
+    chord_keys_t key;
+} chord_queued_record_t;
+
+/* Chord key presses since the last resolution, replayed as plain keys unless they form a chord */
+static chord_queued_record_t chord_key_buffer[CHORD_KEY_BUFFER_LENGTH];
+static uint8_t               chord_key_buffer_size = 0;
+static chord_keys_t          chord_buffered        = 0;
+static uint16_t              chord_pending         = CHORD_NOT_FOUND; // longest chord over chord_buffered
+static uint16_t              chord_timer           = 0;
+
+typedef struct {
+    chord_keys_t held; // keys of the chord that are still down, the chord is released with the last one
+    uint16_t     keycode;
+} chord_active_t;
+static chord_active_t chord_active[CHORD_ACTIVE_LENGTH];
+
+static uint16_t chord_table_count  = 0;
+static bool     chord_table_valid  = false;
+static bool     chord_table_sorted = false;
+
+typedef struct {
+    uint16_t keycode;
+    uint8_t  index;
+} chord_key_entry_t;
+
+/* The chord keys sorted by keycode and then bit index, built along with the table check */
+static chord_key_entry_t chord_key_entries[CHORD_MAX_KEYS];
+static uint8_t           chord_key_entry_count = 0;
+
+static uint16_t chord_best_index;
+static uint8_t  chord_best_size;
+
+static inline chord_keys_t chord_keys_at(uint16_t chord_index) {
+    return pgm_read_dword(&chord_get(chord_index)->keys);
+}
+
+static inline uint16_t chord_keycode_at(uint16_t chord_index) {
+    return pgm_read_word(&chord_get(chord_index)->keycode);
+}
+
+void chord_table_invalidate(void) {
+    chord_table_valid = false;
+}
+
+static void chord_table_check(void) {
+    chord_table_count  = chord_count();
+    chord_table_sorted = true;
+    for (uint16_t i = 1; i < chord_table_count; ++i) {
+        if (chord_keys_at(i - 1) >= chord_keys_at(i)) {
+            // fall back to a linear search, said once per table check rather than on every key press
+            dprintf("chord: table is not sorted at %u, falling back to a linear search\n", i);
+            chord_table_sorted = false;
+            break;
+        }
+    }
+
+    chord_key_entry_count = MIN(chord_key_count(), CHORD_MAX_KEYS);
+    for (uint8_t i = 0; i < chord_key_entry_count; ++i) {
+        chord_key_entry_t entry = {.keycode = chord_key_get(i), .index = i};
+        uint8_t           j     = i;
+        for (; j > 0 && chord_key_entries[j - 1].keycode > entry.keycode; --j) {
+            chord_key_entries[j] = chord_key_entries[j - 1];
+        }
+        chord_key_entries[j] = entry;
+    }
+    chord_table_valid = true;
+}
+
+static void chord_table_refresh(void) {
+    if (!chord_table_valid || chord_table_count != chord_count() || chord_key_entry_count != MIN(chord_key_count(), CHORD_MAX_KEYS)) {
+        chord_table_check();
+    }
+}
+
+int8_t chord_key_index(uint16_t keycode) {
+    chord_table_refresh();
+
+    uint8_t low = 0, high = chord_key_entry_count;
+    while (low < high) {
+        uint8_t mid = low + (high - low) / 2;
+        if (chord_key_entries[mid].keycode < keycode) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    if (low < chord_key_entry_count && chord_key_entries[low].keycode == keycode) {
+        return chord_key_entries[low].index;
+    }
+    return -1;
+}
+
+static uint16_t chord_lower_bound(chord_keys_t keys) {
+    uint16_t low = 0, high = chord_table_count;
+    while (low < high) {
+        uint16_t mid = low + (high - low) / 2;
+        if (chord_keys_at(mid) < keys) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+/* Walks the binary trie over the pressed keys, highest key first, that the sorted table forms
+ * implicitly: every chord that agrees with `prefix` on the keys decided so far lies in
+ * [prefix, prefix | lower keys], so a subtree without chords costs a single binary search. */
+static void chord_walk(chord_keys_t prefix, chord_keys_t undecided, uint8_t size) {
+    if (size + bitpop32(undecided) <= chord_best_size) {
+        // nothing below can beat the best match
+        return;
+    }
+
+    chord_keys_t lower = undecided ? (CHORD_KEY(biton32(undecided)) << 1) - 1 : 0;
+    uint16_t     first = chord_lower_bound(prefix);
+    if (first >= chord_table_count) {
+        return;
+    }
+    chord_keys_t keys = chord_keys_at(first);
+    if (keys > (prefix | lower)) {
+        return;
+    }
+    if (keys == prefix && size > chord_best_size) {
+        chord_best_index = first;
+        chord_best_size  = size;
+    }
+    if (!undecided) {
+        return;
+    }
+
+    chord_keys_t key = CHORD_KEY(biton32(undecided));
+    chord_walk(prefix | key, undecided & ~key, size + 1);
+    chord_walk(prefix, undecided & ~key, size);
+}
+
+uint16_t chord_find_longest(chord_keys_t pressed) {
+    chord_table_refresh();
+
+    chord_best_index = CHORD_NOT_FOUND;
+    chord_best_size  = 0;
+
+    if (chord_table_sorted) {
+        chord_walk(0, pressed, 0);
+    } else {
+        for (uint16_t i = 0; i < chord_table_count; ++i) {
+            chord_keys_t keys = chord_keys_at(i);
+            uint8_t      size = bitpop32(keys);
+            if (keys && !(keys & ~pressed) && size > chord_best_size) {
+                chord_best_index = i;
+                chord_best_size  = size;
+            }
+        }
+    }
+    return chord_best_index;
+}
+
+static bool chord_must_hold(uint16_t chord_index, uint16_t keycode) {
+#if defined(COMBO_MUST_HOLD_PER_COMBO)
+    return get_chord_must_hold(chord_index, keycode);
+#elif defined(COMBO_MUST_HOLD_MODS)
+    return KEYCODE_IS_MOD(keycode) || IS_QK_MOMENTARY(keycode);
+#else
+    return false;
+#endif
+}
+
+static void chord_send(keyrecord_t *record) {
+#ifndef NO_ACTION_TAPPING
+    action_tapping_process(*record);
+#else
+    process_record(record);
+#endif
+}
+
+static void chord_send_keycode(uint16_t keycode, bool pressed) {
+    keyrecord_t record = {
+        .event   = MAKE_COMBOEVENT(pressed),
+        .keycode = keycode,
+    };
+    chord_send(&record);
+}
+
+/* Fire the longest chord over the buffered keys and replay the others, in the order they were pressed */
+static void chord_resolve(bool released_early) {
+    chord_keys_t    keys    = 0;
+    uint16_t        keycode = KC_NO;
+    chord_active_t *active  = NULL;
+
+    if (chord_pending != CHORD_NOT_FOUND) {
+        keys    = chord_keys_at(chord_pending);
+        keycode = chord_keycode_at(chord_pending);
+        if (released_early && chord_must_hold(chord_pending, keycode)) {
+            // not tappable, the keys act on their own
+            keys = 0;
+        }
+    }
+    for (uint8_t i = 0; keys && i < CHORD_ACTIVE_LENGTH && !active; ++i) {
+        if (!chord_active[i].held) {
+            active = &chord_active[i];
+        }
+    }
+    if (!active) {
+        keys = 0;
+    } else {
+        *active = (chord_active_t){.held = keys, .keycode = keycode};
+    }
+
+    uint8_t      size      = chord_key_buffer_size;
+    chord_keys_t remaining = keys;
+    chord_key_buffer_size  = 0;
+    chord_buffered         = 0;
+    chord_pending          = CHORD_NOT_FOUND;
+    chord_timer            = 0;
+
+    for (uint8_t i = 0; i < size; ++i) {
+        chord_queued_record_t *queued = &chord_key_buffer[i];
+        if (queued->key & remaining) {
+            remaining &= ~queued->key;
+            if (!remaining) {
+                chord_send_keycode(keycode, true);
+            }
+        } else {
+            chord_send(&queued->record);
+        }
+        clear_weak_mods();
+    }
+}
+
+static bool chord_release_key(chord_keys_t key) {
+    for (uint8_t i = 0; i < CHORD_ACTIVE_LENGTH; ++i) {
+        chord_active_t *active = &chord_active[i];
+        if (active->held & key) {
+            active->held &= ~key;
+            if (!active->held) {
+                chord_send_keycode(active->keycode, false);
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+bool process_chord(uint16_t keycode, keyrecord_t *record) {
+    if (!IS_KEYEVENT(record->event)) {
+        return true;
+    }
+
+    int8_t index = chord_key_index(keycode);
+    if (index < 0) {
+        if (chord_key_buffer_size) {
+            // another key interrupts the chord, resolve it with what is pressed so far
+            chord_resolve(false);
+        }
+        return true;
+    }
+
+    chord_keys_t key = CHORD_KEY(index);
+    if (!record->event.pressed) {
+        if (chord_buffered & key) {
+            // first release before the chord term, the chord is tapped
+            chord_resolve(true);
+        }
+        return !chord_release_key(key);
+    }
+
+    if ((chord_buffered & key) || chord_key_buffer_size >= CHORD_KEY_BUFFER_LENGTH) {
+        chord_resolve(false);
+    }
+
+#ifdef COMBO_STRICT_TIMER
+    if (!chord_key_buffer_size) {
+        chord_timer = timer_read();
+    }
+#else
+    chord_timer = timer_read();
+#endif
+    chord_key_buffer[chord_key_buffer_size++] = (chord_queued_record_t){
+        .record = *record,
+        .key    = key,
+    };
+    chord_buffered |= key;
+    chord_pending = chord_find_longest(chord_buffered);
+    return false;
+}
+
+void chord_task(void) {
+    if (!chord_key_buffer_size) {
+        return;
+    }
+
+    uint16_t term = COMBO_TERM;
+    if (chord_pending != CHORD_NOT_FOUND && chord_must_hold(chord_pending, chord_keycode_at(chord_pending))) {
+        term = MAX(term, COMBO_HOLD_TERM);
+    }
+    if (timer_elapsed(chord_timer) > term) {
+        chord_resolve(false);
+    }
+}
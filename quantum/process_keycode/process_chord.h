@@ -0,0 +1,73 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "action.h"
+#include "keycodes.h"
+#include "process_combo.h"
+
+/**
+ * \file
+ *
+ * \defgroup chord Chords
+ *
+ * Combos for keymaps with hundreds or thousands of them. Each chord is a bitmask over a small set of
+ * chord keys, kept in a table sorted by that mask, so resolving the pressed keys costs a walk over the
+ * pressed keys with a binary search per step instead of a visit to every chord.
+ * \{
+ */
+
+typedef uint32_t chord_keys_t;
+
+/** The bit of the chord key at `index` in `chord_keys`. */
+#define CHORD_KEY(index) ((chord_keys_t)1 << (index))
+
+#define CHORD_MAX_KEYS (sizeof(chord_keys_t) * 8)
+
+typedef struct chord_t {
+    /** Set of `CHORD_KEY()` bits, the table must be sorted by this, ascending. */
+    chord_keys_t keys;
+    uint16_t     keycode;
+} chord_t;
+
+#define CHORD(ck, ca) {.keys = (ck), .keycode = (ca)}
+
+// Number of chord key presses kept while waiting for the chord to resolve
+#ifndef CHORD_KEY_BUFFER_LENGTH
+#    define CHORD_KEY_BUFFER_LENGTH 16
+#endif
+// Number of chords that can be held down at the same time
+#ifndef CHORD_ACTIVE_LENGTH
+#    define CHORD_ACTIVE_LENGTH 4
+#endif
+
+#define CHORD_NOT_FOUND UINT16_MAX
+
+bool process_chord(uint16_t keycode, keyrecord_t *record);
+void chord_task(void);
+
+/**
+ * \brief The bit index of `keycode` in `chord_keys`, or -1 if it is not a chord key.
+ */
+int8_t chord_key_index(uint16_t keycode);
+
+/**
+ * \brief Find the chord with the most keys that only uses keys of `pressed`.
+ *
+ * \return The chord index, or `CHORD_NOT_FOUND`.
+ */
+uint16_t chord_find_longest(chord_keys_t pressed);
+
+/**
+ * \brief Re-check the chord table and keys, call after `chord_get()` or `chord_key_get()` start returning something else.
+ */
+void chord_table_invalidate(void);
+
+#ifdef COMBO_MUST_HOLD_PER_COMBO
+bool get_chord_must_hold(uint16_t chord_index, uint16_t keycode);
+#endif
+
+/** \} */
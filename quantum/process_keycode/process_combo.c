@@ -16,6 +16,7 @@
 
 #include "process_combo.h"
 #include <stddef.h>
+#include <stdlib.h>
 #include "process_auto_shift.h"
 #include "caps_word.h"
 #include "timer.h"
@@ -23,6 +24,7 @@
 #include "keyboard.h"
 #include "keymap_common.h"
 #include "action_layer.h"
+#include "debug.h"
 #include "action_tapping.h"
 #include "action_util.h"
 #include "keymap_introspection.h"
@@ -102,6 +104,91 @@ static queued_combo_t combo_buffer[COMBO_BUFFER_LENGTH];
 
 #define INCREMENT_MOD(i) i = (i + 1) % COMBO_BUFFER_LENGTH
 
+#ifdef COMBO_KEYCODE_INDEX
+/* combo_keycode_index holds every (keycode, combo) pair, sorted by keycode and
+ * then combo index, so a key event visits only its own combos, in the same order
+ * as a scan of all combos. Built on first use and whenever the number of combos
+ * changes; it fits all the combos of the keymap unless COMBO_KEYCODE_INDEX_SIZE
+ * is set lower, or combo_get() adds combos at runtime, in which case process_combo
+ * falls back to scanning all combos. */
+static uint16_t combo_keycode_index_length      = 0;
+static uint16_t combo_keycode_index_combo_count = 0;
+static bool     combo_keycode_index_valid       = false;
+static bool     combo_keycode_index_overflow    = false;
+
+/* Keycodes processed since the last clear_combos, only their combos can have state to reset. */
+static uint16_t combo_touched_keycodes[COMBO_KEY_BUFFER_LENGTH];
+static uint8_t  combo_touched_count    = 0;
+static bool     combo_touched_overflow = false;
+
+void combo_keycode_index_invalidate(void) {
+    combo_keycode_index_valid = false;
+}
+
+static int combo_keycode_index_compare(const void *a, const void *b) {
+    const combo_keycode_index_entry_t *entry_a = a;
+    const combo_keycode_index_entry_t *entry_b = b;
+
+    if (entry_a->keycode != entry_b->keycode) {
+        return entry_a->keycode < entry_b->keycode ? -1 : 1;
+    }
+    return (int)entry_a->combo_index - (int)entry_b->combo_index;
+}
+
+static void combo_keycode_index_build(void) {
+    combo_keycode_index_length      = 0;
+    combo_keycode_index_overflow    = false;
+    combo_keycode_index_combo_count = combo_count();
+
+    for (uint16_t idx = 0; idx < combo_keycode_index_combo_count && !combo_keycode_index_overflow; ++idx) {
+        const uint16_t *keys = combo_get(idx)->keys;
+        uint16_t        key;
+        for (uint8_t i = 0; (key = pgm_read_word(&keys[i])) != COMBO_END; ++i) {
+            if (combo_keycode_index_length >= combo_keycode_index_size) {
+                dprintf("combo: keycode index full at %u keys, scanning all combos\n", combo_keycode_index_size);
+                combo_keycode_index_overflow = true;
+                break;
+            }
+            combo_keycode_index[combo_keycode_index_length++] = (combo_keycode_index_entry_t){
+                .keycode     = key,
+                .combo_index = idx,
+            };
+        }
+    }
+
+    qsort(combo_keycode_index, combo_keycode_index_length, sizeof(combo_keycode_index_entry_t), combo_keycode_index_compare);
+    combo_keycode_index_valid = true;
+    // combos touched before the rebuild may have moved, reset all of them next time
+    combo_touched_overflow = true;
+}
+
+static uint16_t combo_keycode_index_lower_bound(uint16_t keycode) {
+    uint16_t low = 0, high = combo_keycode_index_length;
+    while (low < high) {
+        uint16_t mid = low + (high - low) / 2;
+        if (combo_keycode_index[mid].keycode < keycode) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+static void combo_touch_keycode(uint16_t keycode) {
+    for (uint8_t i = 0; i < combo_touched_count; ++i) {
+        if (combo_touched_keycodes[i] == keycode) {
+            return;
+        }
+    }
+    if (combo_touched_count < COMBO_KEY_BUFFER_LENGTH) {
+        combo_touched_keycodes[combo_touched_count++] = keycode;
+    } else {
+        combo_touched_overflow = true;
+    }
+}
+#endif
+
 #ifndef EXTRA_SHORT_COMBOS
 /* flags are their own elements in combo_t struct. */
 #    define COMBO_ACTIVE(combo) (combo->active)
@@ -202,6 +289,23 @@ static inline uint16_t _get_combo_term(uint16_t combo_index, combo_t *combo) {
 void clear_combos(void) {
     uint16_t index = 0;
     longest_term   = 0;
+#ifdef COMBO_KEYCODE_INDEX
+    if (combo_keycode_index_valid && !combo_keycode_index_overflow && !combo_touched_overflow) {
+        for (uint8_t i = 0; i < combo_touched_count; ++i) {
+            uint16_t keycode = combo_touched_keycodes[i];
+            for (uint16_t j = combo_keycode_index_lower_bound(keycode); j < combo_keycode_index_length && combo_keycode_index[j].keycode == keycode; ++j) {
+                combo_t *combo = combo_get(combo_keycode_index[j].combo_index);
+                if (!COMBO_ACTIVE(combo)) {
+                    RESET_COMBO_STATE(combo);
+                }
+            }
+        }
+        combo_touched_count = 0;
+        return;
+    }
+    combo_touched_count    = 0;
+    combo_touched_overflow = false;
+#endif
     for (index = 0; index < combo_count(); ++index) {
         combo_t *combo = combo_get(index);
         if (!COMBO_ACTIVE(combo)) {
@@ -585,10 +689,34 @@ bool process_combo(uint16_t keycode, keyrecord_t *record) {
     }
 #endif
 
-    for (uint16_t idx = 0; idx < combo_count(); ++idx) {
-        combo_t *combo = combo_get(idx);
-        is_combo_key |= process_single_combo(combo, keycode, record, idx);
-        no_combo_keys_pressed = no_combo_keys_pressed && (NO_COMBO_KEYS_ARE_DOWN || COMBO_ACTIVE(combo) || COMBO_DISABLED(combo));
+#ifdef COMBO_KEYCODE_INDEX
+    if (!combo_keycode_index_valid || combo_keycode_index_combo_count != combo_count()) {
+        combo_keycode_index_build();
+    }
+
+    if (!combo_keycode_index_overflow) {
+        uint16_t previous_idx = -1;
+        uint16_t first        = combo_keycode_index_lower_bound(keycode);
+        if (first < combo_keycode_index_length && combo_keycode_index[first].keycode == keycode) {
+            combo_touch_keycode(keycode);
+        }
+        for (uint16_t i = first; i < combo_keycode_index_length && combo_keycode_index[i].keycode == keycode; ++i) {
+            uint16_t idx = combo_keycode_index[i].combo_index;
+            if (idx == previous_idx) {
+                // keycode listed twice in the same combo
+                continue;
+            }
+            previous_idx = idx;
+            is_combo_key |= process_single_combo(combo_get(idx), keycode, record, idx);
+        }
+    } else
+#endif
+    {
+        for (uint16_t idx = 0; idx < combo_count(); ++idx) {
+            combo_t *combo = combo_get(idx);
+            is_combo_key |= process_single_combo(combo, keycode, record, idx);
+            no_combo_keys_pressed = no_combo_keys_pressed && (NO_COMBO_KEYS_ARE_DOWN || COMBO_ACTIVE(combo) || COMBO_DISABLED(combo));
+        }
     }
 
     if (record->event.pressed && is_combo_key) {
@@ -79,3 +79,16 @@ void combo_enable(void);
 void combo_disable(void);
 void combo_toggle(void);
 bool is_combo_enabled(void);
+
+#ifdef COMBO_KEYCODE_INDEX
+typedef struct {
+    uint16_t keycode;
+    uint16_t combo_index;
+} combo_keycode_index_entry_t;
+
+/* Storage of the index, defined with the keymap so it can be sized from the number of combos */
+extern combo_keycode_index_entry_t combo_keycode_index[];
+extern const uint16_t              combo_keycode_index_size;
+
+void combo_keycode_index_invalidate(void);
+#endif
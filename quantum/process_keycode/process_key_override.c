@@ -16,6 +16,7 @@
  */
 
 #include "process_key_override.h"
+#include <stdlib.h>
 #include "report.h"
 #include "timer.h"
 #include "debug.h"
@@ -88,6 +89,21 @@ static bool enabled = true;
 // Forward decls
 static const key_override_t *clear_active_override(const bool allow_reregister);
 
+#ifdef KEY_OVERRIDE_TRIGGER_INDEX
+typedef struct {
+    uint16_t trigger;
+    uint16_t override_index;
+} key_override_trigger_index_entry_t;
+
+// Every override, sorted by trigger and then table index. Overrides with a KC_NO trigger, which activate on modifiers alone, sort first.
+// Built on first use and whenever the number of overrides changes; if there are more overrides than fit, every override is checked as before.
+static key_override_trigger_index_entry_t key_override_trigger_index[KEY_OVERRIDE_TRIGGER_INDEX_SIZE];
+static uint16_t                           key_override_trigger_index_length         = 0;
+static uint16_t                           key_override_trigger_index_override_count = 0;
+static bool                               key_override_trigger_index_valid          = false;
+static bool                               key_override_trigger_index_overflow       = false;
+#endif
+
 void key_override_on(void) {
     enabled = true;
     key_override_printf("Key override ON\n");
@@ -244,13 +260,119 @@ static bool check_activation_event(const key_override_t *override, const bool ke
     }
 }
 
+#ifdef KEY_OVERRIDE_TRIGGER_INDEX
+void key_override_trigger_index_invalidate(void) {
+    key_override_trigger_index_valid = false;
+}
+
+static int key_override_trigger_index_compare(const void *a, const void *b) {
+    const key_override_trigger_index_entry_t *entry_a = a;
+    const key_override_trigger_index_entry_t *entry_b = b;
+
+    if (entry_a->trigger != entry_b->trigger) {
+        return entry_a->trigger < entry_b->trigger ? -1 : 1;
+    }
+    return (int)entry_a->override_index - (int)entry_b->override_index;
+}
+
+static void key_override_trigger_index_build(void) {
+    key_override_trigger_index_length         = 0;
+    key_override_trigger_index_override_count = key_override_count();
+    key_override_trigger_index_overflow       = key_override_trigger_index_override_count > KEY_OVERRIDE_TRIGGER_INDEX_SIZE;
+
+    for (uint16_t i = 0; i < key_override_trigger_index_override_count && !key_override_trigger_index_overflow; i++) {
+        const key_override_t *const override = key_override_get(i);
+
+        // End of array
+        if (override == NULL) {
+            break;
+        }
+
+        key_override_trigger_index[key_override_trigger_index_length++] = (key_override_trigger_index_entry_t){
+            .trigger        = override->trigger,
+            .override_index = i,
+        };
+    }
+
+    qsort(key_override_trigger_index, key_override_trigger_index_length, sizeof(key_override_trigger_index_entry_t), key_override_trigger_index_compare);
+    key_override_trigger_index_valid = true;
+}
+
+static uint16_t key_override_trigger_index_lower_bound(uint16_t trigger) {
+    uint16_t low = 0, high = key_override_trigger_index_length;
+    while (low < high) {
+        uint16_t mid = low + (high - low) / 2;
+        if (key_override_trigger_index[mid].trigger < trigger) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+typedef struct {
+    // Next index entry of the overrides without a trigger, triggered by the event's key and by the last key down
+    uint16_t position[3];
+    uint16_t trigger[3];
+    // Next override when every override has to be checked
+    uint16_t next;
+} key_override_candidates_t;
+
+/** Only overrides without a trigger, or triggered by the key of the event or the last key held down, can activate. */
+static void key_override_candidates_init(key_override_candidates_t *candidates, const uint16_t keycode) {
+    if (!key_override_trigger_index_valid || key_override_trigger_index_override_count != key_override_count()) {
+        key_override_trigger_index_build();
+    }
+
+    candidates->next       = 0;
+    candidates->trigger[0] = KC_NO;
+    candidates->trigger[1] = keycode;
+    candidates->trigger[2] = last_key_down;
+    for (uint8_t i = 0; i < 3; i++) {
+        const bool duplicate = (i > 0 && candidates->trigger[i] == KC_NO) || (i > 1 && candidates->trigger[i] == candidates->trigger[1]);
+
+        candidates->position[i] = duplicate ? key_override_trigger_index_length : key_override_trigger_index_lower_bound(candidates->trigger[i]);
+    }
+}
+
+/** Returns the table index of the next override to check, in table order so the first one that activates still wins, or UINT16_MAX. */
+static uint16_t key_override_next_candidate(key_override_candidates_t *candidates) {
+    if (key_override_trigger_index_overflow) {
+        return candidates->next++;
+    }
+
+    uint16_t *next = NULL;
+    for (uint8_t i = 0; i < 3; i++) {
+        uint16_t *position = &candidates->position[i];
+        if (*position >= key_override_trigger_index_length || key_override_trigger_index[*position].trigger != candidates->trigger[i]) {
+            continue;
+        }
+        if (next == NULL || key_override_trigger_index[*position].override_index < key_override_trigger_index[*next].override_index) {
+            next = position;
+        }
+    }
+    if (next == NULL) {
+        return UINT16_MAX;
+    }
+    return key_override_trigger_index[(*next)++].override_index;
+}
+#endif
+
 /** Iterates through the list of key overrides and tries activating each, until it finds one that activates or reaches the end of overrides. Returns true if the key action for `keycode` should be sent */
 static bool try_activating_override(const uint16_t keycode, const uint8_t layer, const bool key_down, const bool is_mod, const uint8_t active_mods, bool *activated) {
     if (key_override_count() == 0) {
         return true;
     }
 
+#ifdef KEY_OVERRIDE_TRIGGER_INDEX
+    key_override_candidates_t candidates;
+    key_override_candidates_init(&candidates, keycode);
+
+    for (uint16_t i = key_override_next_candidate(&candidates); i < key_override_count(); i = key_override_next_candidate(&candidates)) {
+#else
     for (uint8_t i = 0; i < key_override_count(); i++) {
+#endif
         const key_override_t *const override = key_override_get(i);
 
         // End of array
@@ -21,6 +21,10 @@
 #    include "sleep_led.h"
 #endif
 
+#ifdef REPORT_COALESCE_ENABLE
+#    include "report_coalesce.h"
+#endif
+
 #ifdef BACKLIGHT_ENABLE
 #    include "process_backlight.h"
 #endif
@@ -247,7 +251,7 @@ void soft_reset_keyboard(void) {
 
 /* Convert record into usable keycode via the contained event. */
 uint16_t get_record_keycode(keyrecord_t *record, bool update_layer_cache) {
-#if defined(COMBO_ENABLE) || defined(REPEAT_KEY_ENABLE)
+#if defined(COMBO_ENABLE) || defined(CHORD_ENABLE) || defined(REPEAT_KEY_ENABLE) || defined(LEADER_SEQUENCE_TABLE)
     if (record->keycode) {
         return record->keycode;
     }
@@ -282,6 +286,9 @@ uint16_t get_event_keycode(keyevent_t event, bool update_layer_cache) {
 /* Get keycode, and then process pre tapping functionality */
 bool pre_process_record_quantum(keyrecord_t *record) {
     return pre_process_record_modules(get_record_keycode(record, true), record) && pre_process_record_kb(get_record_keycode(record, true), record) &&
+#ifdef CHORD_ENABLE
+           process_chord(get_record_keycode(record, true), record) &&
+#endif
 #ifdef COMBO_ENABLE
            process_combo(get_record_keycode(record, true), record) &&
 #endif
@@ -324,6 +331,10 @@ bool process_record_quantum(keyrecord_t *record) {
     }
 #endif
 
+#ifdef LATENCY_TRACE_ENABLE
+    latency_trace_process_record(record, keycode);
+#endif
+
 #ifdef RGBLIGHT_ENABLE
     if (record->event.pressed) {
         preprocess_rgblight();
@@ -481,6 +492,10 @@ __attribute__((weak)) bool shutdown_kb(bool jump_to_bootloader) {
 }
 
 void suspend_power_down_quantum(void) {
+#ifdef REPORT_COALESCE_ENABLE
+    // Whatever is still queued would otherwise reach the host after the wakeup, out of date
+    report_coalesce_flush();
+#endif
     suspend_power_down_modules();
     suspend_power_down_kb();
 #ifndef NO_SUSPEND_POWER_DOWN
@@ -139,6 +139,10 @@ extern layer_state_t layer_state;
 #    include "process_combo.h"
 #endif
 
+#ifdef CHORD_ENABLE
+#    include "process_chord.h"
+#endif
+
 #ifdef KEY_LOCK_ENABLE
 #    include "process_key_lock.h"
 #endif
@@ -159,6 +163,10 @@ extern layer_state_t layer_state;
 #    include "send_string.h"
 #endif
 
+#ifdef SEND_STRING_ASYNC_ENABLE
+#    include "send_string_async.h"
+#endif
+
 #ifdef HAPTIC_ENABLE
 #    include "haptic.h"
 #endif
@@ -249,6 +257,18 @@ extern layer_state_t layer_state;
 #    include "layer_lock.h"
 #endif
 
+#ifdef LATENCY_TRACE_ENABLE
+#    include "latency_trace.h"
+#endif
+
+#ifdef TASK_SCHEDULER_ENABLE
+#    include "task_scheduler.h"
+#endif
+
+#ifdef TASK_TIMING_ENABLE
+#    include "task_timing.h"
+#endif
+
 #ifdef COMMUNITY_MODULES_ENABLE
 #    include "community_modules.h"
 #endif
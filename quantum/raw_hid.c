@@ -1,9 +1,26 @@
 // Copyright 2025 QMK
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <stdbool.h>
 #include "raw_hid.h"
 #include "host.h"
 
+#ifdef LATENCY_TRACE_ENABLE
+#    include "latency_trace.h"
+#endif
+
+#if defined(AUTOCORRECT_ENABLE) && defined(AUTOCORRECT_NVM_DICTIONARY_SIZE)
+#    include "process_autocorrect.h"
+#endif
+
+#ifdef TASK_TIMING_ENABLE
+#    include "task_timing.h"
+#endif
+
+#if defined(PROTOCOL_CHIBIOS) && defined(USB_ENDPOINT_STATS_RAW_HID_ENABLE)
+#    include "usb_main.h"
+#endif
+
 void raw_hid_send(uint8_t *data, uint8_t length) {
     host_raw_hid_send(data, length);
 }
@@ -13,3 +30,26 @@ __attribute__((weak)) void raw_hid_receive(uint8_t *data, uint8_t length) {
     // and implement this function there. Leave this as weak linkage
     // so users can opt to not handle data coming in.
 }
+
+void raw_hid_receive_quantum(uint8_t *data, uint8_t length) {
+    bool handled = false;
+
+#if defined(AUTOCORRECT_ENABLE) && defined(AUTOCORRECT_NVM_DICTIONARY_SIZE)
+    handled = handled || autocorrect_raw_hid_receive(data, length);
+#endif
+#ifdef LATENCY_TRACE_ENABLE
+    handled = handled || latency_trace_raw_hid_receive(data, length);
+#endif
+#ifdef TASK_TIMING_ENABLE
+    handled = handled || task_timing_raw_hid_receive(data, length);
+#endif
+#if defined(PROTOCOL_CHIBIOS) && defined(USB_ENDPOINT_STATS_RAW_HID_ENABLE)
+    handled = handled || usb_endpoint_stats_raw_hid_receive(data, length);
+#endif
+
+    if (handled) {
+        raw_hid_send(data, length);
+        return;
+    }
+    raw_hid_receive(data, length);
+}
@@ -20,6 +20,18 @@
  */
 void raw_hid_receive(uint8_t *data, uint8_t length);
 
+/**
+ * \brief Handle a raw HID report received from the host, called by the protocol drivers.
+ *
+ * Answers the commands of the core features that use raw HID (autocorrect's NVM dictionary,
+ * latency trace, task timing and the ChibiOS USB endpoint counters), and passes every other report on to
+ * `raw_hid_receive()`.
+ *
+ * \param data A pointer to the received data. Always 32 bytes in length.
+ * \param length The length of the buffer. Always 32.
+ */
+void raw_hid_receive_quantum(uint8_t *data, uint8_t length);
+
 /**
  * \brief Send an HID report.
  *
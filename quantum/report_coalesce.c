@@ -0,0 +1,309 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "report_coalesce.h"
+
+#include <string.h>
+
+#include "host.h"
+#include "timer.h"
+
+typedef struct {
+    uint8_t  head;
+    uint8_t  count;
+    uint32_t last_sent;
+} report_queue_t;
+
+// The first report is due right away
+#define REPORT_QUEUE_INIT \
+    { .last_sent = -REPORT_COALESCE_INTERVAL }
+
+// What changed from one keyboard report to the next
+enum {
+    CHANGED_MODS = 1 << 0,
+    CHANGED_KEYS = 1 << 1,
+    PRESSED_KEY  = 1 << 2,
+};
+
+static uint8_t queue_index(const report_queue_t *queue, uint8_t offset) {
+    return (queue->head + offset) % REPORT_COALESCE_QUEUE_SIZE;
+}
+
+static bool queue_due(const report_queue_t *queue) {
+    return queue->count && timer_elapsed32(queue->last_sent) >= REPORT_COALESCE_INTERVAL;
+}
+
+/* Takes the oldest report off the queue, returning its index */
+static uint8_t queue_pop(report_queue_t *queue) {
+    uint8_t index    = queue->head;
+    queue->head      = queue_index(queue, 1);
+    queue->last_sent = timer_read32();
+    queue->count--;
+    return index;
+}
+
+/* Whether the changes of two consecutive reports can go to the host in a single report */
+static bool can_merge(uint8_t first, uint8_t second) {
+    // A modifier goes down before its key, and comes up after it
+    if ((first & CHANGED_MODS && second & CHANGED_KEYS) || (first & CHANGED_KEYS && second & CHANGED_MODS)) {
+        return false;
+    }
+    // Rolled keys keep their order
+    return !(first & PRESSED_KEY && second & PRESSED_KEY);
+}
+
+/* Whether a modifier or key bit changed from `before` to `tail` changes back from `tail` to `next`, hiding it from the host */
+static bool bits_undone(uint8_t before, uint8_t tail, uint8_t next) {
+    return (before ^ tail) & (tail ^ next);
+}
+
+static report_keyboard_t keyboard_queue[REPORT_COALESCE_QUEUE_SIZE];
+static report_keyboard_t keyboard_sent;
+static report_queue_t    keyboard_state = REPORT_QUEUE_INIT;
+
+static void keyboard_send_oldest(void) {
+    host_keyboard_send_now(&keyboard_queue[queue_pop(&keyboard_state)]);
+}
+
+void report_coalesce_keyboard_sent(const report_keyboard_t *report) {
+    keyboard_sent = *report;
+}
+
+static bool keyboard_has_key(const report_keyboard_t *report, uint8_t key) {
+    for (uint8_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+        if (report->keys[i] == key) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static uint8_t keyboard_changes(const report_keyboard_t *from, const report_keyboard_t *to) {
+    uint8_t changes = from->mods != to->mods ? CHANGED_MODS : 0;
+    for (uint8_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+        if (from->keys[i] && !keyboard_has_key(to, from->keys[i])) {
+            changes |= CHANGED_KEYS;
+        }
+        if (to->keys[i] && !keyboard_has_key(from, to->keys[i])) {
+            changes |= CHANGED_KEYS | PRESSED_KEY;
+        }
+    }
+    return changes;
+}
+
+static bool keyboard_undone(const report_keyboard_t *before, const report_keyboard_t *tail, const report_keyboard_t *next) {
+    if (bits_undone(before->mods, tail->mods, next->mods)) {
+        return true;
+    }
+    for (uint8_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+        // Tapped within the tail
+        if (tail->keys[i] && !keyboard_has_key(before, tail->keys[i]) && !keyboard_has_key(next, tail->keys[i])) {
+            return true;
+        }
+        // Released by the tail, then pressed again
+        if (before->keys[i] && !keyboard_has_key(tail, before->keys[i]) && keyboard_has_key(next, before->keys[i])) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void keyboard_push(const report_keyboard_t *report) {
+    report_keyboard_t *tail   = keyboard_state.count ? &keyboard_queue[queue_index(&keyboard_state, keyboard_state.count - 1)] : &keyboard_sent;
+    report_keyboard_t *before = keyboard_state.count > 1 ? &keyboard_queue[queue_index(&keyboard_state, keyboard_state.count - 2)] : &keyboard_sent;
+
+    if (memcmp(tail, report, sizeof(report_keyboard_t)) == 0) {
+        return;
+    }
+    if (keyboard_state.count && can_merge(keyboard_changes(before, tail), keyboard_changes(tail, report)) && !keyboard_undone(before, tail, report)) {
+        *tail = *report;
+        return;
+    }
+    if (keyboard_state.count == REPORT_COALESCE_QUEUE_SIZE) {
+        keyboard_send_oldest();
+    }
+    keyboard_queue[queue_index(&keyboard_state, keyboard_state.count++)] = *report;
+}
+
+void report_coalesce_keyboard(const report_keyboard_t *report) {
+    const report_keyboard_t *newest = keyboard_state.count ? &keyboard_queue[queue_index(&keyboard_state, keyboard_state.count - 1)] : &keyboard_sent;
+
+    // Split a report that presses a key along with a modifier change, so the host sees the modifiers first
+    uint8_t changes = keyboard_changes(newest, report);
+    if (changes & CHANGED_MODS && changes & PRESSED_KEY) {
+        report_keyboard_t mods_first = *report;
+        for (uint8_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+            if (!keyboard_has_key(newest, mods_first.keys[i])) {
+                mods_first.keys[i] = 0;
+            }
+        }
+        keyboard_push(&mods_first);
+    }
+    keyboard_push(report);
+}
+
+#ifdef NKRO_ENABLE
+static report_nkro_t  nkro_queue[REPORT_COALESCE_QUEUE_SIZE];
+static report_nkro_t  nkro_sent;
+static report_queue_t nkro_state = REPORT_QUEUE_INIT;
+
+static void nkro_send_oldest(void) {
+    host_nkro_send_now(&nkro_queue[queue_pop(&nkro_state)]);
+}
+
+void report_coalesce_nkro_sent(const report_nkro_t *report) {
+    nkro_sent = *report;
+}
+
+static uint8_t nkro_changes(const report_nkro_t *from, const report_nkro_t *to) {
+    uint8_t changes = from->mods != to->mods ? CHANGED_MODS : 0;
+    for (uint8_t i = 0; i < NKRO_REPORT_BITS; i++) {
+        if (from->bits[i] != to->bits[i]) {
+            changes |= CHANGED_KEYS;
+        }
+        if (to->bits[i] & ~from->bits[i]) {
+            changes |= PRESSED_KEY;
+        }
+    }
+    return changes;
+}
+
+static bool nkro_undone(const report_nkro_t *before, const report_nkro_t *tail, const report_nkro_t *next) {
+    if (bits_undone(before->mods, tail->mods, next->mods)) {
+        return true;
+    }
+    for (uint8_t i = 0; i < NKRO_REPORT_BITS; i++) {
+        if (bits_undone(before->bits[i], tail->bits[i], next->bits[i])) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void nkro_push(const report_nkro_t *report) {
+    report_nkro_t *tail   = nkro_state.count ? &nkro_queue[queue_index(&nkro_state, nkro_state.count - 1)] : &nkro_sent;
+    report_nkro_t *before = nkro_state.count > 1 ? &nkro_queue[queue_index(&nkro_state, nkro_state.count - 2)] : &nkro_sent;
+
+    if (memcmp(tail, report, sizeof(report_nkro_t)) == 0) {
+        return;
+    }
+    if (nkro_state.count && can_merge(nkro_changes(before, tail), nkro_changes(tail, report)) && !nkro_undone(before, tail, report)) {
+        *tail = *report;
+        return;
+    }
+    if (nkro_state.count == REPORT_COALESCE_QUEUE_SIZE) {
+        nkro_send_oldest();
+    }
+    nkro_queue[queue_index(&nkro_state, nkro_state.count++)] = *report;
+}
+
+void report_coalesce_nkro(const report_nkro_t *report) {
+    const report_nkro_t *newest = nkro_state.count ? &nkro_queue[queue_index(&nkro_state, nkro_state.count - 1)] : &nkro_sent;
+
+    uint8_t changes = nkro_changes(newest, report);
+    if (changes & CHANGED_MODS && changes & PRESSED_KEY) {
+        report_nkro_t mods_first = *report;
+        for (uint8_t i = 0; i < NKRO_REPORT_BITS; i++) {
+            mods_first.bits[i] &= newest->bits[i];
+        }
+        nkro_push(&mods_first);
+    }
+    nkro_push(report);
+}
+#endif
+
+#ifdef MOUSE_ENABLE
+static report_mouse_t mouse_queue[REPORT_COALESCE_QUEUE_SIZE];
+static uint8_t        mouse_sent_buttons;
+static report_queue_t mouse_state = REPORT_QUEUE_INIT;
+
+static void mouse_send_oldest(void) {
+    host_mouse_send_now(&mouse_queue[queue_pop(&mouse_state)]);
+}
+
+void report_coalesce_mouse_sent(const report_mouse_t *report) {
+    mouse_sent_buttons = report->buttons;
+}
+
+static bool mouse_fits(int32_t value, int32_t min, int32_t max) {
+    return value >= min && value <= max;
+}
+
+void report_coalesce_mouse(const report_mouse_t *report) {
+    if (mouse_state.count) {
+        report_mouse_t *tail           = &mouse_queue[queue_index(&mouse_state, mouse_state.count - 1)];
+        uint8_t         before_buttons = mouse_state.count > 1 ? mouse_queue[queue_index(&mouse_state, mouse_state.count - 2)].buttons : mouse_sent_buttons;
+
+        // Movement is added up, but a click stays where it happened
+        if (tail->buttons == before_buttons && report->buttons == tail->buttons && mouse_fits((int32_t)tail->x + report->x, MOUSE_REPORT_XY_MIN, MOUSE_REPORT_XY_MAX) && mouse_fits((int32_t)tail->y + report->y, MOUSE_REPORT_XY_MIN, MOUSE_REPORT_XY_MAX) && mouse_fits((int32_t)tail->h + report->h, MOUSE_REPORT_HV_MIN, MOUSE_REPORT_HV_MAX) && mouse_fits((int32_t)tail->v + report->v, MOUSE_REPORT_HV_MIN, MOUSE_REPORT_HV_MAX)) {
+            tail->x += report->x;
+            tail->y += report->y;
+            tail->h += report->h;
+            tail->v += report->v;
+            return;
+        }
+    }
+    if (mouse_state.count == REPORT_COALESCE_QUEUE_SIZE) {
+        mouse_send_oldest();
+    }
+    mouse_queue[queue_index(&mouse_state, mouse_state.count++)] = *report;
+}
+#endif
+
+#ifdef EXTRAKEY_ENABLE
+static report_extra_t extra_queue[REPORT_COALESCE_QUEUE_SIZE];
+static report_queue_t extra_state = REPORT_QUEUE_INIT;
+
+static void extra_send_oldest(void) {
+    host_extra_send_now(&extra_queue[queue_pop(&extra_state)]);
+}
+
+void report_coalesce_extra(const report_extra_t *report) {
+    if (extra_state.count == REPORT_COALESCE_QUEUE_SIZE) {
+        extra_send_oldest();
+    }
+    extra_queue[queue_index(&extra_state, extra_state.count++)] = *report;
+}
+#endif
+
+void report_coalesce_task(void) {
+    if (queue_due(&keyboard_state)) {
+        keyboard_send_oldest();
+    }
+#ifdef NKRO_ENABLE
+    if (queue_due(&nkro_state)) {
+        nkro_send_oldest();
+    }
+#endif
+#ifdef MOUSE_ENABLE
+    if (queue_due(&mouse_state)) {
+        mouse_send_oldest();
+    }
+#endif
+#ifdef EXTRAKEY_ENABLE
+    if (queue_due(&extra_state)) {
+        extra_send_oldest();
+    }
+#endif
+}
+
+void report_coalesce_flush(void) {
+    while (keyboard_state.count) {
+        keyboard_send_oldest();
+    }
+#ifdef NKRO_ENABLE
+    while (nkro_state.count) {
+        nkro_send_oldest();
+    }
+#endif
+#ifdef MOUSE_ENABLE
+    while (mouse_state.count) {
+        mouse_send_oldest();
+    }
+#endif
+#ifdef EXTRAKEY_ENABLE
+    while (extra_state.count) {
+        extra_send_oldest();
+    }
+#endif
+}
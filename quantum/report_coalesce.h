@@ -0,0 +1,83 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "report.h"
+
+/**
+ * \file
+ *
+ * \defgroup report_coalesce Report Coalescing
+ *
+ * Queues the keyboard, NKRO, mouse and extra reports instead of handing each one to the host driver,
+ * and sends at most one of every kind per polling interval from `host_task()`. A report that only adds
+ * to the changes of the report queued before it replaces that report, as long as the host still sees
+ * every key change, and in the order it needs them: a modifier goes down before its key and comes up
+ * after it, and rolled keys go down one report at a time.
+ * \{
+ */
+
+#ifndef REPORT_COALESCE_INTERVAL
+#    ifdef USB_POLLING_INTERVAL_MS
+#        define REPORT_COALESCE_INTERVAL USB_POLLING_INTERVAL_MS
+#    else
+#        define REPORT_COALESCE_INTERVAL 1
+#    endif
+#endif
+
+// Once full, the oldest report is sent right away rather than dropped
+#ifndef REPORT_COALESCE_QUEUE_SIZE
+#    define REPORT_COALESCE_QUEUE_SIZE 4
+#endif
+
+/**
+ * \brief Queue a keyboard report, merging it into the one queued before it when possible.
+ */
+void report_coalesce_keyboard(const report_keyboard_t *report);
+
+/**
+ * \brief Queue an NKRO report, merging it into the one queued before it when possible.
+ */
+void report_coalesce_nkro(const report_nkro_t *report);
+
+/**
+ * \brief Queue a mouse report, adding its movement to the one queued before it when the buttons are unchanged.
+ */
+void report_coalesce_mouse(const report_mouse_t *report);
+
+/**
+ * \brief Queue a system or consumer report. These are never merged, only spaced out.
+ */
+void report_coalesce_extra(const report_extra_t *report);
+
+/**
+ * \brief Note the keyboard report the host driver was given, which the next queued report is compared against.
+ *
+ * Called by `host_keyboard_send_now()`, so that reports sent around the queue are accounted for as well.
+ */
+void report_coalesce_keyboard_sent(const report_keyboard_t *report);
+
+/**
+ * \brief Note the NKRO report the host driver was given, see `report_coalesce_keyboard_sent()`.
+ */
+void report_coalesce_nkro_sent(const report_nkro_t *report);
+
+/**
+ * \brief Note the mouse report the host driver was given, see `report_coalesce_keyboard_sent()`.
+ */
+void report_coalesce_mouse_sent(const report_mouse_t *report);
+
+/**
+ * \brief Send the oldest queued report of every kind whose polling interval has passed.
+ */
+void report_coalesce_task(void);
+
+/**
+ * \brief Send every queued report right away.
+ */
+void report_coalesce_flush(void);
+
+/** \} */
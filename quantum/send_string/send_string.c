@@ -143,9 +143,6 @@ __attribute__((weak)) const uint8_t ascii_to_keycode_lut[128] PROGMEM = {
 
 // clang-format on
 
-// Note: we bit-pack in "reverse" order to optimize loading
-#define PGM_LOADBIT(mem, pos) ((pgm_read_byte(&((mem)[(pos) / 8])) >> ((pos) % 8)) & 0x01)
-
 void send_string(const char *string) {
     send_string_with_delay(string, TAP_CODE_DELAY);
 }
@@ -46,6 +46,9 @@ extern const uint8_t ascii_to_keycode_lut[128];
     | ((h) ? 1 : 0) << 7 )
 // clang-format on
 
+// Note: we bit-pack in "reverse" order to optimize loading
+#define PGM_LOADBIT(mem, pos) ((pgm_read_byte(&((mem)[(pos) / 8])) >> ((pos) % 8)) & 0x01)
+
 /**
  * \brief Type out a string of ASCII characters.
  *
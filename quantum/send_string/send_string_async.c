@@ -0,0 +1,251 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "send_string_async.h"
+
+#include <ctype.h>
+
+#include "send_string.h"
+#include "action.h"
+#include "deferred_exec.h"
+#include "keycode.h"
+#include "timer.h"
+#include "util.h"
+#include "wait.h"
+
+#if defined(AUDIO_ENABLE) && defined(SENDSTRING_BELL)
+#    include "audio.h"
+extern float bell_song[][2];
+#endif
+
+typedef struct {
+    const char                  *string;
+    send_string_async_callback_t callback;
+    void                        *cb_arg;
+    uint8_t                      interval;
+    bool                         progmem;
+} send_string_async_entry_t;
+
+typedef struct {
+    uint8_t keycode;
+    bool    pressed;
+} send_string_async_step_t;
+
+static send_string_async_entry_t queue[SEND_STRING_ASYNC_QUEUE_SIZE];
+static uint8_t                   queue_head  = 0;
+static uint8_t                   queue_count = 0;
+
+// The reports of the current character: modifiers, the key itself, and a space after a dead key
+static send_string_async_step_t steps[8];
+static uint8_t                  step_count = 0;
+static uint8_t                  step_index = 0;
+static bool                     stepping   = false;
+
+static keyevent_t held_events[SEND_STRING_ASYNC_EVENT_BUFFER_SIZE];
+static uint8_t    held_head  = 0;
+static uint8_t    held_count = 0;
+static bool       releasing  = false;
+
+static deferred_executor_t executor       = {0};
+static uint32_t            last_execution = 0;
+
+/* Reads the next character of the string, staying on the terminating null */
+static char send_string_async_next_char(send_string_async_entry_t *entry) {
+#if defined(__AVR__)
+    char ascii_code = entry->progmem ? pgm_read_byte(entry->string) : *entry->string;
+#else
+    char ascii_code = *entry->string;
+#endif
+    if (ascii_code) {
+        entry->string++;
+    }
+    return ascii_code;
+}
+
+static void send_string_async_add_step(uint8_t keycode, bool pressed) {
+    steps[step_count++] = (send_string_async_step_t){.keycode = keycode, .pressed = pressed};
+}
+
+/* The same keystrokes as send_char_with_delay(), one step per report */
+static void send_string_async_add_char(char ascii_code) {
+#if defined(AUDIO_ENABLE) && defined(SENDSTRING_BELL)
+    if (ascii_code == '\a') { // BEL
+        PLAY_SONG(bell_song);
+        return;
+    }
+#endif
+
+    uint8_t keycode    = pgm_read_byte(&ascii_to_keycode_lut[(uint8_t)ascii_code]);
+    bool    is_shifted = PGM_LOADBIT(ascii_to_shift_lut, (uint8_t)ascii_code);
+    bool    is_altgred = PGM_LOADBIT(ascii_to_altgr_lut, (uint8_t)ascii_code);
+    bool    is_dead    = PGM_LOADBIT(ascii_to_dead_lut, (uint8_t)ascii_code);
+
+    if (is_shifted) {
+        send_string_async_add_step(KC_LEFT_SHIFT, true);
+    }
+    if (is_altgred) {
+        send_string_async_add_step(KC_RIGHT_ALT, true);
+    }
+    send_string_async_add_step(keycode, true);
+    send_string_async_add_step(keycode, false);
+    if (is_altgred) {
+        send_string_async_add_step(KC_RIGHT_ALT, false);
+    }
+    if (is_shifted) {
+        send_string_async_add_step(KC_LEFT_SHIFT, false);
+    }
+    if (is_dead) {
+        send_string_async_add_step(KC_SPACE, true);
+        send_string_async_add_step(KC_SPACE, false);
+    }
+}
+
+/* Sends the next report, returning the time until the one after, or 0 once the queue is empty */
+static uint32_t send_string_async_step(void) {
+    stepping = true;
+    while (queue_count) {
+        send_string_async_entry_t *entry = &queue[queue_head];
+
+        if (step_index < step_count) {
+            send_string_async_step_t *step = &steps[step_index++];
+            if (step->pressed) {
+                register_code(step->keycode);
+            } else {
+                unregister_code(step->keycode);
+            }
+            stepping = false;
+            return MAX(entry->interval, SEND_STRING_ASYNC_MIN_INTERVAL);
+        }
+        step_index = step_count = 0;
+
+        char ascii_code = send_string_async_next_char(entry);
+        if (!ascii_code) {
+            send_string_async_callback_t callback = entry->callback;
+            void                        *cb_arg   = entry->cb_arg;
+            queue_head                            = (queue_head + 1) % SEND_STRING_ASYNC_QUEUE_SIZE;
+            queue_count--;
+            // The callback may queue the next string
+            if (callback) {
+                callback(cb_arg);
+            }
+            continue;
+        }
+
+        if (ascii_code != SS_QMK_PREFIX) {
+            send_string_async_add_char(ascii_code);
+            continue;
+        }
+
+        switch (send_string_async_next_char(entry)) {
+            case SS_TAP_CODE: {
+                uint8_t keycode = send_string_async_next_char(entry);
+                send_string_async_add_step(keycode, true);
+                send_string_async_add_step(keycode, false);
+                break;
+            }
+            case SS_DOWN_CODE:
+                send_string_async_add_step(send_string_async_next_char(entry), true);
+                break;
+            case SS_UP_CODE:
+                send_string_async_add_step(send_string_async_next_char(entry), false);
+                break;
+            case SS_DELAY_CODE: {
+                uint32_t ms = 0;
+                char     digit;
+                while (isdigit(digit = send_string_async_next_char(entry))) {
+                    ms *= 10;
+                    ms += digit - '0';
+                }
+                if (ms + entry->interval) {
+                    stepping = false;
+                    return ms + entry->interval;
+                }
+                break;
+            }
+        }
+    }
+    stepping = false;
+    return 0;
+}
+
+static uint32_t send_string_async_tick(uint32_t trigger_time, void *cb_arg) {
+    return send_string_async_step();
+}
+
+static bool send_string_async_enqueue(const char *string, uint8_t interval, send_string_async_callback_t callback, void *cb_arg, bool progmem) {
+    if (queue_count == SEND_STRING_ASYNC_QUEUE_SIZE) {
+        return false;
+    }
+    queue[(queue_head + queue_count++) % SEND_STRING_ASYNC_QUEUE_SIZE] = (send_string_async_entry_t){
+        .string   = string,
+        .callback = callback,
+        .cb_arg   = cb_arg,
+        .interval = interval,
+        .progmem  = progmem,
+    };
+
+    // The first report goes out right away, the rest from send_string_async_task()
+    if (!stepping && executor.token == INVALID_DEFERRED_TOKEN) {
+        uint32_t delay_ms = send_string_async_step();
+        if (delay_ms) {
+            last_execution = timer_read32();
+            defer_exec_advanced(&executor, 1, delay_ms, send_string_async_tick, NULL);
+        }
+    }
+    return true;
+}
+
+bool send_string_async(const char *string, uint8_t interval, send_string_async_callback_t callback, void *cb_arg) {
+    return send_string_async_enqueue(string, interval, callback, cb_arg, false);
+}
+
+#if defined(__AVR__)
+bool send_string_async_P(const char *string, uint8_t interval, send_string_async_callback_t callback, void *cb_arg) {
+    return send_string_async_enqueue(string, interval, callback, cb_arg, true);
+}
+#endif
+
+bool send_string_async_is_busy(void) {
+    return queue_count || held_count;
+}
+
+/* Processes the held key events in order, until one of them starts another string */
+static void send_string_async_release_events(void) {
+    while (held_count && !queue_count) {
+        keyevent_t event = held_events[held_head];
+        held_head        = (held_head + 1) % SEND_STRING_ASYNC_EVENT_BUFFER_SIZE;
+        held_count--;
+
+        releasing = true;
+        action_exec(event);
+        releasing = false;
+    }
+}
+
+void send_string_async_flush(void) {
+    while (send_string_async_is_busy()) {
+        while (queue_count) {
+            wait_ms(send_string_async_step());
+        }
+        send_string_async_release_events();
+    }
+    cancel_deferred_exec_advanced(&executor, 1, executor.token);
+}
+
+bool send_string_async_hold_event(keyevent_t event) {
+    if (releasing || !send_string_async_is_busy()) {
+        return false;
+    }
+    if (held_count == SEND_STRING_ASYNC_EVENT_BUFFER_SIZE) {
+        // Rather than lose or reorder key events, finish typing first
+        send_string_async_flush();
+        return false;
+    }
+    held_events[(held_head + held_count++) % SEND_STRING_ASYNC_EVENT_BUFFER_SIZE] = event;
+    return true;
+}
+
+void send_string_async_task(void) {
+    deferred_exec_advanced_task(&executor, 1, &last_execution);
+    send_string_async_release_events();
+}
@@ -0,0 +1,93 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+/**
+ * \file
+ * \defgroup send_string_async Asynchronous Send String API
+ * \brief These functions type out strings in the background, one report per tick of the main loop.
+ *
+ * Unlike `send_string()`, nothing waits in between the keystrokes: matrix scanning, lighting and split sync
+ * carry on while a string is typed, and key events that happen in the meantime are held until every queued
+ * string is done, then processed in order.
+ * \{
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "progmem.h"
+#include "keyboard.h"
+
+#ifndef SEND_STRING_ASYNC_QUEUE_SIZE
+#    define SEND_STRING_ASYNC_QUEUE_SIZE 4
+#endif
+
+#ifndef SEND_STRING_ASYNC_EVENT_BUFFER_SIZE
+#    define SEND_STRING_ASYNC_EVENT_BUFFER_SIZE 8
+#endif
+
+// The host must see every report, so they are never sent closer together than its polling interval
+#ifndef SEND_STRING_ASYNC_MIN_INTERVAL
+#    ifdef USB_POLLING_INTERVAL_MS
+#        define SEND_STRING_ASYNC_MIN_INTERVAL USB_POLLING_INTERVAL_MS
+#    else
+#        define SEND_STRING_ASYNC_MIN_INTERVAL 1
+#    endif
+#endif
+
+/**
+ * \brief Called once a string has been typed out.
+ * \param cb_arg The argument given along with the string.
+ */
+typedef void (*send_string_async_callback_t)(void *cb_arg);
+
+/**
+ * \brief Queue a string of ASCII characters to be typed out in the background.
+ * The string is not copied, it must stay valid until `callback` is called. The same keycodes as `send_string()` are supported.
+ * \param string The string to type out.
+ * \param interval The amount of time, in milliseconds, to wait in between reports. At least `SEND_STRING_ASYNC_MIN_INTERVAL` is waited.
+ * \param callback Called once the string is done, or NULL.
+ * \param cb_arg Passed to `callback`.
+ * \return false if the queue is full and the string was not queued.
+ */
+bool send_string_async(const char *string, uint8_t interval, send_string_async_callback_t callback, void *cb_arg);
+
+#if defined(__AVR__) || defined(__DOXYGEN__)
+/**
+ * \brief Queue a PROGMEM string of ASCII characters to be typed out in the background.
+ * On ARM devices, this function is simply an alias for send_string_async(string, interval, callback, cb_arg).
+ */
+bool send_string_async_P(const char *string, uint8_t interval, send_string_async_callback_t callback, void *cb_arg);
+#else
+#    define send_string_async_P(string, interval, callback, cb_arg) send_string_async(string, interval, callback, cb_arg)
+#endif
+
+/**
+ * \brief Shortcut macro for send_string_async_P(PSTR(string), 0, NULL, NULL).
+ */
+#define SEND_STRING_ASYNC(string) send_string_async_P(PSTR(string), 0, NULL, NULL)
+
+/**
+ * \brief Whether a string is being typed out, or key events are still held back.
+ */
+bool send_string_async_is_busy(void);
+
+/**
+ * \brief Type out everything queued right away, waiting in between the reports, then process the held key events.
+ */
+void send_string_async_flush(void);
+
+/**
+ * \brief Hold back a key event while strings are being typed out.
+ * \return true if the event was held, and will be processed later.
+ */
+bool send_string_async_hold_event(keyevent_t event);
+
+/**
+ * \brief Send the next report of the current string when it is due, and process held key events once all strings are done.
+ */
+void send_string_async_task(void);
+
+/** \} */
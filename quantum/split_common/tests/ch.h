@@ -0,0 +1,40 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Just enough of ChibiOS for the split latency simulation to run the serial protocol of its drivers on the host,
+// with the slave thread and the clock provided by split_latency_simulation.cpp.
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef uint32_t systime_t;
+typedef uint32_t sysinterval_t;
+typedef uint64_t time_conv_t;
+typedef struct thread thread_t;
+
+#ifndef likely
+#    define likely(x) __builtin_expect(!!(x), 1)
+#endif
+#ifndef unlikely
+#    define unlikely(x) __builtin_expect(!!(x), 0)
+#endif
+
+#define HIGHPRIO 255
+
+#define THD_WORKING_AREA(name, size) uint8_t name[size]
+#define THD_FUNCTION(name, arg) void name(void *arg)
+
+// The simulated clock ticks in microseconds
+#define TIME_I2US(interval) ((time_conv_t)(interval))
+
+systime_t     chVTGetSystemTimeX(void);
+sysinterval_t chVTTimeElapsedSinceX(systime_t start);
+
+static inline void chRegSetThreadName(const char *name) {
+    (void)name;
+}
+
+thread_t *chThdCreateStatic(void *working_area, size_t size, uint8_t priority, void (*function)(void *), void *arg);
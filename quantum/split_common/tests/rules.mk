@@ -0,0 +1,51 @@
+# Copyright 2026 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+# Host-side simulation of the split link, with the master polling the slave matrix or the slave pushing its changes,
+# with the buffers framed by a CRC or not, running the serial protocol of the ChibiOS drivers over a simulated wire, and
+# with the transactions batched into one exchange per scan
+SPLIT_LATENCY_DEFS := -DMATRIX_ROWS=8 -DMATRIX_COLS=8 -DSPLIT_KEYBOARD -DSPLIT_COMMON_TRANSACTIONS -DDISABLE_SYNC_TIMER
+
+SPLIT_LATENCY_SRC := $(PLATFORM_PATH)/timer.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c \
+	$(PLATFORM_PATH)/synchronization_util.c \
+	$(QUANTUM_PATH)/crc.c \
+	$(QUANTUM_PATH)/split_common/transactions.c \
+	$(QUANTUM_PATH)/split_common/transport.c \
+	$(QUANTUM_PATH)/split_common/tests/split_latency_simulation.cpp
+
+split_latency_poll_DEFS := $(SPLIT_LATENCY_DEFS)
+split_latency_poll_INC := $(QUANTUM_PATH)/split_common
+split_latency_poll_SRC := $(SPLIT_LATENCY_SRC)
+
+split_latency_push_DEFS := $(SPLIT_LATENCY_DEFS) -DSPLIT_MATRIX_PUSH
+split_latency_push_INC := $(QUANTUM_PATH)/split_common
+split_latency_push_SRC := $(SPLIT_LATENCY_SRC)
+
+split_latency_framed_DEFS := $(SPLIT_LATENCY_DEFS) -DSPLIT_LINK_FRAMING -DSPLIT_TRANSACTION_IDS_USER=SPLIT_LATENCY_COUNTER
+split_latency_framed_INC := $(QUANTUM_PATH)/split_common \
+	$(QUANTUM_PATH)/split_common/tests \
+	$(PLATFORM_PATH)/chibios/drivers
+split_latency_framed_SRC := $(SPLIT_LATENCY_SRC) \
+	$(PLATFORM_PATH)/chibios/drivers/serial_protocol.c
+
+# The slave pushes its changes over the framed full-duplex link, with the attention token of the real protocol
+split_latency_framed_push_DEFS := $(split_latency_framed_DEFS) -DSPLIT_MATRIX_PUSH -DSERIAL_USART_FULL_DUPLEX
+split_latency_framed_push_INC := $(split_latency_framed_INC)
+split_latency_framed_push_SRC := $(split_latency_framed_SRC)
+
+# The same protocol without the framing, as a baseline for the noisy link
+split_latency_serial_DEFS := $(SPLIT_LATENCY_DEFS) -DSPLIT_LATENCY_SERIAL
+split_latency_serial_INC := $(split_latency_framed_INC)
+split_latency_serial_SRC := $(split_latency_framed_SRC)
+
+# Keeps the sync timer, and syncs a few small sections into a payload that just takes them all
+split_latency_batched_DEFS := $(filter-out -DDISABLE_SYNC_TIMER,$(SPLIT_LATENCY_DEFS)) \
+	-DSPLIT_TRANSACTION_BATCHING \
+	-DSPLIT_BATCH_M2S_BUFFER_SIZE=9 \
+	-DSPLIT_TRANSPORT_MIRROR \
+	-DSPLIT_LED_STATE_ENABLE \
+	-DSPLIT_MODS_ENABLE
+split_latency_batched_INC := $(QUANTUM_PATH)/split_common
+split_latency_batched_SRC := $(SPLIT_LATENCY_SRC) \
+	$(QUANTUM_PATH)/sync_timer.c
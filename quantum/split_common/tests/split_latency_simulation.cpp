@@ -0,0 +1,841 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// Host-side simulation of the key press latency on each half of a split keyboard.
+//
+// Both halves run in this process, each with its own copy of the split shared memory, and their loops are interleaved
+// on a simulated clock. The master runs the real transactions_master(): every transaction costs a turnaround plus the
+// time its bytes spend on the wire, and sees the slave data as of that moment. The slave runs the real
+// transactions_slave() at the end of each of its scans. Keys are pressed at random times on either half, and a press
+// counts as seen once it is in the matrix the master hands on to the keyboard. The simulation is built once with the
+// master polling the slave matrix (split_latency_poll), once with the slave pushing its changes
+// (split_latency_push), once polling with every buffer framed by a CRC (split_latency_framed), once pushing over the
+// framed full-duplex link (split_latency_framed_push), once polling with the same unframed protocol
+// (split_latency_serial), and once with the transactions batched into one exchange per scan (split_latency_batched), so
+// the tables can be collected with `make test:split_latency_<mode>` and compared.
+//
+// The framed and serial builds run the real serial protocol of the ChibiOS drivers on both halves, the slave thread as
+// a coroutine, over a simulated wire that can corrupt and drop bytes and times reads out like SERIAL_USART_TIMEOUT.
+
+#include "gtest/gtest.h"
+
+#if defined(SPLIT_LINK_FRAMING) || defined(SPLIT_LATENCY_SERIAL)
+#    define SPLIT_LATENCY_WIRE
+#endif
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#ifdef SPLIT_LATENCY_WIRE
+#    include <deque>
+#    include <ucontext.h>
+#endif
+
+extern "C" {
+#include "matrix.h"
+#include "serial.h"
+#include "split_util.h"
+#include "timer.h"
+#include "transactions.h"
+#include "transport.h"
+
+#ifdef SPLIT_LATENCY_WIRE
+#    include <ch.h>
+#    include "crc.h"
+#    include "serial_protocol.h"
+#endif
+
+void set_time(uint32_t t);
+}
+
+#if defined(SPLIT_MATRIX_PUSH) && defined(SPLIT_LINK_FRAMING)
+#    define SPLIT_LATENCY_MODE "framed push"
+#elif defined(SPLIT_MATRIX_PUSH)
+#    define SPLIT_LATENCY_MODE "push"
+#elif defined(SPLIT_LINK_FRAMING)
+#    define SPLIT_LATENCY_MODE "framed"
+#elif defined(SPLIT_LATENCY_SERIAL)
+#    define SPLIT_LATENCY_MODE "serial"
+#elif defined(SPLIT_TRANSACTION_BATCHING)
+#    define SPLIT_LATENCY_MODE "batched"
+#else
+#    define SPLIT_LATENCY_MODE "poll"
+#endif
+
+#ifndef SPLIT_LATENCY_STROKES
+#    define SPLIT_LATENCY_STROKES 400
+#endif
+
+#define ROWS_PER_HAND ((MATRIX_ROWS) / 2)
+
+// SERIAL_USART_TIMEOUT
+#define SPLIT_LATENCY_TIMEOUT_NS 20000000ULL
+
+// The shortest a key is held
+#define SPLIT_LATENCY_TAP_MS 30
+
+namespace {
+
+struct Profile {
+    const char *name;
+    uint32_t    byte_ns;        // time on the wire per byte, start and stop bits included
+    uint32_t    turnaround_ns;  // per transaction, for the slave thread to wake up and answer
+    uint32_t    master_scan_ns; // the master loop, outside of the split transport
+    uint32_t    slave_scan_ns;  // the slave loop
+    uint32_t    drop_ppm;       // bytes lost on the wire, per million
+    uint32_t    corrupt_ppm;    // bytes with a flipped bit, per million
+};
+
+const Profile profiles[] = {
+    {"921600_baud", 10850, 20000, 200000, 200000, 0, 0},
+    {"921600_baud_slow_slave", 10850, 20000, 200000, 800000, 0, 0},
+    {"460800_baud", 21700, 20000, 200000, 200000, 0, 0},
+    {"115200_baud", 86800, 20000, 200000, 200000, 0, 0},
+#ifdef SPLIT_LATENCY_WIRE
+    // Only the links over the simulated wire notice, the others are modelled without one
+    {"921600_baud_noisy", 10850, 20000, 200000, 200000, 20, 20},
+#endif
+};
+
+struct Stroke {
+    uint64_t press;
+    uint64_t release;
+    bool     slave_half;
+    uint8_t  row;
+    uint8_t  col;
+};
+
+struct Result {
+    std::vector<uint64_t> master_latency;
+    std::vector<uint64_t> slave_latency;
+    uint64_t              loops;
+    uint64_t              transactions;
+    uint64_t              link_ns;
+    uint32_t              missed;
+#ifdef SPLIT_LINK_FRAMING
+    split_link_stats_t    link;
+#endif
+#ifdef SPLIT_TRANSACTION_BATCHING
+    uint64_t              unbatched_ns;
+#endif
+};
+
+struct Link {
+    const Profile        *profile;
+    uint64_t              now;        // the master clock
+    uint64_t              slave_next; // start of the next slave scan
+    split_shared_memory_t slave_memory;
+    matrix_row_t          slave_scanned[ROWS_PER_HAND];
+    bool                  signal_pending;
+    uint64_t              signal_arrival;
+    uint64_t              transactions;
+#ifdef SPLIT_TRANSACTION_BATCHING
+    uint64_t              unbatched_ns; // the link time of the same scans with a transaction per section
+    int                   corrupt;      // the next transaction with this ID gets a flipped bit in its answer
+#endif
+};
+
+Link                sim;
+std::vector<Stroke> strokes;
+std::vector<int>    transaction_log; // IDs of the transactions the master ran, without a wire
+
+std::vector<Stroke> generate_strokes(void) {
+    std::mt19937                            rng(0x5EED);
+    std::uniform_int_distribution<uint32_t> hold_ms(SPLIT_LATENCY_TAP_MS, 120);
+    std::uniform_int_distribution<uint32_t> gap_us(20000, 80000);
+    std::uniform_int_distribution<uint8_t>  row(0, ROWS_PER_HAND - 1);
+    std::uniform_int_distribution<uint8_t>  col(0, MATRIX_COLS - 1);
+
+    std::vector<Stroke> generated;
+    uint64_t            time = 5000000;
+    for (int i = 0; i < SPLIT_LATENCY_STROKES; i++) {
+        uint64_t held = hold_ms(rng) * 1000000ULL;
+        generated.push_back({time, time + held, (rng() & 1) != 0, row(rng), col(rng)});
+        // Odd gaps, so the presses fall at every point of both loops
+        time += held + gap_us(rng) * 1000ULL + 7919;
+    }
+    return generated;
+}
+
+/* The switches of one half at a given time, the strokes never overlap */
+void sample(bool slave_half, uint64_t time, matrix_row_t rows[]) {
+    std::fill(rows, rows + ROWS_PER_HAND, 0);
+    auto next = std::upper_bound(strokes.begin(), strokes.end(), time, [](uint64_t t, const Stroke &s) { return t < s.press; });
+    if (next != strokes.begin()) {
+        const Stroke &stroke = *(next - 1);
+        if (stroke.slave_half == slave_half && time < stroke.release) {
+            rows[stroke.row] |= MATRIX_ROW_SHIFTER << stroke.col;
+        }
+    }
+}
+
+/* Runs code on the slave, with its own copy of the shared memory */
+template <typename F>
+void as_slave(F code) {
+    split_shared_memory_t master_memory = *split_shmem;
+    *split_shmem                        = sim.slave_memory;
+    code();
+    sim.slave_memory = *split_shmem;
+    *split_shmem     = master_memory;
+}
+
+/* Runs every slave scan that is done by the given time */
+void advance_slave(uint64_t time) {
+    while (sim.slave_next + sim.profile->slave_scan_ns <= time) {
+        matrix_row_t master_matrix[ROWS_PER_HAND] = {0};
+        sample(true, sim.slave_next, sim.slave_scanned);
+        sim.slave_next += sim.profile->slave_scan_ns;
+        as_slave([&] { transactions_slave(master_matrix, sim.slave_scanned); });
+    }
+}
+
+#ifdef SPLIT_LATENCY_WIRE
+/* One end of the simulated wire */
+struct Half {
+    std::deque<uint8_t> rx;
+    bool                waiting;  // blocked in a receive
+    size_t              need;     // bytes that receive asks for
+    uint64_t            timeout;  // how long that receive waits for each byte
+    uint64_t            deadline; // when that receive times out
+};
+
+struct Wire {
+    Half                  master;
+    Half                  slave;
+    bool                  on_slave; // which half is running
+    split_shared_memory_t master_memory;
+    ucontext_t            master_context;
+    ucontext_t            slave_context;
+    void (*slave_thread)(void *);
+    void                 *slave_arg;
+    std::mt19937          noise;
+    bool                  attention; // a token the slave sends once its thread is done with the transaction
+    int                   lose_after; // bytes from the master that still arrive before the rest is lost, or -1
+};
+
+Wire    wire;
+uint8_t slave_stack[256 * 1024];
+
+void run_slave_thread(void) {
+    wire.slave_thread(wire.slave_arg);
+}
+
+/* Hands the wire over to the other half, until that one has to wait */
+void switch_halves(void) {
+    if (wire.on_slave) {
+        sim.slave_memory = *split_shmem;
+        *split_shmem     = wire.master_memory;
+        wire.on_slave    = false;
+        swapcontext(&wire.slave_context, &wire.master_context);
+    } else {
+        // The slave thread sees the slave data as of now
+        advance_slave(sim.now);
+        wire.master_memory = *split_shmem;
+        *split_shmem       = sim.slave_memory;
+        wire.on_slave      = true;
+        swapcontext(&wire.master_context, &wire.slave_context);
+    }
+}
+
+/* Lets the slave give up on every read that timed out while the master was busy elsewhere */
+void settle_slave(void) {
+    while (!wire.on_slave && wire.slave.waiting && wire.slave.rx.size() < wire.slave.need && wire.slave.deadline <= sim.now) {
+        switch_halves();
+    }
+}
+
+bool wire_receive(uint8_t *destination, size_t size, uint64_t timeout) {
+    settle_slave();
+    Half &self = wire.on_slave ? wire.slave : wire.master;
+    Half &peer = wire.on_slave ? wire.master : wire.slave;
+
+#    ifdef SPLIT_MATRIX_PUSH
+    // The slave thread is about to wait for the next transaction, and lets go of the shared memory
+    if (wire.on_slave && timeout == UINT64_MAX && wire.attention) {
+        wire.master.rx.push_back(SERIAL_ATTENTION_TOKEN);
+        wire.attention = false;
+    }
+#    endif
+    self.waiting  = true;
+    self.need     = size;
+    self.timeout  = timeout;
+    self.deadline = timeout == UINT64_MAX ? UINT64_MAX : sim.now + timeout;
+    while (self.rx.size() < size && sim.now < self.deadline) {
+        if (peer.waiting && peer.rx.size() < peer.need && self.deadline <= peer.deadline) {
+            // Both halves wait for each other, and this one gives up first
+            sim.now = self.deadline;
+            break;
+        }
+        switch_halves();
+    }
+    self.waiting = false;
+
+    // A read that times out still takes the bytes that did arrive
+    size_t count = std::min(size, self.rx.size());
+    std::copy_n(self.rx.begin(), count, destination);
+    self.rx.erase(self.rx.begin(), self.rx.begin() + count);
+    set_time(sim.now / 1000000);
+    return count == size;
+}
+
+void reset_wire(void) {
+    wire.master   = Half{};
+    wire.slave    = Half{};
+    wire.on_slave   = false;
+    wire.attention  = false;
+    wire.lose_after = -1;
+    wire.noise.seed(0x5EED);
+    soft_serial_target_init();
+}
+
+#    ifdef SPLIT_LINK_FRAMING
+/* The counters since the given ones */
+split_link_stats_t link_stats_since(const split_link_stats_t &start) {
+    split_link_stats_t stats;
+    transport_link_stats(&stats);
+    stats.transactions -= start.transactions;
+    stats.crc_errors -= start.crc_errors;
+    stats.timeouts -= start.timeouts;
+    stats.retransmits -= start.retransmits;
+    stats.failures -= start.failures;
+    return stats;
+}
+#    endif // SPLIT_LINK_FRAMING
+#endif // SPLIT_LATENCY_WIRE
+
+} // namespace
+
+extern "C" {
+
+bool is_transport_connected(void) {
+    return true;
+}
+
+#ifdef SPLIT_LATENCY_WIRE
+systime_t chVTGetSystemTimeX(void) {
+    return sim.now / 1000;
+}
+
+sysinterval_t chVTTimeElapsedSinceX(systime_t start) {
+    return chVTGetSystemTimeX() - start;
+}
+
+thread_t *chThdCreateStatic(void *working_area, size_t size, uint8_t priority, void (*function)(void *), void *arg) {
+    (void)working_area;
+    (void)size;
+    (void)priority;
+    wire.slave_thread = function;
+    wire.slave_arg    = arg;
+    getcontext(&wire.slave_context);
+    wire.slave_context.uc_stack.ss_sp   = slave_stack;
+    wire.slave_context.uc_stack.ss_size = sizeof(slave_stack);
+    wire.slave_context.uc_link          = NULL;
+    makecontext(&wire.slave_context, run_slave_thread, 0);
+    return NULL;
+}
+
+void serial_transport_driver_slave_init(void) {}
+void serial_transport_driver_master_init(void) {}
+
+void serial_transport_driver_clear(void) {
+    settle_slave();
+#    ifndef SPLIT_LINK_FRAMING
+    // The master starts every transaction with this, and only the framing calls it for anything else
+    if (!wire.on_slave) {
+        sim.transactions++;
+    }
+#    endif
+    (wire.on_slave ? wire.slave : wire.master).rx.clear();
+}
+
+bool serial_transport_send(const uint8_t *source, const size_t size) {
+    settle_slave();
+    Half &peer = wire.on_slave ? wire.master : wire.slave;
+    for (size_t i = 0; i < size; i++) {
+        sim.now += sim.profile->byte_ns;
+        uint32_t roll = wire.noise() % 1000000;
+        if (roll < sim.profile->drop_ppm) {
+            continue;
+        }
+        if (!wire.on_slave && wire.lose_after >= 0 && wire.lose_after-- == 0) {
+            wire.lose_after = 0;
+            continue;
+        }
+        uint8_t byte = source[i];
+        if (roll < sim.profile->drop_ppm + sim.profile->corrupt_ppm) {
+            byte ^= 1 << (wire.noise() % 8);
+        }
+        peer.rx.push_back(byte);
+        // The timeout of a read restarts with every byte that arrives
+        if (peer.waiting && peer.deadline != UINT64_MAX) {
+            peer.deadline = sim.now + peer.timeout;
+        }
+    }
+    set_time(sim.now / 1000000);
+    return true;
+}
+
+bool serial_transport_receive(uint8_t *destination, const size_t size) {
+    return wire_receive(destination, size, SPLIT_LATENCY_TIMEOUT_NS);
+}
+
+bool serial_transport_receive_timeout(uint8_t *destination, const size_t size, uint32_t timeout_us) {
+    return wire_receive(destination, size, timeout_us * 1000ULL);
+}
+
+bool serial_transport_receive_blocking(uint8_t *destination, const size_t size) {
+    bool received = wire_receive(destination, size, UINT64_MAX);
+    // For the slave thread to wake up and answer
+    sim.now += sim.profile->turnaround_ns;
+    return received;
+}
+
+#    ifdef SPLIT_MATRIX_PUSH
+void serial_transport_send_attention(void) {
+    // Sent with the shared memory locked, so it waits for the slave thread to be done with a transaction. The token
+    // itself is spared the noise, the point is that the protocol does not lose it.
+    if (wire.slave.waiting && wire.slave.timeout == UINT64_MAX && wire.slave.rx.empty()) {
+        wire.master.rx.push_back(SERIAL_ATTENTION_TOKEN);
+    } else {
+        wire.attention = true;
+    }
+}
+
+bool serial_transport_receive_attention(void) {
+    // Without a transaction to run, the slave thread finishes the last one, and the slave scans until now are caught
+    // up on, only here
+    while (!wire.on_slave && wire.slave.waiting && (wire.slave.rx.size() >= wire.slave.need || wire.slave.deadline <= sim.now)) {
+        switch_halves();
+    }
+    advance_slave(sim.now);
+    bool attention = std::find(wire.master.rx.begin(), wire.master.rx.end(), SERIAL_ATTENTION_TOKEN) != wire.master.rx.end();
+    wire.master.rx.clear();
+    return attention;
+}
+#    endif // SPLIT_MATRIX_PUSH
+#else  // SPLIT_LATENCY_WIRE
+uint64_t transaction_ns(int index) {
+    split_transaction_desc_t *trans = &split_transaction_table[index];
+    // Transaction ID and handshake, then the buffers
+    uint64_t bytes = 2 + trans->initiator2target_buffer_size + trans->target2initiator_buffer_size;
+    return sim.profile->turnaround_ns + bytes * sim.profile->byte_ns;
+}
+
+#    ifdef SPLIT_TRANSACTION_BATCHING
+/* The transactions the master runs without batching for the same data, reading the slave matrix checksum every scan */
+uint64_t unbatched_ns(int index) {
+    switch (index) {
+        case EXCHANGE_BATCH_HEADER:
+            return transaction_ns(GET_SLAVE_MATRIX_CHECKSUM);
+        case EXCHANGE_BATCH: {
+            uint64_t ns = transaction_ns(GET_SLAVE_MATRIX_CHECKSUM);
+            for (int id = 0; id < NUM_TOTAL_TRANSACTIONS; id++) {
+                if (sim.slave_memory.batch_m2s.dirty & (1UL << id)) {
+                    ns += transaction_ns(id);
+                }
+            }
+            return ns;
+        }
+        case GET_BATCH_S2M:
+            return transaction_ns(GET_SLAVE_MATRIX_DATA);
+        default:
+            return transaction_ns(index);
+    }
+}
+#    endif // SPLIT_TRANSACTION_BATCHING
+
+void soft_serial_initiator_init(void) {}
+void soft_serial_target_init(void) {}
+
+bool soft_serial_transaction(int index) {
+    split_transaction_desc_t *trans = &split_transaction_table[index];
+    uint8_t                  *slave = (uint8_t *)&sim.slave_memory;
+
+    // The slave answers with its data as of the start of the transaction
+    advance_slave(sim.now);
+    memcpy(slave + trans->initiator2target_offset, split_trans_initiator2target_buffer(trans), trans->initiator2target_buffer_size);
+    if (trans->slave_callback) {
+        as_slave([&] { trans->slave_callback(trans->initiator2target_buffer_size, split_trans_initiator2target_buffer(trans), trans->target2initiator_buffer_size, split_trans_target2initiator_buffer(trans)); });
+    }
+    memcpy(split_trans_target2initiator_buffer(trans), slave + trans->target2initiator_offset, trans->target2initiator_buffer_size);
+
+    sim.now += transaction_ns(index);
+    sim.transactions++;
+#    ifdef SPLIT_TRANSACTION_BATCHING
+    sim.unbatched_ns += unbatched_ns(index);
+    if (sim.corrupt == index) {
+        *(uint8_t *)split_trans_target2initiator_buffer(trans) ^= 0x01;
+        sim.corrupt = -1;
+    }
+#    endif // SPLIT_TRANSACTION_BATCHING
+    transaction_log.push_back(index);
+    set_time(sim.now / 1000000);
+    return true;
+}
+#endif // SPLIT_LATENCY_WIRE
+
+#ifdef SPLIT_TRANSACTION_BATCHING
+// The master state handed on to the slave, and what the slave handlers make of it
+uint8_t master_mods;
+uint8_t master_leds;
+uint8_t slave_mods;
+uint8_t slave_leds;
+
+bool is_keyboard_master(void) {
+    return true;
+}
+
+uint8_t get_mods(void) {
+    return master_mods;
+}
+
+uint8_t get_weak_mods(void) {
+    return 0;
+}
+
+uint8_t get_oneshot_mods(void) {
+    return 0;
+}
+
+uint8_t get_oneshot_locked_mods(void) {
+    return 0;
+}
+
+void set_mods(uint8_t mods) {
+    slave_mods = mods;
+}
+
+void set_weak_mods(uint8_t mods) {}
+void set_oneshot_mods(uint8_t mods) {}
+void set_oneshot_locked_mods(uint8_t mods) {}
+
+uint8_t host_keyboard_leds(void) {
+    return master_leds;
+}
+
+void set_split_host_keyboard_leds(uint8_t led_state) {
+    slave_leds = led_state;
+}
+#endif // SPLIT_TRANSACTION_BATCHING
+
+#if defined(SPLIT_MATRIX_PUSH) && !defined(SPLIT_LATENCY_WIRE)
+void soft_serial_target_signal(void) {
+    // Sent at the end of the slave scan that saw the change
+    if (!sim.signal_pending) {
+        sim.signal_pending = true;
+        sim.signal_arrival = sim.slave_next + sim.profile->byte_ns;
+    }
+}
+
+bool soft_serial_initiator_signalled(void) {
+    advance_slave(sim.now);
+    if (sim.signal_pending && sim.signal_arrival <= sim.now) {
+        sim.signal_pending = false;
+        return true;
+    }
+    return false;
+}
+#endif
+}
+
+namespace {
+
+void reset(const Profile &profile) {
+    memset(split_shmem, 0, sizeof(split_shared_memory_t));
+    memset(&sim, 0, sizeof(sim));
+    sim.profile = &profile;
+#ifdef SPLIT_TRANSACTION_BATCHING
+    sim.corrupt = -1;
+#endif
+    transaction_log.clear();
+    set_time(0);
+#ifdef SPLIT_LATENCY_WIRE
+    reset_wire();
+#endif
+}
+
+Result run(const Profile &profile) {
+    Result       result = {};
+    matrix_row_t master_matrix[ROWS_PER_HAND];
+    matrix_row_t slave_matrix[ROWS_PER_HAND];
+    size_t       next_stroke = 0;
+
+    reset(profile);
+#ifdef SPLIT_LINK_FRAMING
+    split_link_stats_t start;
+    transport_link_stats(&start);
+#endif
+
+    uint64_t end = strokes.back().release + 100000000ULL;
+    while (sim.now < end) {
+        sample(false, sim.now, master_matrix);
+        set_time(sim.now / 1000000);
+        uint64_t transport_start = sim.now;
+        transactions_master(master_matrix, slave_matrix);
+        result.link_ns += sim.now - transport_start;
+        result.loops++;
+
+        // A press is seen once the master hands it on, right after the transport
+        while (next_stroke < strokes.size() && strokes[next_stroke].press <= sim.now) {
+            const Stroke &stroke = strokes[next_stroke];
+            matrix_row_t *rows   = stroke.slave_half ? slave_matrix : master_matrix;
+            if (rows[stroke.row] & (MATRIX_ROW_SHIFTER << stroke.col)) {
+                (stroke.slave_half ? result.slave_latency : result.master_latency).push_back(sim.now - stroke.press);
+                next_stroke++;
+            } else if (stroke.release <= sim.now) {
+                result.missed++;
+                next_stroke++;
+            } else {
+                break;
+            }
+        }
+
+        sim.now += profile.master_scan_ns;
+    }
+
+#ifdef SPLIT_LINK_FRAMING
+    result.link         = link_stats_since(start);
+    result.transactions = result.link.transactions + result.link.failures;
+#else
+    result.transactions = sim.transactions;
+#endif
+#ifdef SPLIT_TRANSACTION_BATCHING
+    result.unbatched_ns = sim.unbatched_ns;
+#endif
+    return result;
+}
+
+uint64_t percentile(std::vector<uint64_t> &values, unsigned pct) {
+    if (values.empty()) {
+        return 0;
+    }
+    std::sort(values.begin(), values.end());
+    return values[(values.size() - 1) * pct / 100];
+}
+
+std::string latencies(std::vector<uint64_t> &values) {
+    char buffer[48];
+    snprintf(buffer, sizeof(buffer), "%llu/%llu/%llu", (unsigned long long)percentile(values, 50) / 1000, (unsigned long long)percentile(values, 99) / 1000, (unsigned long long)percentile(values, 100) / 1000);
+    return buffer;
+}
+
+} // namespace
+
+TEST(SplitLatencySimulation, Profiles) {
+    strokes = generate_strokes();
+
+    printf("split latency simulation: %s, %d rows x %d cols per hand, %d presses, latencies in us\n", SPLIT_LATENCY_MODE, ROWS_PER_HAND, MATRIX_COLS, SPLIT_LATENCY_STROKES);
+    printf("| %-11s | %-22s | %9s | %10s | %7s | %-21s | %-21s | %6s |", "mode", "profile", "loops/ms", "trans/loop", "link us", "master p50/p99/max", "slave p50/p99/max", "missed");
+#ifdef SPLIT_LINK_FRAMING
+    printf(" %-23s |", "crc/timeout/retx/failed");
+#endif
+#ifdef SPLIT_TRANSACTION_BATCHING
+    printf(" %12s |", "unbatched us");
+#endif
+    printf("\n");
+
+    for (auto &profile : profiles) {
+        Result result = run(profile);
+        double ms     = sim.now / 1e6;
+
+        printf("| %-11s | %-22s | %9.2f | %10.2f | %7.1f | %-21s | %-21s | %6u |", SPLIT_LATENCY_MODE, profile.name, result.loops / ms, (double)result.transactions / result.loops, result.link_ns / 1e3 / result.loops, latencies(result.master_latency).c_str(), latencies(result.slave_latency).c_str(), result.missed);
+#ifdef SPLIT_LINK_FRAMING
+        printf(" %5u/%5u/%5u/%5u |", result.link.crc_errors, result.link.timeouts, result.link.retransmits, result.link.failures);
+#endif
+#ifdef SPLIT_TRANSACTION_BATCHING
+        printf(" %12.1f |", result.unbatched_ns / 1e3 / result.loops);
+#endif
+        printf("\n");
+#ifdef SPLIT_TRANSACTION_BATCHING
+        // An idle scan costs as much as polling the slave matrix checksum, and the forced syncs share a frame
+        EXPECT_LT(result.link_ns, result.unbatched_ns) << profile.name;
+#endif
+#ifdef SPLIT_LATENCY_WIRE
+        if (profile.drop_ppm || profile.corrupt_ppm) {
+            uint64_t worst = std::max(percentile(result.master_latency, 100), percentile(result.slave_latency, 100));
+#    ifdef SPLIT_LINK_FRAMING
+            // A failed buffer is sent again within SPLIT_LINK_BYTE_TIMEOUT, well before the shortest tap is over
+            EXPECT_GT(result.link.crc_errors + result.link.timeouts, 0u) << profile.name;
+            EXPECT_LT(worst, SPLIT_LATENCY_TAP_MS * 1000000ULL / 2) << profile.name;
+#    else
+            // Without the framing, a lost byte stalls the link for a whole SERIAL_USART_TIMEOUT
+            EXPECT_GE(worst, SPLIT_LATENCY_TIMEOUT_NS) << profile.name;
+#    endif
+        }
+#endif
+        EXPECT_EQ(result.missed, 0u) << profile.name;
+    }
+}
+
+#ifdef SPLIT_LINK_FRAMING
+TEST(SplitLinkFraming, Crc16CheckValue) {
+    // CRC-16/CCITT-FALSE
+    EXPECT_EQ(crc16("123456789", 9), 0x29B1);
+    EXPECT_EQ(crc16_update(crc16("1234", 4), "56789", 5), 0x29B1);
+    EXPECT_EQ(crc16("", 0), 0xFFFF);
+}
+
+namespace {
+
+std::vector<uint32_t> applied_counters;
+
+void apply_counter(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer) {
+    uint32_t counter;
+    memcpy(&counter, initiator2target_buffer, sizeof(counter));
+    applied_counters.push_back(counter);
+}
+
+} // namespace
+
+TEST(SplitLinkFraming, NoisyLinkAppliesEveryTransactionOnce) {
+    // Roughly one transaction in ten loses or corrupts a byte somewhere, in either direction
+    const Profile noisy   = {"noisy", 10850, 20000, 200000, 200000, 5000, 5000};
+    const int     retries = 10; // as many as transaction_handler_master() makes
+
+    reset(noisy);
+    split_link_stats_t start;
+    transport_link_stats(&start);
+    split_transaction_table[SPLIT_LATENCY_COUNTER] = {sizeof(uint32_t), offsetof(split_shared_memory_t, rpc_m2s_buffer), 0, 0, apply_counter};
+    applied_counters.clear();
+
+    std::vector<uint64_t> latency;
+    for (uint32_t counter = 0; counter < 2000; counter++) {
+        uint64_t sent  = sim.now;
+        int      tries = 1;
+        // A transaction that failed is retried as it is, the slave applies it only if it did not already
+        while (!transport_execute_transaction(SPLIT_LATENCY_COUNTER, &counter, sizeof(counter), NULL, 0)) {
+            ASSERT_LT(tries++, retries) << "counter " << counter;
+        }
+        latency.push_back(sim.now - sent);
+        sim.now += noisy.master_scan_ns;
+    }
+
+    split_link_stats_t stats = link_stats_since(start);
+    printf("noisy link: %u transactions, %u CRC errors, %u timeouts, %u retransmits, %u failures, latency p50/p99/max %s us\n", (unsigned)stats.transactions, stats.crc_errors, stats.timeouts, stats.retransmits, stats.failures, latencies(latency).c_str());
+
+    std::vector<uint32_t> expected(2000);
+    std::iota(expected.begin(), expected.end(), 0);
+    EXPECT_EQ(applied_counters, expected);
+
+    EXPECT_GT(stats.crc_errors, 0);
+    EXPECT_GT(stats.timeouts, 0);
+    EXPECT_GT(stats.retransmits, 0);
+    EXPECT_GT(stats.failures, 0);
+    // Every buffer is sent at most 1 + SPLIT_LINK_RETRANSMITS times, and without a callback to run the slave answers each
+    // within twice SPLIT_LINK_BYTE_TIMEOUT
+    EXPECT_LE(percentile(latency, 100), (uint64_t)retries * (1 + SPLIT_LINK_RETRANSMITS) * 3 * SPLIT_LINK_BYTE_TIMEOUT * 1000);
+}
+
+#    ifdef SPLIT_MATRIX_PUSH
+TEST(SplitLinkFraming, AttentionTokenOutlivesFailedTransaction) {
+    reset(profiles[0]);
+    split_transaction_table[SPLIT_LATENCY_COUNTER] = {sizeof(uint32_t), offsetof(split_shared_memory_t, rpc_m2s_buffer), 0, 0, apply_counter};
+    uint32_t counter                               = 0;
+    ASSERT_TRUE(transport_execute_transaction(SPLIT_LATENCY_COUNTER, &counter, sizeof(counter), NULL, 0));
+    transport_slave_signalled();
+
+    // The slave signals while its thread waits for a buffer that never arrives, so the token goes out once it gave up,
+    // right into the answer the master waits for and the drain after it
+    wire.attention  = true;
+    wire.lose_after = 2;
+    EXPECT_FALSE(transport_execute_transaction(SPLIT_LATENCY_COUNTER, &counter, sizeof(counter), NULL, 0));
+    wire.lose_after = -1;
+    EXPECT_FALSE(wire.attention);
+    EXPECT_TRUE(transport_slave_signalled());
+}
+#    endif // SPLIT_MATRIX_PUSH
+#endif // SPLIT_LINK_FRAMING
+
+#ifdef SPLIT_TRANSACTION_BATCHING
+namespace {
+
+matrix_row_t batch_master_matrix[ROWS_PER_HAND];
+matrix_row_t batch_slave_matrix[ROWS_PER_HAND];
+
+/* Runs one master scan a millisecond after the previous one, returning the transactions it ran */
+std::vector<int> batch_scan(void) {
+    transaction_log.clear();
+    sim.now += 1000000;
+    set_time(sim.now / 1000000);
+    transactions_master(batch_master_matrix, batch_slave_matrix);
+    return transaction_log;
+}
+
+} // namespace
+
+TEST(SplitTransactionBatching, SlaveReceivesDirtySectionsTogether) {
+    // The master matrix and mods take 4 bytes each and the LED state one, in a payload of 9
+    static_assert(SPLIT_BATCH_M2S_BUFFER_SIZE == 9, "the sections below are sized for this payload");
+    reset(profiles[0]);
+    memset(batch_master_matrix, 0, sizeof(batch_master_matrix));
+    master_mods = 0;
+    master_leds = 0;
+    for (int i = 0; i < 3; i++) {
+        batch_scan();
+    }
+    EXPECT_EQ(batch_scan(), std::vector<int>({EXCHANGE_BATCH_HEADER}));
+
+    // Everything changes in the same scan
+    batch_master_matrix[1] = 0x81;
+    master_leds            = 0x02;
+    master_mods            = 0x20;
+    EXPECT_EQ(batch_scan(), std::vector<int>({EXCHANGE_BATCH}));
+    EXPECT_EQ(sim.slave_memory.mmatrix.matrix[1], 0x81);
+    EXPECT_EQ(sim.slave_memory.led_state, 0x02);
+    EXPECT_EQ(sim.slave_memory.mods.real_mods, 0x20);
+
+    // Two sections take fewer bytes as transactions of their own than the whole frame
+    batch_master_matrix[1] = 0x01;
+    master_leds            = 0x06;
+    EXPECT_EQ(batch_scan(), std::vector<int>({PUT_MASTER_MATRIX, PUT_LED_STATE, EXCHANGE_BATCH_HEADER}));
+    EXPECT_EQ(sim.slave_memory.mmatrix.matrix[1], 0x01);
+    EXPECT_EQ(sim.slave_memory.led_state, 0x06);
+    EXPECT_EQ(batch_scan(), std::vector<int>({EXCHANGE_BATCH_HEADER}));
+
+    // The slave handlers apply it all with the next slave scan
+    advance_slave(sim.now + sim.profile->slave_scan_ns);
+    EXPECT_EQ(slave_mods, 0x20);
+    EXPECT_EQ(slave_leds, 0x06);
+}
+
+TEST(SplitTransactionBatching, SlaveAnswerOnlyFetchedWhenChanged) {
+    reset(profiles[0]);
+    memset(batch_master_matrix, 0, sizeof(batch_master_matrix));
+    for (int i = 0; i < 3; i++) {
+        batch_scan();
+    }
+    EXPECT_EQ(batch_scan(), std::vector<int>({EXCHANGE_BATCH_HEADER}));
+
+    // A key held on the slave changes the checksum it answers with
+    strokes = {{sim.now, sim.now + 50000000, true, 2, 3}};
+    advance_slave(sim.now + sim.profile->slave_scan_ns);
+    EXPECT_EQ(batch_scan(), std::vector<int>({EXCHANGE_BATCH_HEADER, GET_BATCH_S2M}));
+    EXPECT_EQ(batch_slave_matrix[2], MATRIX_ROW_SHIFTER << 3);
+    EXPECT_EQ(batch_scan(), std::vector<int>({EXCHANGE_BATCH_HEADER}));
+    EXPECT_EQ(batch_slave_matrix[2], MATRIX_ROW_SHIFTER << 3);
+
+    // An answer that does not match its checksum is fetched again, with a new exchange
+    sim.now += 50000000;
+    advance_slave(sim.now + sim.profile->slave_scan_ns);
+    sim.corrupt = GET_BATCH_S2M;
+    EXPECT_EQ(batch_scan(), std::vector<int>({EXCHANGE_BATCH_HEADER, GET_BATCH_S2M, EXCHANGE_BATCH_HEADER, GET_BATCH_S2M}));
+    EXPECT_EQ(batch_slave_matrix[2], 0);
+    strokes.clear();
+}
+
+TEST(SplitTransactionBatching, SyncTimerRunsOnItsOwn) {
+    reset(profiles[0]);
+    for (int i = 0; i < 3; i++) {
+        batch_scan();
+    }
+
+    // Once FORCED_SYNC_THROTTLE_MS has passed, every section is sent again, and the sync timer ahead of the batch
+    sim.now += 100000000;
+    EXPECT_EQ(batch_scan(), std::vector<int>({PUT_SYNC_TIMER, EXCHANGE_BATCH, GET_BATCH_S2M}));
+    EXPECT_NE(sim.slave_memory.sync_timer, 0u);
+}
+#endif // SPLIT_TRANSACTION_BATCHING
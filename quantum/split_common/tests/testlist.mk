@@ -0,0 +1,7 @@
+TEST_LIST += \
+	split_latency_poll \
+	split_latency_push \
+	split_latency_framed \
+	split_latency_framed_push \
+	split_latency_serial \
+	split_latency_batched
@@ -23,6 +23,12 @@ enum serial_transaction_id {
     I2C_EXECUTE_CALLBACK,
 #endif // USE_I2C
 
+#ifdef SPLIT_TRANSACTION_BATCHING
+    EXCHANGE_BATCH_HEADER,
+    EXCHANGE_BATCH,
+    GET_BATCH_S2M,
+#endif // SPLIT_TRANSACTION_BATCHING
+
     GET_SLAVE_MATRIX_CHECKSUM,
     GET_SLAVE_MATRIX_DATA,
 
@@ -81,9 +81,19 @@
 
 #define trans_initiator2target_cb(cb) {0, 0, 0, 0, cb}
 
-#define transport_write(id, data, length) transport_execute_transaction(id, data, length, NULL, 0)
-#define transport_read(id, data, length) transport_execute_transaction(id, NULL, 0, data, length)
-#define transport_exec(id) transport_execute_transaction(id, NULL, 0, NULL, 0)
+#define trans_exchange_initializer_cb(initiator2target_size, initiator2target_member, target2initiator_member, cb) {initiator2target_size, offsetof(split_shared_memory_t, initiator2target_member), sizeof_member(split_shared_memory_t, target2initiator_member), offsetof(split_shared_memory_t, target2initiator_member), cb}
+
+#ifdef SPLIT_TRANSACTION_BATCHING
+// Handlers only read and write the shared memory, which goes across in a single exchange per scan
+static bool transport_execute_batched(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length);
+#    define transport_write(id, data, length) transport_execute_batched(id, data, length, NULL, 0)
+#    define transport_read(id, data, length) transport_execute_batched(id, NULL, 0, data, length)
+#    define transport_exec(id) transport_execute_batched(id, NULL, 0, NULL, 0)
+#else // SPLIT_TRANSACTION_BATCHING
+#    define transport_write(id, data, length) transport_execute_transaction(id, data, length, NULL, 0)
+#    define transport_read(id, data, length) transport_execute_transaction(id, NULL, 0, data, length)
+#    define transport_exec(id) transport_execute_transaction(id, NULL, 0, NULL, 0)
+#endif // SPLIT_TRANSACTION_BATCHING
 
 #if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
 // Forward-declare the RPC callback handlers
@@ -107,6 +117,11 @@ static bool transaction_handler_master(matrix_row_t master_matrix[], matrix_row_
         if (this_okay) return true;
     }
     dprintf("Failed to execute %s\n", prefix);
+#ifdef SPLIT_LINK_FRAMING
+    split_link_stats_t stats;
+    transport_link_stats(&stats);
+    dprintf("Split link: %lu transactions, %u CRC errors, %u timeouts, %u retransmits, %u failures, RTT %uus (max %uus)\n", (unsigned long)stats.transactions, stats.crc_errors, stats.timeouts, stats.retransmits, stats.failures, stats.rtt_us, stats.rtt_max_us);
+#endif // SPLIT_LINK_FRAMING
     return false;
 }
 
@@ -142,6 +157,10 @@ static bool transaction_handler_master(matrix_row_t master_matrix[], matrix_row_
     } while (0)
 
 inline static bool read_if_checksum_mismatch(int8_t trans_id_checksum, int8_t trans_id_retrieve, uint32_t *last_update, void *destination, const void *equiv_shmem, size_t length) {
+#ifdef SPLIT_TRANSACTION_BATCHING
+    // The exchange checks the answer as a whole, and already fetches it again once FORCED_SYNC_THROTTLE_MS has passed
+    return transport_read(trans_id_retrieve, destination, length);
+#else  // SPLIT_TRANSACTION_BATCHING
     uint8_t curr_checksum;
     bool    okay = transport_read(trans_id_checksum, &curr_checksum, sizeof(curr_checksum));
     if (okay && (timer_elapsed32(*last_update) >= FORCED_SYNC_THROTTLE_MS || curr_checksum != crc8(equiv_shmem, length))) {
@@ -154,6 +173,7 @@ inline static bool read_if_checksum_mismatch(int8_t trans_id_checksum, int8_t tr
         memcpy(destination, equiv_shmem, length);
     }
     return okay;
+#endif // SPLIT_TRANSACTION_BATCHING
 }
 
 inline static bool send_if_condition(int8_t trans_id, uint32_t *last_update, bool condition, void *source, size_t length) {
@@ -172,6 +192,180 @@ inline static bool send_if_data_mismatch(int8_t trans_id, uint32_t *last_update,
     return send_if_condition(trans_id, last_update, (memcmp(source, equiv_shmem, length) != 0), source, length);
 }
 
+////////////////////////////////////////////////////
+// Batching
+
+#ifdef SPLIT_TRANSACTION_BATCHING
+
+// Transaction buffer sizes are 8 bits wide
+STATIC_ASSERT(sizeof(split_batch_m2s_t) <= UINT8_MAX, "SPLIT_BATCH_M2S_BUFFER_SIZE too large");
+STATIC_ASSERT(sizeof_member(split_shared_memory_t, batch_s2m) <= UINT8_MAX, "Slave to master batch too large");
+
+static uint32_t batch_dirty = 0; // written by the handlers since the last exchange, by transaction ID
+
+// Transactions that only carry data from master to slave, as long as it fits in a batch
+static bool transaction_is_batched_put(int8_t id) {
+    split_transaction_desc_t *trans = &split_transaction_table[id];
+#    if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
+    if (id >= PUT_RPC_INFO && id <= GET_RPC_RESP_DATA) return false;
+#    endif // defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
+#    ifndef DISABLE_SYNC_TIMER
+    // SYNC_TIMER_OFFSET makes up for the time a transaction of its own takes, not for waiting on the batch
+    if (id == PUT_SYNC_TIMER) return false;
+#    endif // DISABLE_SYNC_TIMER
+    return trans->initiator2target_buffer_size && trans->initiator2target_buffer_size <= SPLIT_BATCH_M2S_BUFFER_SIZE && !trans->target2initiator_buffer_size && !trans->slave_callback;
+}
+
+// The answer is checked as a whole, so the checksums of its sections are left out of it
+static bool transaction_is_checksum(int8_t id) {
+    switch (id) {
+        case GET_SLAVE_MATRIX_CHECKSUM:
+#    ifdef ENCODER_ENABLE
+        case GET_ENCODERS_CHECKSUM:
+#    endif // ENCODER_ENABLE
+#    if defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
+        case GET_POINTING_CHECKSUM:
+#    endif // defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
+            return true;
+        default:
+            return false;
+    }
+}
+
+// Transactions that only carry data from slave to master
+static bool transaction_is_batched_get(int8_t id) {
+    split_transaction_desc_t *trans = &split_transaction_table[id];
+#    if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
+    if (id >= PUT_RPC_INFO && id <= GET_RPC_RESP_DATA) return false;
+#    endif // defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
+    if (id == GET_BATCH_S2M || transaction_is_checksum(id)) return false;
+    return !trans->initiator2target_buffer_size && trans->target2initiator_buffer_size && !trans->slave_callback;
+}
+
+static bool transport_execute_batched(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length) {
+    split_transaction_desc_t *trans = &split_transaction_table[id];
+    if (transaction_is_batched_put(id)) {
+        // Sent along with the next exchange
+        size_t len = trans->initiator2target_buffer_size < initiator2target_length ? trans->initiator2target_buffer_size : initiator2target_length;
+        memcpy(split_trans_initiator2target_buffer(trans), initiator2target_buf, len);
+        batch_dirty |= 1UL << id;
+        return true;
+    }
+    if (transaction_is_batched_get(id)) {
+        // Received by the exchange of the previous scan, or of this one for the slave matrix
+        size_t len = trans->target2initiator_buffer_size < target2initiator_length ? trans->target2initiator_buffer_size : target2initiator_length;
+        memcpy(target2initiator_buf, split_trans_target2initiator_buffer(trans), len);
+        return true;
+    }
+    // Commands, such as draining the encoder queue, and RPC still run right away
+    return transport_execute_transaction(id, initiator2target_buf, initiator2target_length, target2initiator_buf, target2initiator_length);
+}
+
+static bool batch_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    static uint32_t   last_update   = 0;
+    static uint8_t    last_checksum = 0;
+    static bool       answered      = false;
+    split_batch_m2s_t batch         = {0};
+    uint8_t           length        = 0;
+    uint16_t          own_bytes     = 0;
+
+    // The payload is packed in ID order, with whatever still fits
+    for (int8_t id = 0; id < NUM_TOTAL_TRANSACTIONS; ++id) {
+        split_transaction_desc_t *trans = &split_transaction_table[id];
+        if ((batch_dirty & (1UL << id)) && length + trans->initiator2target_buffer_size <= SPLIT_BATCH_M2S_BUFFER_SIZE) {
+            memcpy(&batch.payload[length], split_trans_initiator2target_buffer(trans), trans->initiator2target_buffer_size);
+            length += trans->initiator2target_buffer_size;
+            own_bytes += 2 + trans->initiator2target_buffer_size;
+            batch.dirty |= 1UL << id;
+        }
+    }
+
+    // The frame has a fixed size, so it is only worth sending when the sections would take more bytes as transactions
+    // of their own, transaction ID and handshake included. Their turnarounds are left out, so batching never costs more.
+    if (own_bytes <= sizeof(batch)) {
+        batch.dirty = 0;
+    }
+    for (int8_t id = 0; id < NUM_TOTAL_TRANSACTIONS; ++id) {
+        if ((batch_dirty & ~batch.dirty) & (1UL << id)) {
+            split_transaction_desc_t *trans = &split_transaction_table[id];
+            uint8_t                   data[SPLIT_BATCH_M2S_BUFFER_SIZE];
+            memcpy(data, split_trans_initiator2target_buffer(trans), trans->initiator2target_buffer_size);
+            if (!transport_execute_transaction(id, data, trans->initiator2target_buffer_size, NULL, 0)) {
+                return false;
+            }
+            batch_dirty &= ~(1UL << id);
+        }
+    }
+
+    // Without anything to send, the slave only answers with the checksum of its sections
+    uint8_t checksum;
+    bool    okay = batch.dirty ? transport_execute_transaction(EXCHANGE_BATCH, &batch, sizeof(batch), &checksum, sizeof(checksum)) : transport_execute_transaction(EXCHANGE_BATCH_HEADER, NULL, 0, &checksum, sizeof(checksum));
+    if (!okay) {
+        return false;
+    }
+    batch_dirty &= ~batch.dirty;
+
+    // The sections themselves only come across once they changed, or FORCED_SYNC_THROTTLE_MS has passed. A mismatch
+    // fails the handler, so that its retry runs the exchange again rather than reading the same answer.
+    if (!answered || checksum != last_checksum || timer_elapsed32(last_update) >= FORCED_SYNC_THROTTLE_MS) {
+        uint8_t answer[sizeof_member(split_shared_memory_t, batch_s2m)];
+        if (!transport_execute_transaction(GET_BATCH_S2M, NULL, 0, answer, sizeof(answer)) || crc8(answer, sizeof(answer)) != checksum) {
+            return false;
+        }
+
+        length = 0;
+        for (int8_t id = 0; id < NUM_TOTAL_TRANSACTIONS; ++id) {
+            if (transaction_is_batched_get(id)) {
+                split_transaction_desc_t *trans = &split_transaction_table[id];
+                memcpy(split_trans_target2initiator_buffer(trans), &answer[length], trans->target2initiator_buffer_size);
+                length += trans->target2initiator_buffer_size;
+            }
+        }
+        answered      = true;
+        last_checksum = checksum;
+        last_update   = timer_read32();
+    }
+    return true;
+}
+
+static void batch_handlers_slave_exchange(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer) {
+    const split_batch_m2s_t *batch  = (const split_batch_m2s_t *)initiator2target_buffer;
+    uint8_t                  length = 0;
+    for (int8_t id = 0; initiator2target_buffer_size && id < NUM_TOTAL_TRANSACTIONS; ++id) {
+        if ((batch->dirty & (1UL << id)) && transaction_is_batched_put(id)) {
+            split_transaction_desc_t *trans = &split_transaction_table[id];
+            memcpy(split_trans_initiator2target_buffer(trans), &batch->payload[length], trans->initiator2target_buffer_size);
+            length += trans->initiator2target_buffer_size;
+        }
+    }
+
+    // The answer is made up of the data the slave handlers last prepared, and kept for the master to fetch
+    length = 0;
+    for (int8_t id = 0; id < NUM_TOTAL_TRANSACTIONS; ++id) {
+        if (transaction_is_batched_get(id)) {
+            split_transaction_desc_t *trans = &split_transaction_table[id];
+            memcpy(&split_shmem->batch_s2m[length], split_trans_target2initiator_buffer(trans), trans->target2initiator_buffer_size);
+            length += trans->target2initiator_buffer_size;
+        }
+    }
+    split_shmem->batch_s2m_checksum = crc8(split_shmem->batch_s2m, sizeof(split_shmem->batch_s2m));
+}
+
+// clang-format off
+#    define TRANSACTIONS_BATCH_MASTER() TRANSACTION_HANDLER_MASTER(batch)
+#    define TRANSACTIONS_BATCH_REGISTRATIONS \
+    [EXCHANGE_BATCH_HEADER] = trans_target2initiator_initializer_cb(batch_s2m_checksum, batch_handlers_slave_exchange), \
+    [EXCHANGE_BATCH]        = trans_exchange_initializer_cb(sizeof(split_batch_m2s_t), batch_m2s, batch_s2m_checksum, batch_handlers_slave_exchange), \
+    [GET_BATCH_S2M]         = trans_target2initiator_initializer(batch_s2m),
+// clang-format on
+
+#else // SPLIT_TRANSACTION_BATCHING
+
+#    define TRANSACTIONS_BATCH_MASTER()
+#    define TRANSACTIONS_BATCH_REGISTRATIONS
+
+#endif // SPLIT_TRANSACTION_BATCHING
+
 ////////////////////////////////////////////////////
 // Slave matrix
 
@@ -180,10 +374,23 @@ static bool slave_matrix_handlers_master(matrix_row_t master_matrix[], matrix_ro
     static matrix_row_t last_matrix[(MATRIX_ROWS) / 2] = {0}; // last successfully-read matrix, so we can replicate if there are checksum errors
     matrix_row_t        temp_matrix[(MATRIX_ROWS) / 2];       // holding area while we test whether or not checksum is correct
 
+#ifdef SPLIT_MATRIX_PUSH
+    // Until the slave signals a change, only the forced sync reads its matrix
+    static bool pending = true;
+    pending |= transport_slave_signalled();
+    if (!pending && timer_elapsed32(last_update) < FORCED_SYNC_THROTTLE_MS) {
+        memcpy(slave_matrix, last_matrix, sizeof(last_matrix));
+        return true;
+    }
+#endif // SPLIT_MATRIX_PUSH
+
     bool okay = read_if_checksum_mismatch(GET_SLAVE_MATRIX_CHECKSUM, GET_SLAVE_MATRIX_DATA, &last_update, temp_matrix, split_shmem->smatrix.matrix, sizeof(split_shmem->smatrix.matrix));
     if (okay) {
         // Checksum matches the received data, save as the last matrix state
         memcpy(last_matrix, temp_matrix, sizeof(temp_matrix));
+#ifdef SPLIT_MATRIX_PUSH
+        pending = false;
+#endif // SPLIT_MATRIX_PUSH
     }
     // Copy out the last-known-good matrix state to the slave matrix
     memcpy(slave_matrix, last_matrix, sizeof(last_matrix));
@@ -191,6 +398,12 @@ static bool slave_matrix_handlers_master(matrix_row_t master_matrix[], matrix_ro
 }
 
 static void slave_matrix_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+#ifdef SPLIT_MATRIX_PUSH
+    // Called with the shared memory locked, so the signal never lands in the middle of a transaction
+    if (memcmp(split_shmem->smatrix.matrix, slave_matrix, sizeof(split_shmem->smatrix.matrix)) != 0) {
+        transport_signal_master();
+    }
+#endif // SPLIT_MATRIX_PUSH
     memcpy(split_shmem->smatrix.matrix, slave_matrix, sizeof(split_shmem->smatrix.matrix));
     split_shmem->smatrix.checksum = crc8(split_shmem->smatrix.matrix, sizeof(split_shmem->smatrix.matrix));
 }
@@ -922,6 +1135,7 @@ split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS] = {
 #endif // USE_I2C
 
     // clang-format off
+    TRANSACTIONS_BATCH_REGISTRATIONS
     TRANSACTIONS_SLAVE_MATRIX_REGISTRATIONS
     TRANSACTIONS_MASTER_MATRIX_REGISTRATIONS
     TRANSACTIONS_ENCODERS_REGISTRATIONS
@@ -952,7 +1166,9 @@ split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS] = {
 };
 
 bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+#ifndef SPLIT_TRANSACTION_BATCHING
     TRANSACTIONS_SLAVE_MATRIX_MASTER();
+#endif // SPLIT_TRANSACTION_BATCHING
     TRANSACTIONS_MASTER_MATRIX_MASTER();
     TRANSACTIONS_ENCODERS_MASTER();
     TRANSACTIONS_SYNC_TIMER_MASTER();
@@ -971,6 +1187,12 @@ bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix
     TRANSACTIONS_HAPTIC_MASTER();
     TRANSACTIONS_ACTIVITY_MASTER();
     TRANSACTIONS_DETECTED_OS_MASTER();
+#ifdef SPLIT_TRANSACTION_BATCHING
+    // Once every handler has staged its data, so that it reaches the slave within this scan, and the slave matrix is
+    // read from the answer
+    TRANSACTIONS_BATCH_MASTER();
+    TRANSACTIONS_SLAVE_MATRIX_MASTER();
+#endif // SPLIT_TRANSACTION_BATCHING
     return true;
 }
 
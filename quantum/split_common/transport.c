@@ -87,6 +87,22 @@ bool transport_execute_transaction(int8_t id, const void *initiator2target_buf,
     return true;
 }
 
+#    ifdef SPLIT_MATRIX_PUSH
+// The slave cannot start anything on the bus, so the master keeps polling
+void transport_signal_master(void) {}
+
+bool transport_slave_signalled(void) {
+    return true;
+}
+#    endif // SPLIT_MATRIX_PUSH
+
+#    ifdef SPLIT_LINK_FRAMING
+// Nothing is framed, the I2C peripheral does its own error handling
+void transport_link_stats(split_link_stats_t *stats) {
+    memset(stats, 0, sizeof(split_link_stats_t));
+}
+#    endif // SPLIT_LINK_FRAMING
+
 #else // USE_I2C
 
 #    include "serial.h"
@@ -120,6 +136,34 @@ bool transport_execute_transaction(int8_t id, const void *initiator2target_buf,
     return true;
 }
 
+#    ifdef SPLIT_MATRIX_PUSH
+// Drivers that cannot signal outside of a transaction, such as half-duplex ones, leave the master polling
+__attribute__((weak)) void soft_serial_target_signal(void) {}
+
+__attribute__((weak)) bool soft_serial_initiator_signalled(void) {
+    return true;
+}
+
+void transport_signal_master(void) {
+    soft_serial_target_signal();
+}
+
+bool transport_slave_signalled(void) {
+    return soft_serial_initiator_signalled();
+}
+#    endif // SPLIT_MATRIX_PUSH
+
+#    ifdef SPLIT_LINK_FRAMING
+// Drivers with their own protocol, such as bitbang, send unframed buffers
+__attribute__((weak)) void soft_serial_link_stats(split_link_stats_t *stats) {
+    memset(stats, 0, sizeof(split_link_stats_t));
+}
+
+void transport_link_stats(split_link_stats_t *stats) {
+    soft_serial_link_stats(stats);
+}
+#    endif // SPLIT_LINK_FRAMING
+
 #endif // USE_I2C
 
 bool transport_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
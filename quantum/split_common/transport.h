@@ -22,6 +22,7 @@
 #include "progmem.h"
 #include "action_layer.h"
 #include "matrix.h"
+#include "util.h"
 
 #ifndef RPC_M2S_BUFFER_SIZE
 #    define RPC_M2S_BUFFER_SIZE 32
@@ -31,6 +32,12 @@
 #    define RPC_S2M_BUFFER_SIZE 32
 #endif // RPC_S2M_BUFFER_SIZE
 
+// Room for the changed sections in an exchange, which sends all of it whenever it is used. Sections that do not fit,
+// or would take fewer bytes as transactions of their own, are sent that way.
+#ifndef SPLIT_BATCH_M2S_BUFFER_SIZE
+#    define SPLIT_BATCH_M2S_BUFFER_SIZE 32
+#endif // SPLIT_BATCH_M2S_BUFFER_SIZE
+
 void transport_master_init(void);
 void transport_slave_init(void);
 
@@ -40,6 +47,28 @@ void transport_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]);
 
 bool transport_execute_transaction(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length);
 
+#ifdef SPLIT_MATRIX_PUSH
+// slave side, tells the master that the slave matrix changed
+void transport_signal_master(void);
+// master side, returns true if the slave matrix may have changed since the last call
+bool transport_slave_signalled(void);
+#endif // SPLIT_MATRIX_PUSH
+
+#ifdef SPLIT_LINK_FRAMING
+typedef struct _split_link_stats_t {
+    uint32_t transactions; // completed transactions
+    uint16_t crc_errors;   // corrupted buffers, whichever half noticed
+    uint16_t timeouts;     // buffers or answers cut short by a timeout
+    uint16_t retransmits;  // buffers sent again after a corrupted one
+    uint16_t failures;     // transactions given up on
+    uint16_t rtt_us;       // duration of the last completed transaction
+    uint16_t rtt_max_us;   // longest completed transaction
+} split_link_stats_t;
+
+// master side, link-quality counters since boot, all zero for transports without framing
+void transport_link_stats(split_link_stats_t *stats);
+#endif // SPLIT_LINK_FRAMING
+
 #ifdef ENCODER_ENABLE
 #    include "encoder.h"
 #endif // ENCODER_ENABLE
@@ -147,11 +176,37 @@ typedef struct _rpc_sync_info_t {
 #    include "os_detection.h"
 #endif // defined(OS_DETECTION_ENABLE) && defined(SPLIT_DETECTED_OS_ENABLE)
 
+#ifdef SPLIT_TRANSACTION_BATCHING
+// Packed, as it goes across whole and the payload size is up to the keyboard
+typedef struct PACKED _split_batch_m2s_t {
+    uint32_t dirty; // one bit per transaction ID, its data is packed into the payload in ID order
+    uint8_t  payload[SPLIT_BATCH_M2S_BUFFER_SIZE];
+} split_batch_m2s_t;
+
+// Only used for its size: the slave answers with every section the master reads, packed back to back without their
+// checksums
+typedef struct _split_batch_s2m_sections_t {
+    matrix_row_t smatrix[(MATRIX_ROWS) / 2];
+#    ifdef ENCODER_ENABLE
+    encoder_events_t encoders;
+#    endif // ENCODER_ENABLE
+#    if defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
+    report_mouse_t pointing;
+#    endif // defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
+} split_batch_s2m_sections_t;
+#endif // SPLIT_TRANSACTION_BATCHING
+
 typedef struct _split_shared_memory_t {
 #ifdef USE_I2C
     int8_t transaction_id;
 #endif // USE_I2C
 
+#ifdef SPLIT_TRANSACTION_BATCHING
+    split_batch_m2s_t batch_m2s;
+    uint8_t           batch_s2m_checksum;
+    uint8_t           batch_s2m[sizeof(split_batch_s2m_sections_t)];
+#endif // SPLIT_TRANSACTION_BATCHING
+
     split_slave_matrix_sync_t smatrix;
 
 #ifdef SPLIT_TRANSPORT_MIRROR
@@ -0,0 +1,82 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "task_scheduler.h"
+#include "timer.h"
+#include "us_timer.h"
+
+#ifdef TASK_TIMING_ENABLE
+#    include "task_timing.h"
+#endif
+
+static const task_scheduler_task_t *task_scheduler_tasks[TASK_SCHEDULER_MAX_TASKS];
+static uint16_t                     task_scheduler_last_run[TASK_SCHEDULER_MAX_TASKS];
+static bool                         task_scheduler_has_run[TASK_SCHEDULER_MAX_TASKS];
+static uint8_t                      task_scheduler_task_count;
+static uint8_t                      task_scheduler_cosmetic_next; // Where the cosmetic round-robin resumes
+
+bool task_scheduler_register(const task_scheduler_task_t *task) {
+    for (uint8_t i = 0; i < task_scheduler_task_count; i++) {
+        if (task_scheduler_tasks[i] == task) {
+            return true;
+        }
+    }
+    if (task_scheduler_task_count >= TASK_SCHEDULER_MAX_TASKS) {
+        return false;
+    }
+    task_scheduler_tasks[task_scheduler_task_count++] = task;
+    return true;
+}
+
+static bool task_scheduler_is_due(uint8_t index, uint16_t now) {
+    const task_scheduler_task_t *task = task_scheduler_tasks[index];
+
+    if (task->period_ms && task_scheduler_has_run[index] && TIMER_DIFF_16(now, task_scheduler_last_run[index]) < task->period_ms) {
+        return false;
+    }
+    return !task->has_pending_work || task->has_pending_work();
+}
+
+static void task_scheduler_call(uint8_t index, uint16_t now) {
+    const task_scheduler_task_t *task = task_scheduler_tasks[index];
+
+#ifdef TASK_TIMING_ENABLE
+    if (task->timing_stage != TASK_SCHEDULER_UNTIMED) {
+        TASK_TIMING_MEASURE((task_timing_stage_t)task->timing_stage) task->task();
+    } else
+#endif
+    {
+        task->task();
+    }
+
+    task_scheduler_last_run[index] = now;
+    task_scheduler_has_run[index]  = true;
+}
+
+void task_scheduler_run(void) {
+    uint16_t now = timer_read();
+
+    for (uint8_t i = 0; i < task_scheduler_task_count; i++) {
+        if (task_scheduler_tasks[i]->task_class == TASK_CLASS_INPUT && task_scheduler_is_due(i, now)) {
+            task_scheduler_call(i, now);
+        }
+    }
+
+    uint32_t budget_start_us = us_timer_read();
+    uint8_t  index           = task_scheduler_cosmetic_next;
+    for (uint8_t checked = 0; checked < task_scheduler_task_count; checked++, index++) {
+        if (index >= task_scheduler_task_count) {
+            index = 0;
+        }
+        if (task_scheduler_tasks[index]->task_class != TASK_CLASS_COSMETIC || !task_scheduler_is_due(index, now)) {
+            continue;
+        }
+
+        task_scheduler_call(index, now);
+        task_scheduler_cosmetic_next = index + 1;
+
+        if (us_timer_read() - budget_start_us >= TASK_SCHEDULER_COSMETIC_BUDGET_US) {
+            break;
+        }
+    }
+}
@@ -0,0 +1,62 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * \file
+ *
+ * \defgroup task_scheduler Task Scheduler
+ *
+ * Replaces the fixed sequence of `keyboard_task()` with registered tasks. Input tasks run first on
+ * every loop, cosmetic tasks share a per-loop time budget so a slow render cannot delay the next scan.
+ * \{
+ */
+
+typedef enum {
+    TASK_CLASS_INPUT,    // Runs on every loop it is due, before any cosmetic task
+    TASK_CLASS_COSMETIC, // Runs round-robin while the loop's cosmetic budget lasts
+} task_class_t;
+
+typedef struct {
+    /** The task function, called unchanged. */
+    void (*task)(void);
+    /** Optional predicate, the task is skipped while it returns false. */
+    bool (*has_pending_work)(void);
+    /** Minimum interval between two runs, 0 to run on every loop. */
+    uint16_t period_ms;
+    task_class_t task_class;
+    /** `task_timing_stage_t` to record the task as, or `TASK_SCHEDULER_UNTIMED`. */
+    uint8_t timing_stage;
+} task_scheduler_task_t;
+
+#define TASK_SCHEDULER_UNTIMED 0xFF
+
+#ifndef TASK_SCHEDULER_MAX_TASKS
+#    define TASK_SCHEDULER_MAX_TASKS 32
+#endif
+
+// Time cosmetic tasks may take per loop; at least one due cosmetic task always runs
+// Without a microsecond clock, as on AVR, this is effectively rounded to whole milliseconds
+#ifndef TASK_SCHEDULER_COSMETIC_BUDGET_US
+#    define TASK_SCHEDULER_COSMETIC_BUDGET_US 500
+#endif
+
+/**
+ * \brief Add a task, which must stay valid for the lifetime of the firmware.
+ *
+ * Tasks of the same class run in the order they were registered, registering a task twice has no effect.
+ *
+ * \return false if all `TASK_SCHEDULER_MAX_TASKS` slots are in use.
+ */
+bool task_scheduler_register(const task_scheduler_task_t *task);
+
+/**
+ * \brief Run one loop: every due input task, then cosmetic tasks until the budget is spent.
+ */
+void task_scheduler_run(void);
+
+/** \} */
@@ -0,0 +1,120 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+#include "task_timing.h"
+#include "us_timer.h"
+#include "util.h"
+
+typedef struct {
+    uint8_t  stage;
+    uint32_t count;
+    uint32_t total_us;
+    uint16_t min_us;
+    uint16_t max_us;
+    uint16_t histogram[TASK_TIMING_HISTOGRAM_BUCKETS];
+} task_timing_slot_t;
+
+// Stages get a slot the first time they run, so only the stages built into the firmware use RAM
+static task_timing_slot_t task_timing_slots[TASK_TIMING_MAX_STAGES];
+static uint8_t            task_timing_slot_map[TASK_TIMING_STAGE_COUNT]; // slot + 1, 0 if unassigned, TASK_TIMING_NO_SLOT if the slots ran out
+static uint8_t            task_timing_slots_used;
+static uint8_t            task_timing_stages_dropped;
+
+#define TASK_TIMING_NO_SLOT UINT8_MAX
+_Static_assert(TASK_TIMING_MAX_STAGES < TASK_TIMING_NO_SLOT, "TASK_TIMING_MAX_STAGES must be below 255");
+
+void task_timing_record(task_timing_stage_t stage, uint32_t start_us) {
+    uint32_t duration_us = us_timer_read() - start_us;
+
+    if (task_timing_slot_map[stage] == TASK_TIMING_NO_SLOT) {
+        return;
+    }
+    if (!task_timing_slot_map[stage]) {
+        if (task_timing_slots_used >= TASK_TIMING_MAX_STAGES) {
+            // Counted once per stage, so the host can tell how many it is missing
+            task_timing_slot_map[stage] = TASK_TIMING_NO_SLOT;
+            task_timing_stages_dropped++;
+            return;
+        }
+        task_timing_slot_t *slot = &task_timing_slots[task_timing_slots_used++];
+        slot->stage              = stage;
+        slot->min_us             = UINT16_MAX;
+
+        task_timing_slot_map[stage] = task_timing_slots_used;
+    }
+
+    task_timing_slot_t *slot       = &task_timing_slots[task_timing_slot_map[stage] - 1];
+    uint16_t            clamped_us = MIN(duration_us, UINT16_MAX);
+
+    us_timer_accumulate(&slot->count, &slot->total_us, duration_us);
+    slot->min_us = MIN(slot->min_us, clamped_us);
+    slot->max_us = MAX(slot->max_us, clamped_us);
+    us_timer_histogram_add(slot->histogram, TASK_TIMING_HISTOGRAM_BUCKETS, duration_us);
+}
+
+void task_timing_reset(void) {
+    for (uint8_t i = 0; i < task_timing_slots_used; i++) {
+        task_timing_slot_t *slot = &task_timing_slots[i];
+        slot->count              = 0;
+        slot->total_us           = 0;
+        slot->min_us             = UINT16_MAX;
+        slot->max_us             = 0;
+        memset(slot->histogram, 0, sizeof(slot->histogram));
+    }
+}
+
+bool task_timing_raw_hid_receive(uint8_t *data, uint8_t length) {
+    // data = [ command_id, sub_command_id, args... ]
+    if (data[0] != TASK_TIMING_RAW_HID_COMMAND_ID) {
+        return false;
+    }
+
+    uint8_t *command_data = &data[2];
+    switch (data[1]) {
+        case id_task_timing_get_info: {
+            command_data[0] = TASK_TIMING_PROTOCOL_VERSION;
+            command_data[1] = task_timing_slots_used;
+            command_data[2] = TASK_TIMING_MAX_STAGES;
+            command_data[3] = TASK_TIMING_HISTOGRAM_BUCKETS;
+            command_data[4] = task_timing_stages_dropped;
+            break;
+        }
+        case id_task_timing_get_stage: {
+            uint8_t index = command_data[0];
+            if (index >= task_timing_slots_used) {
+                data[0] = 0xFF;
+                break;
+            }
+
+            task_timing_slot_t *slot = &task_timing_slots[index];
+            uint8_t            *out  = &command_data[1];
+
+            *out++ = slot->stage;
+            out    = us_timer_put_u32(out, slot->count);
+            out    = us_timer_put_u32(out, slot->total_us);
+            out    = us_timer_put_u16(out, slot->count ? slot->min_us : 0);
+            out    = us_timer_put_u16(out, slot->count ? slot->total_us / slot->count : 0);
+            us_timer_put_u16(out, slot->max_us);
+            break;
+        }
+        case id_task_timing_get_histogram: {
+            uint8_t index = command_data[0];
+            if (index >= task_timing_slots_used || !us_timer_histogram_page(command_data, task_timing_slots[index].histogram, TASK_TIMING_HISTOGRAM_BUCKETS, length)) {
+                data[0] = 0xFF;
+            }
+            break;
+        }
+        case id_task_timing_reset: {
+            task_timing_reset();
+            break;
+        }
+        default: {
+            // The sub-command is not known
+            // Return the unhandled state
+            data[0] = 0xFF;
+            break;
+        }
+    }
+    return true;
+}
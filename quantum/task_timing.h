@@ -0,0 +1,115 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "us_timer.h"
+
+/**
+ * \file
+ *
+ * \defgroup task_timing Task Timing
+ *
+ * Measures how long every stage of `keyboard_task()` and `quantum_task()` takes, keeping per-stage
+ * min/avg/max and a log2 histogram that a host tool can read back over raw HID.
+ * \{
+ */
+
+/**
+ * \brief Stable identifiers of the timed stages, as reported over raw HID.
+ *
+ * New stages must only ever be appended.
+ */
+typedef enum {
+    TASK_TIMING_KEYBOARD_TASK = 0,
+    TASK_TIMING_MATRIX,
+    TASK_TIMING_QUANTUM,
+    TASK_TIMING_SPLIT_WATCHDOG,
+    TASK_TIMING_RGBLIGHT,
+    TASK_TIMING_LED_MATRIX,
+    TASK_TIMING_RGB_MATRIX,
+    TASK_TIMING_BACKLIGHT,
+    TASK_TIMING_ENCODER,
+    TASK_TIMING_POINTING_DEVICE,
+    TASK_TIMING_OLED,
+    TASK_TIMING_ST7565,
+    TASK_TIMING_MOUSEKEY,
+    TASK_TIMING_PS2_MOUSE,
+    TASK_TIMING_MIDI,
+    TASK_TIMING_JOYSTICK,
+    TASK_TIMING_BATTERY,
+    TASK_TIMING_BLUETOOTH,
+    TASK_TIMING_HAPTIC,
+    TASK_TIMING_LED,
+    TASK_TIMING_OS_DETECTION,
+    TASK_TIMING_AUDIO,
+    TASK_TIMING_MUSIC,
+    TASK_TIMING_KEY_OVERRIDE,
+    TASK_TIMING_SEQUENCER,
+    TASK_TIMING_TAP_DANCE,
+    TASK_TIMING_COMBO,
+    TASK_TIMING_LEADER,
+    TASK_TIMING_WPM,
+    TASK_TIMING_DIP_SWITCH,
+    TASK_TIMING_AUTO_SHIFT,
+    TASK_TIMING_CAPS_WORD,
+    TASK_TIMING_SECURE,
+    TASK_TIMING_LAYER_LOCK,
+    TASK_TIMING_HOST,
+    TASK_TIMING_CHORD,
+    TASK_TIMING_SEND_STRING_ASYNC,
+    TASK_TIMING_STAGE_COUNT,
+} task_timing_stage_t;
+
+/**
+ * \brief Raw HID sub-commands, sent as `[ TASK_TIMING_RAW_HID_COMMAND_ID, sub-command, ... ]`.
+ */
+enum task_timing_command_id {
+    id_task_timing_get_info      = 0x01, // -> [ version, slots used, slot count, bucket count, stages without a slot ]
+    id_task_timing_get_stage     = 0x02, // [ slot ] -> [ slot, stage, count:4, total_us:4, min_us:2, avg_us:2, max_us:2 ]
+    id_task_timing_get_histogram = 0x03, // [ slot, first bucket ] -> [ slot, first bucket, bucket count, buckets:2... ]
+    id_task_timing_reset         = 0x04,
+};
+
+#ifndef TASK_TIMING_RAW_HID_COMMAND_ID
+#    define TASK_TIMING_RAW_HID_COMMAND_ID 0xFE
+#endif
+
+#ifndef TASK_TIMING_MAX_STAGES
+#    define TASK_TIMING_MAX_STAGES 16
+#endif
+
+// Bucket n counts durations of [2^(n-1), 2^n) microseconds, the last bucket everything longer
+#ifndef TASK_TIMING_HISTOGRAM_BUCKETS
+#    define TASK_TIMING_HISTOGRAM_BUCKETS 16
+#endif
+
+#define TASK_TIMING_PROTOCOL_VERSION 0x01
+
+/**
+ * \brief Record one run of a stage that started at `start_us`.
+ */
+void task_timing_record(task_timing_stage_t stage, uint32_t start_us);
+
+/**
+ * \brief Clear all recorded statistics.
+ */
+void task_timing_reset(void);
+
+/**
+ * \brief Handle a task timing raw HID command in place.
+ *
+ * \param data The received report, overwritten with the reply.
+ * \param length The length of the report.
+ * \return true if the report was a task timing command and a reply should be sent.
+ */
+bool task_timing_raw_hid_receive(uint8_t *data, uint8_t length);
+
+/**
+ * \brief Time the following statement or block as `stage`.
+ */
+#define TASK_TIMING_MEASURE(stage) for (uint32_t task_timing_start_us = us_timer_read(), task_timing_once = 1; task_timing_once; task_timing_once = 0, task_timing_record((stage), task_timing_start_us))
+
+/** \} */
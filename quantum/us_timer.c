@@ -0,0 +1,79 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "us_timer.h"
+#include "timer.h"
+#include "util.h"
+
+#if defined(PROTOCOL_CHIBIOS)
+#    include <ch.h>
+#endif
+
+__attribute__((weak)) uint32_t us_timer_read(void) {
+#if defined(PROTOCOL_CHIBIOS)
+    // The system time can be as narrow as 16 bits. Tick deltas are taken in its own width and added
+    // up, so the result wraps at 32 bits like any other clock. It has to be read at least once per
+    // system time wrap, which the main loop does.
+    static systime_t last_ticks;
+    static uint32_t  ticks;
+    static uint32_t  whole_us;
+
+    systime_t now = chVTGetSystemTimeX();
+    ticks += chTimeDiffX(last_ticks, now);
+    last_ticks = now;
+    if (ticks >= CH_CFG_ST_FREQUENCY) {
+        whole_us += (ticks / CH_CFG_ST_FREQUENCY) * 1000000;
+        ticks %= CH_CFG_ST_FREQUENCY;
+    }
+    return whole_us + TIME_I2US(ticks);
+#else
+    // Both sides wrap at 32 bits, so differences stay right for up to 71 minutes
+    return timer_read32() * 1000;
+#endif
+}
+
+void us_timer_accumulate(uint32_t *count, uint32_t *total_us, uint32_t duration_us) {
+    // Saturate each sample instead of wrapping, the host is expected to reset periodically
+    if (*count < UINT32_MAX) {
+        (*count)++;
+    }
+    *total_us = UINT32_MAX - *total_us < duration_us ? UINT32_MAX : *total_us + duration_us;
+}
+
+void us_timer_histogram_add(uint16_t *histogram, uint8_t buckets, uint32_t duration_us) {
+    uint8_t bucket = 0;
+    while (duration_us && bucket < buckets - 1) {
+        duration_us >>= 1;
+        bucket++;
+    }
+    if (histogram[bucket] < UINT16_MAX) {
+        histogram[bucket]++;
+    }
+}
+
+bool us_timer_histogram_page(uint8_t *command_data, const uint16_t *histogram, uint8_t buckets, uint8_t length) {
+    uint8_t first = command_data[1];
+    if (first >= buckets) {
+        return false;
+    }
+
+    // The page starts after the command and sub-command IDs and the three bytes echoed above
+    uint8_t  count  = MIN(buckets - first, (length - 5) / 2);
+    uint8_t *out    = &command_data[3];
+    command_data[2] = count;
+    for (uint8_t i = 0; i < count; i++) {
+        out = us_timer_put_u16(out, histogram[first + i]);
+    }
+    return true;
+}
+
+uint8_t *us_timer_put_u16(uint8_t *data, uint16_t value) {
+    *data++ = value >> 8;
+    *data++ = value & 0xFF;
+    return data;
+}
+
+uint8_t *us_timer_put_u32(uint8_t *data, uint32_t value) {
+    data = us_timer_put_u16(data, value >> 16);
+    return us_timer_put_u16(data, value & 0xFFFF);
+}
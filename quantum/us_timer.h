@@ -0,0 +1,62 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * \file
+ *
+ * \defgroup us_timer Microsecond Timer
+ *
+ * The free-running microsecond clock shared by the task timing, latency trace and task scheduler
+ * features, along with the helpers they use to keep log2 histograms and report them over raw HID.
+ * \{
+ */
+
+/**
+ * \brief Read the free-running microsecond clock.
+ *
+ * Defaults to the ChibiOS system time (resolution of `CH_CFG_ST_FREQUENCY`), or the millisecond
+ * timer elsewhere, in which case every value is a whole number of milliseconds.
+ * Boards can override it with a finer-grained hardware counter. Either way the value wraps at
+ * 32 bits, so `us_timer_read() - start` is the elapsed time across a wrap.
+ */
+uint32_t us_timer_read(void);
+
+/**
+ * \brief Add a duration to a running count and total, each saturating at `UINT32_MAX` instead of wrapping.
+ */
+void us_timer_accumulate(uint32_t *count, uint32_t *total_us, uint32_t duration_us);
+
+/**
+ * \brief Count a duration in a log2 histogram.
+ *
+ * Bucket n counts durations of [2^(n-1), 2^n) microseconds, the last bucket everything longer.
+ * Buckets saturate at `UINT16_MAX`.
+ */
+void us_timer_histogram_add(uint16_t *histogram, uint8_t buckets, uint32_t duration_us);
+
+/**
+ * \brief Answer a raw HID request for a page of a histogram.
+ *
+ * `command_data` is `[ index, first bucket, ... ]` on the way in, and
+ * `[ index, first bucket, bucket count, buckets:2... ]` on the way out, fitted to a report of `length` bytes.
+ *
+ * \return false if the first bucket is out of range
+ */
+bool us_timer_histogram_page(uint8_t *command_data, const uint16_t *histogram, uint8_t buckets, uint8_t length);
+
+/**
+ * \brief Write a big-endian 16-bit value, returning the next free byte.
+ */
+uint8_t *us_timer_put_u16(uint8_t *data, uint16_t value);
+
+/**
+ * \brief Write a big-endian 32-bit value, returning the next free byte.
+ */
+uint8_t *us_timer_put_u32(uint8_t *data, uint32_t value);
+
+/** \} */
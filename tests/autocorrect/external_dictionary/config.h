@@ -0,0 +1,10 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define AUTOCORRECT_EXTERNAL_DICTIONARY
+// Longer than the typos, to check the corrections get their own limit
+#define AUTOCORRECT_MAX_CORRECTION_LENGTH 40
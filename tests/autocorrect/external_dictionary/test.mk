@@ -0,0 +1,7 @@
+# Copyright 2026 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+AUTOCORRECT_ENABLE = yes
+
+# Written by `qmk generate-autocorrect-data --packed` from dictionary.txt
+OPT_DEFS += -DCLI_DICTIONARY_FILE=\"$(TEST_PATH)/dictionary.bin\"
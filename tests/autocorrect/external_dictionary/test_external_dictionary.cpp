@@ -0,0 +1,321 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "keycode.h"
+#include "test_common.hpp"
+#include "../packed_dictionary.hpp"
+
+using ::testing::_;
+using ::testing::AnyNumber;
+using ::testing::InSequence;
+
+extern "C" {
+#include "process_autocorrect.h"
+
+static std::vector<uint8_t> dictionary;
+static uint32_t             dictionary_reads = 0;
+
+bool autocorrect_dictionary_read(uint32_t address, uint8_t *data, uint16_t length) {
+    dictionary_reads++;
+    if (address + length > dictionary.size()) {
+        return false;
+    }
+    memcpy(data, dictionary.data() + address, length);
+    return true;
+}
+
+static uint32_t    corrections       = 0;
+static bool        apply_corrections = true;
+static std::string last_correction;
+
+bool apply_autocorrect(uint8_t backspaces, const char *str, char *typo, char *correct) {
+    corrections++;
+    last_correction = correct;
+    return apply_corrections;
+}
+}
+
+static const std::vector<std::pair<std::string, std::string>> small_dictionary = {
+    {":thier", "their"}, {"fales", "false"}, {"lenght", "length"}, {"ouput", "output"}, {"widht", "width"},
+};
+
+class ExternalDictionary : public TestFixture {
+   public:
+    void SetUp() override {
+        autocorrect_enable();
+        dictionary = PackedDictionary(small_dictionary).data;
+        autocorrect_dictionary_invalidate();
+        corrections       = 0;
+        apply_corrections = true;
+        last_correction.clear();
+    }
+};
+
+TEST_F(ExternalDictionary, fales_to_false_autocorrection) {
+    TestDriver driver;
+    auto       key_f = KeymapKey(0, 0, 0, KC_F);
+    auto       key_a = KeymapKey(0, 1, 0, KC_A);
+    auto       key_l = KeymapKey(0, 2, 0, KC_L);
+    auto       key_e = KeymapKey(0, 3, 0, KC_E);
+    auto       key_s = KeymapKey(0, 4, 0, KC_S);
+
+    set_keymap({key_f, key_a, key_l, key_e, key_s});
+
+    // Allow any number of empty reports.
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport())).Times(AnyNumber());
+    { // Expect the following reports in this order.
+        InSequence s;
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_F)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_A)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_L)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_E)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_BACKSPACE)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_S)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_E)));
+    }
+
+    tap_keys(key_f, key_a, key_l, key_e, key_s);
+
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_EQ(last_correction, "false");
+}
+
+TEST_F(ExternalDictionary, word_boundary_typo) {
+    TestDriver driver;
+    auto       key_spc = KeymapKey(0, 0, 0, KC_SPC);
+    auto       key_t   = KeymapKey(0, 1, 0, KC_T);
+    auto       key_h   = KeymapKey(0, 2, 0, KC_H);
+    auto       key_i   = KeymapKey(0, 3, 0, KC_I);
+    auto       key_e   = KeymapKey(0, 4, 0, KC_E);
+    auto       key_r   = KeymapKey(0, 5, 0, KC_R);
+    auto       key_w   = KeymapKey(0, 6, 0, KC_W);
+
+    set_keymap({key_spc, key_t, key_h, key_i, key_e, key_r, key_w});
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    apply_corrections = false;
+
+    tap_keys(key_spc, key_t, key_h, key_i, key_e, key_r);
+    EXPECT_EQ(corrections, 1);
+    EXPECT_EQ(last_correction, "their");
+
+    // ":thier" only matches at the start of a word
+    tap_keys(key_spc, key_w, key_t, key_h, key_i, key_e, key_r);
+    EXPECT_EQ(corrections, 1);
+
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ExternalDictionary, missing_dictionary_is_ignored) {
+    TestDriver driver;
+    auto       key_f = KeymapKey(0, 0, 0, KC_F);
+    auto       key_a = KeymapKey(0, 1, 0, KC_A);
+    auto       key_l = KeymapKey(0, 2, 0, KC_L);
+    auto       key_e = KeymapKey(0, 3, 0, KC_E);
+    auto       key_s = KeymapKey(0, 4, 0, KC_S);
+
+    set_keymap({key_f, key_a, key_l, key_e, key_s});
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+
+    dictionary.assign(64, 0xFF);
+    autocorrect_dictionary_invalidate();
+    tap_keys(key_f, key_a, key_l, key_e, key_s);
+    EXPECT_EQ(corrections, 0);
+
+    dictionary.clear();
+    autocorrect_dictionary_invalidate();
+    tap_keys(key_f, key_a, key_l, key_e, key_s);
+    EXPECT_EQ(corrections, 0);
+
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ExternalDictionary, empty_chain_node_is_ignored) {
+    TestDriver driver;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key_a});
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+
+    // The root is a chain of no keys that links back to itself
+    dictionary = {'A', 'C', 'D', 1, 1, 1, 0, 0, 20, 0, 0, 0, 16, 0, 0, 0, 64, 16, 0, 0};
+    autocorrect_dictionary_invalidate();
+    tap_keys(key_a, key_a, key_a);
+    EXPECT_EQ(corrections, 0);
+
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ExternalDictionary, repeated_lookups_are_cached) {
+    TestDriver driver;
+    auto       key_f = KeymapKey(0, 0, 0, KC_F);
+    auto       key_a = KeymapKey(0, 1, 0, KC_A);
+    auto       key_l = KeymapKey(0, 2, 0, KC_L);
+    auto       key_e = KeymapKey(0, 3, 0, KC_E);
+    auto       key_s = KeymapKey(0, 4, 0, KC_S);
+
+    set_keymap({key_f, key_a, key_l, key_e, key_s});
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    apply_corrections = false;
+
+    tap_keys(key_f, key_a, key_l, key_e, key_s);
+    EXPECT_GT(dictionary_reads, 0);
+
+    // The whole small dictionary fits in the cache
+    dictionary_reads = 0;
+    tap_keys(key_f, key_a, key_l, key_e, key_s);
+    EXPECT_EQ(dictionary_reads, 0);
+    EXPECT_EQ(corrections, 2);
+
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ExternalDictionary, long_corrections) {
+    TestDriver driver;
+    auto       key_spc = KeymapKey(0, 0, 0, KC_SPC);
+    auto       key_o   = KeymapKey(0, 1, 0, KC_O);
+    auto       key_m   = KeymapKey(0, 2, 0, KC_M);
+    auto       key_w   = KeymapKey(0, 3, 0, KC_W);
+    auto       key_b   = KeymapKey(0, 4, 0, KC_B);
+    auto       key_r   = KeymapKey(0, 5, 0, KC_R);
+
+    set_keymap({key_spc, key_o, key_m, key_w, key_b, key_r});
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    apply_corrections = false;
+
+    // 38 and 43 characters
+    const std::string fits     = "on my way, should be there in a minute";
+    const std::string too_long = "be right back, someone is at the door again";
+    dictionary                 = PackedDictionary({{":omw", fits}, {":brb", too_long}}).data;
+    autocorrect_dictionary_invalidate();
+
+    // Longer than AUTOCORRECT_MAX_LENGTH, but within AUTOCORRECT_MAX_CORRECTION_LENGTH
+    tap_keys(key_spc, key_o, key_m, key_w);
+    EXPECT_EQ(corrections, 1);
+    EXPECT_EQ(last_correction, fits);
+
+    // Never typed in part
+    tap_keys(key_spc, key_b, key_r, key_b);
+    EXPECT_EQ(corrections, 1);
+
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ExternalDictionary, cli_generated_dictionary) {
+    TestDriver driver;
+    auto       key_f   = KeymapKey(0, 0, 0, KC_F);
+    auto       key_i   = KeymapKey(0, 1, 0, KC_I);
+    auto       key_t   = KeymapKey(0, 2, 0, KC_T);
+    auto       key_l   = KeymapKey(0, 3, 0, KC_L);
+    auto       key_e   = KeymapKey(0, 4, 0, KC_E);
+    auto       key_r   = KeymapKey(0, 5, 0, KC_R);
+    auto       key_spc = KeymapKey(0, 6, 0, KC_SPC);
+
+    set_keymap({key_f, key_i, key_t, key_l, key_e, key_r, key_spc});
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    apply_corrections = false;
+
+    FILE *file = fopen(CLI_DICTIONARY_FILE, "rb");
+    ASSERT_NE(file, nullptr) << CLI_DICTIONARY_FILE;
+    dictionary.clear();
+    for (int c; (c = fgetc(file)) != EOF;) {
+        dictionary.push_back(c);
+    }
+    fclose(file);
+    autocorrect_dictionary_invalidate();
+
+    // The host side builder the other tests use writes the same image
+    EXPECT_EQ(dictionary, PackedDictionary({{":thier", "their"}, {"fales", "false"}, {"fitler", "filter"}, {"lenght", "length"}, {"ouput", "output"}, {"widht", "width"}}).data);
+
+    tap_keys(key_spc, key_f, key_i, key_t, key_l, key_e, key_r);
+    EXPECT_EQ(corrections, 1);
+    EXPECT_EQ(last_correction, "filter");
+
+    VERIFY_AND_CLEAR(driver);
+}
+
+/* Words with a lot of shared endings, and typos made by swapping two neighbouring letters */
+static void generate_dictionary(size_t count, std::vector<std::string> &words, std::vector<std::pair<std::string, std::string>> &autocorrections) {
+    static const char *syllables[] = {"al", "an", "ar", "be", "ca", "co", "de", "di", "el", "en", "er", "es", "ing", "ion", "is", "it", "la", "le", "li", "lo", "ma", "me", "mi", "na", "ne", "no", "ol", "on", "or", "ous", "pa", "pe", "pro", "ra", "re", "ri", "ro", "se", "si", "ta", "te", "ter", "ti", "to", "tion", "ul", "un", "ur", "ve", "vi"};
+    std::mt19937                       rng(count);
+    std::uniform_int_distribution<int> syllable(0, sizeof(syllables) / sizeof(syllables[0]) - 1);
+    std::uniform_int_distribution<int> length(2, 4);
+    std::set<std::string>              known;
+
+    words.clear();
+    autocorrections.clear();
+    while (autocorrections.size() < count) {
+        std::string word;
+        for (int n = length(rng); n > 0; n--) {
+            word += syllables[syllable(rng)];
+        }
+        size_t at   = std::uniform_int_distribution<size_t>(0, word.size() - 2)(rng);
+        std::string typo = word;
+        std::swap(typo[at], typo[at + 1]);
+        if (typo == word || !known.insert(word).second || !known.insert(typo).second) {
+            continue;
+        }
+        words.push_back(word);
+        autocorrections.push_back({typo, word});
+    }
+}
+
+/* Prints the lookup cost per keystroke as the dictionary grows; run with `make test:autocorrect/external_dictionary` */
+TEST_F(ExternalDictionary, lookup_cost_vs_dictionary_size) {
+    TestDriver driver;
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    apply_corrections = false;
+
+    const size_t                                     counts[] = {100, 1000, 10000, 50000};
+    std::vector<double>                              reads_per_key;
+    std::vector<std::string>                         words;
+    std::vector<std::pair<std::string, std::string>> autocorrections;
+
+    printf("%8s %10s %12s %12s %14s %12s\n", "entries", "bytes", "bytes/entry", "shared nodes", "reads/keystroke", "ns/keystroke");
+    for (size_t count : counts) {
+        generate_dictionary(count, words, autocorrections);
+        PackedDictionary packed(autocorrections);
+        dictionary = packed.data;
+        autocorrect_dictionary_invalidate();
+
+        // Mostly correct words, every fourth word a typo
+        std::mt19937         rng(1);
+        std::vector<uint8_t> keystrokes;
+        uint32_t             typos = 0;
+        for (int i = 0; i < 2000; i++) {
+            size_t             entry = std::uniform_int_distribution<size_t>(0, count - 1)(rng);
+            const std::string &text  = i % 4 ? words[entry] : autocorrections[entry].first;
+            typos += !(i % 4);
+            for (char c : text) {
+                keystrokes.push_back(typo_keycode(c));
+            }
+            keystrokes.push_back(KC_SPC);
+        }
+
+        keyrecord_t record = {};
+        record.event.type  = KEY_EVENT;
+        corrections        = 0;
+        dictionary_reads   = 0;
+        auto start         = std::chrono::steady_clock::now();
+        for (uint8_t keycode : keystrokes) {
+            record.event.pressed = true;
+            process_autocorrect(keycode, &record);
+        }
+        auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+
+        reads_per_key.push_back((double)dictionary_reads / keystrokes.size());
+        printf("%8zu %10zu %12.1f %12zu %14.2f %12.1f\n", count, packed.data.size(), (double)packed.data.size() / count, packed.shared_nodes, reads_per_key.back(), (double)elapsed.count() / keystrokes.size());
+        EXPECT_GE(corrections, typos);
+    }
+    VERIFY_AND_CLEAR(driver);
+
+    /* Each keystroke walks at most one path of the trie, however large the dictionary */
+    EXPECT_LT(reads_per_key.back(), AUTOCORRECT_MAX_LENGTH);
+}
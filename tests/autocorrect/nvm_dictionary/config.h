@@ -0,0 +1,9 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define EEPROM_SIZE 8192
+#define AUTOCORRECT_NVM_DICTIONARY_SIZE 6144
@@ -0,0 +1,342 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <random>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "keycode.h"
+#include "test_common.hpp"
+#include "../packed_dictionary.hpp"
+
+using ::testing::_;
+using ::testing::AnyNumber;
+using ::testing::EndsWith;
+
+extern "C" {
+#include "process_autocorrect.h"
+
+static uint32_t    corrections = 0;
+static std::string last_correction;
+
+bool apply_autocorrect(uint8_t backspaces, const char *str, char *typo, char *correct) {
+    corrections++;
+    last_correction = correct;
+    return false;
+}
+}
+
+#define REPORT_SIZE 32
+
+static std::vector<uint8_t> raw_hid(uint8_t command, const std::vector<uint8_t> &arguments = {}) {
+    std::vector<uint8_t> report(REPORT_SIZE, 0);
+    report[0] = AUTOCORRECT_RAW_HID_COMMAND_ID;
+    report[1] = command;
+    std::copy(arguments.begin(), arguments.end(), report.begin() + 2);
+    EXPECT_TRUE(autocorrect_raw_hid_receive(report.data(), report.size()));
+    return report;
+}
+
+static void put_u32(std::vector<uint8_t> &out, uint32_t value) {
+    for (int shift = 24; shift >= 0; shift -= 8) {
+        out.push_back(value >> shift);
+    }
+}
+
+static uint16_t crc16(const std::vector<uint8_t> &data, size_t first) {
+    uint16_t crc = 0xFFFF;
+    for (size_t i = first; i < data.size(); i++) {
+        crc ^= data[i] << 8;
+        for (int bit = 0; bit < 8; bit++) {
+            crc = crc & 0x8000 ? (crc << 1) ^ 0x1021 : crc << 1;
+        }
+    }
+    return crc;
+}
+
+/* Sends the bytes of `image` from `first` on, returning the number of write reports */
+static size_t upload(const std::vector<uint8_t> &image, size_t first) {
+    size_t reports = 0;
+    for (size_t offset = first; offset < image.size(); reports++) {
+        uint8_t              count = std::min<size_t>(REPORT_SIZE - 7, image.size() - offset);
+        std::vector<uint8_t> arguments;
+        put_u32(arguments, offset);
+        arguments.push_back(count);
+        arguments.insert(arguments.end(), image.begin() + offset, image.begin() + offset + count);
+        EXPECT_EQ(raw_hid(id_autocorrect_write, arguments)[0], AUTOCORRECT_RAW_HID_COMMAND_ID);
+        offset += count;
+    }
+    return reports;
+}
+
+static uint8_t commit(const std::vector<uint8_t> &image, uint16_t crc) {
+    std::vector<uint8_t> arguments = {image[4], image[5]};
+    put_u32(arguments, image.size());
+    put_u32(arguments, image[12] | image[13] << 8 | image[14] << 16);
+    arguments.push_back(crc >> 8);
+    arguments.push_back(crc & 0xFF);
+    return raw_hid(id_autocorrect_commit, arguments)[0];
+}
+
+static uint8_t begin_upload(const std::vector<uint8_t> &image) {
+    std::vector<uint8_t> arguments;
+    put_u32(arguments, image.size());
+    return raw_hid(id_autocorrect_begin, arguments)[0];
+}
+
+static uint16_t generation(void) {
+    std::vector<uint8_t> info = raw_hid(id_autocorrect_get_info);
+    return info[12] << 8 | info[13];
+}
+
+static uint32_t upload_capacity(void) {
+    std::vector<uint8_t> info = raw_hid(id_autocorrect_get_info);
+    return info[14] << 24 | info[15] << 16 | info[16] << 8 | info[17];
+}
+
+/* `count` made up entries, a different set for every seed */
+static std::vector<std::pair<std::string, std::string>> generate_entries(uint32_t seed, size_t count) {
+    std::mt19937                                     rng(seed);
+    std::uniform_int_distribution<int>               letter('a', 'z');
+    std::vector<std::pair<std::string, std::string>> entries;
+    std::set<std::string>                            typos;
+    while (entries.size() < count) {
+        std::string word;
+        for (int n = 0; n < 6; n++) {
+            word += letter(rng);
+        }
+        if (typos.insert(word + "qx").second) {
+            entries.push_back({word + "qx", word + "xq"});
+        }
+    }
+    return entries;
+}
+
+static const std::vector<std::pair<std::string, std::string>> small_dictionary = {
+    {":thier", "their"}, {"fales", "false"}, {"lenght", "length"}, {"ouput", "output"}, {"widht", "width"},
+};
+
+class NvmDictionary : public TestFixture {
+   public:
+    void SetUp() override {
+        autocorrect_enable();
+        // Committing an empty image removes the dictionary
+        std::vector<uint8_t> arguments(12, 0);
+        raw_hid(id_autocorrect_commit, arguments);
+        corrections = 0;
+        last_correction.clear();
+    }
+};
+
+TEST_F(NvmDictionary, upload_then_commit) {
+    TestDriver driver;
+    auto       key_f = KeymapKey(0, 0, 0, KC_F);
+    auto       key_a = KeymapKey(0, 1, 0, KC_A);
+    auto       key_l = KeymapKey(0, 2, 0, KC_L);
+    auto       key_e = KeymapKey(0, 3, 0, KC_E);
+    auto       key_s = KeymapKey(0, 4, 0, KC_S);
+
+    set_keymap({key_f, key_a, key_l, key_e, key_s});
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+
+    std::vector<uint8_t> image = PackedDictionary(small_dictionary).data;
+
+    // Not live before the commit
+    upload(image, 16);
+    tap_keys(key_f, key_a, key_l, key_e, key_s);
+    EXPECT_EQ(corrections, 0);
+
+    uint16_t before = generation();
+    EXPECT_EQ(commit(image, crc16(image, 16)), AUTOCORRECT_RAW_HID_COMMAND_ID);
+    EXPECT_EQ(generation(), (uint16_t)(before + 1));
+
+    std::vector<uint8_t> info = raw_hid(id_autocorrect_get_info);
+    EXPECT_EQ(info[2], AUTOCORRECT_PROTOCOL_VERSION);
+    EXPECT_EQ(info[8] << 24 | info[9] << 16 | info[10] << 8 | info[11], image.size());
+
+    tap_keys(key_f, key_a, key_l, key_e, key_s);
+    EXPECT_EQ(corrections, 1);
+    // The earlier letters are still in the buffer, there is no word break in between
+    EXPECT_THAT(last_correction, EndsWith("false"));
+
+    // Reads back the image as committed
+    std::vector<uint8_t> arguments;
+    put_u32(arguments, 0);
+    arguments.push_back(16);
+    std::vector<uint8_t> header = raw_hid(id_autocorrect_read, arguments);
+    EXPECT_EQ(0, memcmp(&header[7], "ACD\x01", 4));
+    EXPECT_EQ(header[7 + 8], image.size() & 0xFF);
+
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(NvmDictionary, patch_adds_and_removes_entries) {
+    TestDriver driver;
+    auto       key_f = KeymapKey(0, 0, 0, KC_F);
+    auto       key_a = KeymapKey(0, 1, 0, KC_A);
+    auto       key_l = KeymapKey(0, 2, 0, KC_L);
+    auto       key_e = KeymapKey(0, 3, 0, KC_E);
+    auto       key_s = KeymapKey(0, 4, 0, KC_S);
+    auto       key_w = KeymapKey(0, 5, 0, KC_W);
+    auto       key_o = KeymapKey(0, 6, 0, KC_O);
+    auto       key_d = KeymapKey(0, 7, 0, KC_D);
+
+    set_keymap({key_f, key_a, key_l, key_e, key_s, key_w, key_o, key_d});
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+
+    std::vector<uint8_t> base = PackedDictionary(small_dictionary).data;
+    upload(base, 16);
+    ASSERT_EQ(commit(base, crc16(base, 16)), AUTOCORRECT_RAW_HID_COMMAND_ID);
+
+    // Drop "fales", add "sowlde"
+    auto entries = small_dictionary;
+    entries.erase(entries.begin() + 1);
+    entries.push_back({"sowlde", "slowed"});
+    PackedDictionary patch(entries, base);
+    EXPECT_EQ(patch.base_size, base.size());
+    EXPECT_LT(patch.data.size() - patch.base_size, base.size() - 16);
+
+    // Only the new nodes are sent, not the whole image
+    size_t full_upload = (patch.data.size() - 16 + REPORT_SIZE - 8) / (REPORT_SIZE - 7);
+    EXPECT_LT(upload(patch.data, patch.base_size), full_upload);
+    ASSERT_EQ(commit(patch.data, crc16(patch.data, 16)), AUTOCORRECT_RAW_HID_COMMAND_ID);
+
+    tap_keys(key_f, key_a, key_l, key_e, key_s);
+    EXPECT_EQ(corrections, 0);
+
+    tap_keys(key_s, key_o, key_w, key_l, key_d, key_e);
+    EXPECT_EQ(corrections, 1);
+    EXPECT_THAT(last_correction, EndsWith("slowed"));
+
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(NvmDictionary, failed_check_keeps_live_dictionary) {
+    TestDriver driver;
+    auto       key_f = KeymapKey(0, 0, 0, KC_F);
+    auto       key_a = KeymapKey(0, 1, 0, KC_A);
+    auto       key_l = KeymapKey(0, 2, 0, KC_L);
+    auto       key_e = KeymapKey(0, 3, 0, KC_E);
+    auto       key_s = KeymapKey(0, 4, 0, KC_S);
+
+    set_keymap({key_f, key_a, key_l, key_e, key_s});
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+
+    std::vector<uint8_t> base = PackedDictionary(small_dictionary).data;
+    upload(base, 16);
+    ASSERT_EQ(commit(base, crc16(base, 16)), AUTOCORRECT_RAW_HID_COMMAND_ID);
+    uint16_t live = generation();
+
+    auto entries = small_dictionary;
+    entries.erase(entries.begin() + 1);
+    PackedDictionary patch(entries, base);
+    upload(patch.data, patch.base_size);
+    EXPECT_EQ(commit(patch.data, crc16(patch.data, 16) ^ 1), 0xFF);
+    EXPECT_EQ(generation(), live);
+
+    tap_keys(key_f, key_a, key_l, key_e, key_s);
+    EXPECT_EQ(corrections, 1);
+
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(NvmDictionary, full_upload_keeps_live_dictionary_until_commit) {
+    TestDriver driver;
+    auto       key_f = KeymapKey(0, 0, 0, KC_F);
+    auto       key_a = KeymapKey(0, 1, 0, KC_A);
+    auto       key_l = KeymapKey(0, 2, 0, KC_L);
+    auto       key_e = KeymapKey(0, 3, 0, KC_E);
+    auto       key_s = KeymapKey(0, 4, 0, KC_S);
+    auto       key_w = KeymapKey(0, 5, 0, KC_W);
+    auto       key_o = KeymapKey(0, 6, 0, KC_O);
+    auto       key_d = KeymapKey(0, 7, 0, KC_D);
+
+    set_keymap({key_f, key_a, key_l, key_e, key_s, key_w, key_o, key_d});
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+
+    std::vector<uint8_t> live = PackedDictionary(small_dictionary).data;
+    upload(live, 16);
+    ASSERT_EQ(commit(live, crc16(live, 16)), AUTOCORRECT_RAW_HID_COMMAND_ID);
+
+    // A complete new image, without "fales"
+    auto entries = small_dictionary;
+    entries.erase(entries.begin() + 1);
+    entries.push_back({"sowlde", "slowed"});
+    std::vector<uint8_t> image = PackedDictionary(entries).data;
+    ASSERT_EQ(begin_upload(image), AUTOCORRECT_RAW_HID_COMMAND_ID);
+    upload(image, 16);
+
+    // The live dictionary keeps working during the upload
+    tap_keys(key_f, key_a, key_l, key_e, key_s);
+    EXPECT_EQ(corrections, 1);
+
+    ASSERT_EQ(commit(image, crc16(image, 16)), AUTOCORRECT_RAW_HID_COMMAND_ID);
+    tap_keys(key_f, key_a, key_l, key_e, key_s);
+    EXPECT_EQ(corrections, 1);
+    tap_keys(key_s, key_o, key_w, key_l, key_d, key_e);
+    EXPECT_EQ(corrections, 2);
+    EXPECT_THAT(last_correction, EndsWith("slowed"));
+
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(NvmDictionary, full_uploads_reclaim_the_previous_image) {
+    TestDriver driver;
+
+    // Two of them fit in the region, three do not
+    std::vector<uint8_t> image = PackedDictionary(generate_entries(0, 170)).data;
+    ASSERT_GT(image.size() * 3, AUTOCORRECT_NVM_DICTIONARY_SIZE);
+    ASSERT_LT(image.size() * 2, AUTOCORRECT_NVM_DICTIONARY_SIZE - 32);
+
+    for (size_t round = 0; round < 6; round++) {
+        image = PackedDictionary(generate_entries(round, 170)).data;
+        ASSERT_GE(upload_capacity(), image.size()) << round;
+        ASSERT_EQ(begin_upload(image), AUTOCORRECT_RAW_HID_COMMAND_ID) << round;
+        upload(image, 16);
+        ASSERT_EQ(commit(image, crc16(image, 16)), AUTOCORRECT_RAW_HID_COMMAND_ID) << round;
+
+        // The live image reads back as uploaded
+        std::vector<uint8_t> arguments;
+        put_u32(arguments, image.size() - 8);
+        arguments.push_back(8);
+        std::vector<uint8_t> tail = raw_hid(id_autocorrect_read, arguments);
+        EXPECT_TRUE(std::equal(image.end() - 8, image.end(), tail.begin() + 7)) << round;
+    }
+
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(NvmDictionary, live_nodes_are_not_overwritten) {
+    TestDriver driver;
+
+    std::vector<uint8_t> base = PackedDictionary(small_dictionary).data;
+    upload(base, 16);
+    ASSERT_EQ(commit(base, crc16(base, 16)), AUTOCORRECT_RAW_HID_COMMAND_ID);
+
+    std::vector<uint8_t> arguments;
+    put_u32(arguments, 16);
+    arguments.push_back(1);
+    arguments.push_back(0);
+    EXPECT_EQ(raw_hid(id_autocorrect_write, arguments)[0], 0xFF);
+
+    // A full upload goes next to the live image instead
+    ASSERT_EQ(begin_upload(base), AUTOCORRECT_RAW_HID_COMMAND_ID);
+    EXPECT_EQ(raw_hid(id_autocorrect_write, arguments)[0], AUTOCORRECT_RAW_HID_COMMAND_ID);
+
+    // But not past the size it was started with
+    arguments.clear();
+    put_u32(arguments, base.size());
+    arguments.push_back(1);
+    EXPECT_EQ(raw_hid(id_autocorrect_write, arguments)[0], 0xFF);
+
+    // Nor past the end of the region
+    arguments.clear();
+    put_u32(arguments, AUTOCORRECT_NVM_DICTIONARY_SIZE);
+    EXPECT_EQ(raw_hid(id_autocorrect_begin, arguments)[0], 0xFF);
+    arguments.push_back(1);
+    EXPECT_EQ(raw_hid(id_autocorrect_write, arguments)[0], 0xFF);
+
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,164 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "keycode.h"
+
+static inline uint8_t typo_keycode(char c) {
+    switch (c) {
+        case ':':
+            return KC_SPC;
+        case '\'':
+            return KC_QUOTE;
+        default:
+            return KC_A + c - 'a';
+    }
+}
+
+/* Host side builder of the packed format, the same as `qmk generate-autocorrect-data --packed`.
+ * Given the image of a previous dictionary as `base`, nodes it already has are reused and only
+ * new nodes are appended, as with `--base`. */
+class PackedDictionary {
+   public:
+    explicit PackedDictionary(const std::vector<std::pair<std::string, std::string>> &autocorrections, const std::vector<uint8_t> &base = {}) {
+        Node    trie;
+        uint8_t min_length = UINT8_MAX, max_length = 0;
+        for (const auto &entry : autocorrections) {
+            Node *node = &trie;
+            for (auto c = entry.first.rbegin(); c != entry.first.rend(); ++c) {
+                node = &node->children[typo_keycode(*c)];
+            }
+            node->leaf       = true;
+            node->typo       = entry.first;
+            node->correction = entry.second;
+            min_length       = std::min<uint8_t>(min_length, entry.first.size());
+            max_length       = std::max<uint8_t>(max_length, entry.first.size());
+        }
+
+        if (base.size() > 16) {
+            data = base;
+            adopt(get_u32(12));
+        } else {
+            data.assign(16, 0);
+        }
+        base_size     = data.size();
+        uint32_t root = serialize(trie);
+        memcpy(data.data(), "ACD\x01", 4);
+        data[4] = min_length;
+        data[5] = max_length;
+        data[6] = data[7] = 0;
+        put_u32(8, data.size());
+        put_u32(12, root);
+    }
+
+    std::vector<uint8_t> data;
+    size_t               base_size    = 0; // nodes from here on are new
+    size_t               shared_nodes = 0;
+
+   private:
+    struct Node {
+        std::map<uint8_t, Node> children; // ordered by keycode, as the firmware expects
+        bool                    leaf = false;
+        std::string             typo, correction;
+    };
+
+    std::map<std::vector<uint8_t>, uint32_t> offsets;
+    std::set<uint32_t>                       adopted;
+
+    uint32_t get_u32(size_t at) const {
+        return data[at] | data[at + 1] << 8 | data[at + 2] << 16 | (uint32_t)data[at + 3] << 24;
+    }
+
+    void put_u32(size_t at, uint32_t value) {
+        for (int i = 0; i < 4; i++) {
+            data[at + i] = value >> (8 * i);
+        }
+    }
+
+    static void put_link(std::vector<uint8_t> &node, uint32_t offset) {
+        node.push_back(offset);
+        node.push_back(offset >> 8);
+        node.push_back(offset >> 16);
+    }
+
+    /* Registers the nodes of the base image reachable from `offset` */
+    void adopt(uint32_t offset) {
+        if (!adopted.insert(offset).second) {
+            return;
+        }
+        uint8_t code = data[offset];
+        size_t  length;
+        if (code & 128) {
+            length = 2 + strlen((const char *)&data[offset + 1]);
+        } else {
+            uint8_t count = code & 63;
+            uint8_t links = code & 64 ? 1 : count;
+            length        = 1 + count + 3 * links;
+            for (uint8_t i = 0; i < links; i++) {
+                size_t link = offset + 1 + count + 3 * i;
+                adopt(data[link] | data[link + 1] << 8 | data[link + 2] << 16);
+            }
+        }
+        offsets.emplace(std::vector<uint8_t>(data.begin() + offset, data.begin() + offset + length), offset);
+    }
+
+    /* Children are written before their parents, identical nodes only once */
+    uint32_t emit(const std::vector<uint8_t> &node) {
+        auto found = offsets.find(node);
+        if (found != offsets.end()) {
+            shared_nodes++;
+            return found->second;
+        }
+        uint32_t offset = data.size();
+        data.insert(data.end(), node.begin(), node.end());
+        offsets[node] = offset;
+        return offset;
+    }
+
+    uint32_t serialize(const Node &node) {
+        std::vector<uint8_t> out;
+        if (node.leaf) {
+            bool        word_boundary_ending = node.typo.back() == ':';
+            std::string typo                 = node.typo.substr(node.typo.front() == ':', node.typo.size() - (node.typo.front() == ':') - word_boundary_ending);
+            size_t      i                    = 0;
+            while (i < std::min(typo.size(), node.correction.size()) && typo[i] == node.correction[i]) {
+                i++;
+            }
+            out.push_back(128 | (typo.size() - i - 1 + word_boundary_ending));
+            out.insert(out.end(), node.correction.begin() + i, node.correction.end());
+            out.push_back(0);
+        } else if (node.children.size() == 1) {
+            std::vector<uint8_t> keys;
+            const Node          *next = &node;
+            while (next->children.size() == 1 && !next->leaf && keys.size() < 63) {
+                keys.push_back(next->children.begin()->first);
+                next = &next->children.begin()->second;
+            }
+            uint32_t child = serialize(*next);
+            out.push_back(64 | keys.size());
+            out.insert(out.end(), keys.begin(), keys.end());
+            put_link(out, child);
+        } else {
+            std::vector<uint32_t> children;
+            out.push_back(node.children.size());
+            for (const auto &child : node.children) {
+                out.push_back(child.first);
+                children.push_back(serialize(child.second));
+            }
+            for (uint32_t child : children) {
+                put_link(out, child);
+            }
+        }
+        return emit(out);
+    }
+};
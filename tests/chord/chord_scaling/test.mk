@@ -0,0 +1,6 @@
+# Copyright 2026 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+CHORD_ENABLE = yes
+
+INTROSPECTION_KEYMAP_C = test_chords_scaling.c
@@ -0,0 +1,131 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <set>
+#include <vector>
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.h"
+#include "test_driver.hpp"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+using testing::_;
+
+extern "C" {
+#include "keymap_introspection.h"
+#include "process_chord.h"
+
+#define SCALING_CHORD_KEYS 24
+
+static std::vector<chord_t> chord_table;
+static uint32_t             chord_get_calls = 0;
+
+uint8_t chord_key_count(void) {
+    return SCALING_CHORD_KEYS;
+}
+
+uint16_t chord_key_get(uint8_t chord_key_idx) {
+    return KC_A + chord_key_idx;
+}
+
+uint16_t chord_count(void) {
+    return chord_table.size();
+}
+
+const chord_t *chord_get(uint16_t chord_idx) {
+    chord_get_calls++;
+    return &chord_table[chord_idx];
+}
+}
+
+/* Sorted table of `count` distinct chords of 2 to 5 keys, the same for every run */
+static void generate_chords(size_t count) {
+    std::mt19937                       rng(count);
+    std::uniform_int_distribution<int> key(0, SCALING_CHORD_KEYS - 1);
+    std::uniform_int_distribution<int> size(2, 5);
+    std::set<chord_keys_t>             masks;
+    while (masks.size() < count) {
+        chord_keys_t mask = 0;
+        for (int n = size(rng); bitpop32(mask) < n;) {
+            mask |= CHORD_KEY(key(rng));
+        }
+        masks.insert(mask);
+    }
+
+    chord_table.clear();
+    for (chord_keys_t mask : masks) {
+        chord_table.push_back(CHORD(mask, KC_1));
+    }
+    chord_table_invalidate();
+}
+
+class ChordScaling : public TestFixture {};
+
+/* Prints the lookup cost per chord key press as the table grows; run with `make test:chord/chord_scaling` */
+TEST_F(ChordScaling, cost_per_event_is_flat) {
+    TestDriver driver;
+    EXPECT_ANY_REPORT(driver).Times(testing::AnyNumber());
+
+    std::vector<KeymapKey> keys;
+    for (uint8_t i = 0; i < SCALING_CHORD_KEYS; i++) {
+        keys.emplace_back(0, i % MATRIX_COLS, i / MATRIX_COLS, KC_A + i);
+        add_key(keys.back());
+    }
+
+    const size_t        counts[]       = {16, 64, 256, 1024, 4096, 16384};
+    const int           chords_per_run = 200;
+    std::vector<double> probes_per_press;
+
+    printf("%8s %16s %16s\n", "chords", "probes/press", "ns/lookup");
+    for (size_t count : counts) {
+        generate_chords(count);
+        /* The table is checked once on first use, not on every event */
+        chord_find_longest(0);
+
+        /* Probes through the whole key path */
+        std::mt19937 rng(1);
+        uint32_t     presses = 0;
+        chord_get_calls      = 0;
+        std::vector<uint8_t> order(SCALING_CHORD_KEYS);
+        for (uint8_t i = 0; i < SCALING_CHORD_KEYS; i++) {
+            order[i] = i;
+        }
+        for (int run = 0; run < chords_per_run; run++) {
+            std::shuffle(order.begin(), order.end(), rng);
+            tap_combo({keys[order[0]], keys[order[1]], keys[order[2]], keys[order[3]]});
+            presses += 4;
+        }
+        /* Releases only read the chord they resolve, count everything against the presses */
+        probes_per_press.push_back((double)chord_get_calls / presses);
+
+        /* Host time of the lookup alone */
+        std::uniform_int_distribution<uint32_t> pressed(0, (1UL << SCALING_CHORD_KEYS) - 1);
+        std::vector<chord_keys_t>                sets;
+        for (int i = 0; i < 1000; i++) {
+            chord_keys_t set = pressed(rng);
+            while (bitpop32(set) > 6) {
+                set &= set - 1;
+            }
+            sets.push_back(set);
+        }
+        auto     start = std::chrono::steady_clock::now();
+        uint32_t found = 0;
+        for (chord_keys_t set : sets) {
+            found += chord_find_longest(set) != CHORD_NOT_FOUND;
+        }
+        auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+
+        printf("%8zu %16.1f %16.1f\n", count, probes_per_press.back(), (double)elapsed.count() / sets.size());
+        EXPECT_GT(found, 0);
+    }
+
+    /* A 1000-fold larger table costs a few more binary search steps, not 1000 times the work */
+    EXPECT_LT(probes_per_press.back(), probes_per_press.front() * 4);
+    EXPECT_LT(probes_per_press.back(), std::end(counts)[-1] / 16);
+}
@@ -0,0 +1,11 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "quantum.h"
+
+// The benchmark swaps in generated tables through chord_key_get() and chord_get()
+const uint16_t PROGMEM chord_keys[] = {KC_A, KC_B};
+
+const chord_t PROGMEM key_chords[] = {
+    CHORD(CHORD_KEY(0) | CHORD_KEY(1), KC_1),
+};
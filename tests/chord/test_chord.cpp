@@ -0,0 +1,180 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.h"
+#include "test_driver.hpp"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+extern "C" {
+#include "process_chord.h"
+}
+
+class Chord : public TestFixture {};
+
+TEST_F(Chord, two_key_chord_tapped) {
+    TestDriver driver;
+    KeymapKey  key_f(0, 0, 0, KC_F);
+    KeymapKey  key_j(0, 1, 0, KC_J);
+    set_keymap({key_f, key_j});
+
+    EXPECT_REPORT(driver, (KC_5));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_combo({key_f, key_j});
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(Chord, longest_chord_wins) {
+    TestDriver driver;
+    KeymapKey  key_a(0, 0, 0, KC_A);
+    KeymapKey  key_s(0, 1, 0, KC_S);
+    KeymapKey  key_d(0, 2, 0, KC_D);
+    set_keymap({key_a, key_s, key_d});
+
+    EXPECT_REPORT(driver, (KC_3));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_combo({key_a, key_s, key_d});
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(Chord, leftover_keys_are_replayed) {
+    TestDriver driver;
+    KeymapKey  key_a(0, 0, 0, KC_A);
+    KeymapKey  key_s(0, 1, 0, KC_S);
+    KeymapKey  key_j(0, 2, 0, KC_J);
+    set_keymap({key_a, key_s, key_j});
+
+    InSequence s;
+    EXPECT_REPORT(driver, (KC_1));
+    EXPECT_REPORT(driver, (KC_1, KC_J));
+    EXPECT_REPORT(driver, (KC_J));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_combo({key_a, key_s, key_j});
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(Chord, chord_resolves_after_combo_term) {
+    TestDriver driver;
+    KeymapKey  key_a(0, 0, 0, KC_A);
+    KeymapKey  key_s(0, 1, 0, KC_S);
+    set_keymap({key_a, key_s});
+
+    /* A+S could still become A+S+D */
+    EXPECT_NO_REPORT(driver);
+    key_a.press();
+    run_one_scan_loop();
+    key_s.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_1));
+    idle_for(COMBO_TERM + 1);
+    VERIFY_AND_CLEAR(driver);
+
+    /* Released with the last key of the chord */
+    EXPECT_NO_REPORT(driver);
+    key_a.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_s.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(Chord, keys_further_apart_than_combo_term) {
+    TestDriver driver;
+    KeymapKey  key_f(0, 0, 0, KC_F);
+    KeymapKey  key_j(0, 1, 0, KC_J);
+    set_keymap({key_f, key_j});
+
+    InSequence s;
+    EXPECT_REPORT(driver, (KC_F));
+    EXPECT_REPORT(driver, (KC_F, KC_J));
+    EXPECT_REPORT(driver, (KC_J));
+    EXPECT_EMPTY_REPORT(driver);
+    key_f.press();
+    run_one_scan_loop();
+    idle_for(COMBO_TERM + 1);
+    key_j.press();
+    run_one_scan_loop();
+    idle_for(COMBO_TERM + 1);
+    key_f.release();
+    run_one_scan_loop();
+    key_j.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(Chord, other_key_interrupts_chord) {
+    TestDriver driver;
+    KeymapKey  key_f(0, 0, 0, KC_F);
+    KeymapKey  key_x(0, 1, 0, KC_X);
+    set_keymap({key_f, key_x});
+
+    InSequence s;
+    EXPECT_REPORT(driver, (KC_F));
+    EXPECT_REPORT(driver, (KC_F, KC_X));
+    EXPECT_REPORT(driver, (KC_X));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_combo({key_f, key_x});
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(Chord, must_hold_chord_tapped) {
+    TestDriver driver;
+    KeymapKey  key_d(0, 0, 0, KC_D);
+    KeymapKey  key_f(0, 1, 0, KC_F);
+    set_keymap({key_d, key_f});
+
+    /* Mods must be held with COMBO_MUST_HOLD_MODS, tapped they are the plain keys */
+    InSequence s;
+    EXPECT_REPORT(driver, (KC_D));
+    EXPECT_REPORT(driver, (KC_D, KC_F));
+    EXPECT_REPORT(driver, (KC_F));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_combo({key_d, key_f});
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(Chord, must_hold_chord_held) {
+    TestDriver driver;
+    KeymapKey  key_d(0, 0, 0, KC_D);
+    KeymapKey  key_f(0, 1, 0, KC_F);
+    set_keymap({key_d, key_f});
+
+    EXPECT_NO_REPORT(driver);
+    key_d.press();
+    run_one_scan_loop();
+    key_f.press();
+    idle_for(COMBO_TERM + 1);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    idle_for(COMBO_HOLD_TERM);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_d.release();
+    run_one_scan_loop();
+    key_f.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(Chord, find_longest) {
+    TestDriver driver;
+
+    EXPECT_EQ(chord_find_longest(CHORD_KEY(0)), CHORD_NOT_FOUND);
+    EXPECT_EQ(chord_find_longest(CHORD_KEY(0) | CHORD_KEY(1)), 0);
+    EXPECT_EQ(chord_find_longest(CHORD_KEY(0) | CHORD_KEY(1) | CHORD_KEY(2) | CHORD_KEY(4)), 2);
+    EXPECT_EQ(chord_find_longest(CHORD_KEY(3) | CHORD_KEY(4)), 4);
+    EXPECT_EQ(chord_key_index(KC_J), 4);
+    EXPECT_EQ(chord_key_index(KC_X), -1);
+}
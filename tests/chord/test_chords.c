@@ -0,0 +1,20 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "quantum.h"
+
+enum chord_keys { CK_A, CK_S, CK_D, CK_F, CK_J };
+
+const uint16_t PROGMEM chord_keys[] = {
+    [CK_A] = KC_A, [CK_S] = KC_S, [CK_D] = KC_D, [CK_F] = KC_F, [CK_J] = KC_J,
+};
+
+// clang-format off
+const chord_t PROGMEM key_chords[] = {
+    CHORD(CHORD_KEY(CK_A) | CHORD_KEY(CK_S), KC_1),
+    CHORD(CHORD_KEY(CK_S) | CHORD_KEY(CK_D), KC_2),
+    CHORD(CHORD_KEY(CK_A) | CHORD_KEY(CK_S) | CHORD_KEY(CK_D), KC_3),
+    CHORD(CHORD_KEY(CK_D) | CHORD_KEY(CK_F), KC_LSFT),
+    CHORD(CHORD_KEY(CK_F) | CHORD_KEY(CK_J), KC_5),
+};
+// clang-format on
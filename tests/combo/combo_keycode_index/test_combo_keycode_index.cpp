@@ -0,0 +1,108 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.h"
+#include "test_driver.hpp"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+extern "C" {
+#include "keymap_introspection.h"
+#include "process_combo.h"
+
+/* Counts how many combos a key event looks at */
+static uint32_t combo_get_calls = 0;
+
+combo_t *combo_get(uint16_t combo_idx) {
+    combo_get_calls++;
+    return combo_get_raw(combo_idx);
+}
+}
+
+class ComboKeycodeIndex : public TestFixture {};
+
+TEST_F(ComboKeycodeIndex, two_key_combo) {
+    TestDriver driver;
+    KeymapKey  key_f(0, 0, 0, KC_F);
+    KeymapKey  key_j(0, 1, 0, KC_J);
+    set_keymap({key_f, key_j});
+
+    EXPECT_REPORT(driver, (KC_5));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_combo({key_f, key_j});
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ComboKeycodeIndex, longest_overlapping_combo_wins) {
+    TestDriver driver;
+    KeymapKey  key_a(0, 0, 0, KC_A);
+    KeymapKey  key_s(0, 1, 0, KC_S);
+    KeymapKey  key_d(0, 2, 0, KC_D);
+    set_keymap({key_a, key_s, key_d});
+
+    EXPECT_REPORT(driver, (KC_3));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_combo({key_a, key_s, key_d});
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ComboKeycodeIndex, shared_key_resolves_after_combo_term) {
+    TestDriver driver;
+    KeymapKey  key_a(0, 0, 0, KC_A);
+    KeymapKey  key_s(0, 1, 0, KC_S);
+    set_keymap({key_a, key_s});
+
+    /* A+S could still become A+S+D, so it waits for the combo term */
+    EXPECT_NO_REPORT(driver);
+    key_a.press();
+    run_one_scan_loop();
+    key_s.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_1));
+    idle_for(COMBO_TERM + 1);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_a.release();
+    run_one_scan_loop();
+    key_s.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ComboKeycodeIndex, only_candidate_combos_are_visited) {
+    TestDriver driver;
+    KeymapKey  key_j(0, 1, 0, KC_J);
+    KeymapKey  key_x(0, 2, 0, KC_X);
+    set_keymap({key_j, key_x});
+
+    /* Builds the index on first use */
+    EXPECT_REPORT(driver, (KC_X));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_x);
+    VERIFY_AND_CLEAR(driver);
+
+    /* Keys in no combo never look at one */
+    combo_get_calls = 0;
+    EXPECT_REPORT(driver, (KC_X));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_x);
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_EQ(combo_get_calls, 0);
+
+    /* J only belongs to one combo, seen on press and on release */
+    combo_get_calls = 0;
+    EXPECT_REPORT(driver, (KC_J));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_j);
+    idle_for(COMBO_TERM + 1);
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_LE(combo_get_calls, 4);
+}
@@ -0,0 +1,22 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "quantum.h"
+
+enum combos { as_combo, sd_combo, asd_combo, df_combo, fj_combo };
+
+uint16_t const as_keys[]  = {KC_A, KC_S, COMBO_END};
+uint16_t const sd_keys[]  = {KC_S, KC_D, COMBO_END};
+uint16_t const asd_keys[] = {KC_A, KC_S, KC_D, COMBO_END};
+uint16_t const df_keys[]  = {KC_D, KC_F, COMBO_END};
+uint16_t const fj_keys[]  = {KC_F, KC_J, COMBO_END};
+
+// clang-format off
+combo_t key_combos[] = {
+    [as_combo]  = COMBO(as_keys, KC_1),
+    [sd_combo]  = COMBO(sd_keys, KC_2),
+    [asd_combo] = COMBO(asd_keys, KC_3),
+    [df_combo]  = COMBO(df_keys, KC_4),
+    [fj_combo]  = COMBO(fj_keys, KC_5),
+};
+// clang-format on
@@ -0,0 +1,13 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define EEPROM_SIZE 1024
+#define DYNAMIC_KEYMAP_LAYER_COUNT 4
+
+// Only mirror the lower half of the layers, so that cached and uncached lookups can be compared.
+#define DYNAMIC_KEYMAP_CACHE_ENABLE
+#define DYNAMIC_KEYMAP_CACHE_LAYER_COUNT 2
@@ -0,0 +1,195 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#include "keycodes.h"
+#include "test_common.hpp"
+
+extern "C" {
+#include "dynamic_keymap.h"
+#include "keymap_introspection.h"
+#include "send_string.h"
+}
+
+using testing::_;
+using testing::InSequence;
+
+class DynamicKeymap : public TestFixture {
+   protected:
+    void SetUp() override {
+        dynamic_keymap_reset();
+    }
+};
+
+TEST_F(DynamicKeymap, SetKeycodeIsVisibleOnAllLayers) {
+    for (uint8_t layer = 0; layer < DYNAMIC_KEYMAP_LAYER_COUNT; layer++) {
+        dynamic_keymap_set_keycode(layer, 1, 2, KC_A + layer);
+    }
+
+    for (uint8_t layer = 0; layer < DYNAMIC_KEYMAP_LAYER_COUNT; layer++) {
+        EXPECT_EQ(dynamic_keymap_get_keycode(layer, 1, 2), KC_A + layer);
+        EXPECT_EQ(keycode_at_keymap_location(layer, 1, 2), KC_A + layer);
+    }
+}
+
+TEST_F(DynamicKeymap, CacheSurvivesReload) {
+    dynamic_keymap_set_keycode(0, 3, 9, KC_Z);
+    dynamic_keymap_cache_invalidate();
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 3, 9), KC_Z);
+}
+
+TEST_F(DynamicKeymap, SetBufferIsVisibleThroughGetKeycode) {
+    // Unaligned write spanning the last key of layer 1 (cached) and the first key of layer 2 (uncached).
+    const uint16_t layer_size = MATRIX_ROWS * MATRIX_COLS * 2;
+    const uint16_t offset     = 2 * layer_size - 1;
+    uint8_t        data[]     = {KC_B & 0xFF, KC_C >> 8, KC_C & 0xFF};
+
+    dynamic_keymap_set_keycode(1, MATRIX_ROWS - 1, MATRIX_COLS - 1, KC_A);
+    dynamic_keymap_set_buffer(offset, sizeof(data), data);
+
+    EXPECT_EQ(dynamic_keymap_get_keycode(1, MATRIX_ROWS - 1, MATRIX_COLS - 1), (KC_A & 0xFF00) | (KC_B & 0xFF));
+    EXPECT_EQ(dynamic_keymap_get_keycode(2, 0, 0), KC_C);
+
+    uint8_t readback[sizeof(data)];
+    dynamic_keymap_get_buffer(offset, sizeof(readback), readback);
+    EXPECT_EQ(memcmp(data, readback, sizeof(data)), 0);
+}
+
+TEST_F(DynamicKeymap, ResetRestoresDefaults) {
+    dynamic_keymap_set_keycode(0, 0, 0, KC_Q);
+    dynamic_keymap_set_keycode(3, 0, 0, KC_Q);
+    dynamic_keymap_reset();
+
+    for (uint8_t layer = 0; layer < DYNAMIC_KEYMAP_LAYER_COUNT; layer++) {
+        EXPECT_EQ(dynamic_keymap_get_keycode(layer, 0, 0), keycode_at_keymap_location_raw(layer, 0, 0));
+    }
+}
+
+TEST_F(DynamicKeymap, OutOfRangeLookupsReturnNoKey) {
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, MATRIX_ROWS, 0), KC_NO);
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 0, MATRIX_COLS), KC_NO);
+    EXPECT_EQ(dynamic_keymap_get_keycode(DYNAMIC_KEYMAP_LAYER_COUNT, 0, 0), KC_NO);
+}
+
+/* Uploads the macros the way VIA does: invalidate, write in report sized pieces, then validate */
+static void upload_macros(const std::string &macros, bool finish = true) {
+    uint16_t size = dynamic_keymap_macro_get_buffer_size();
+    uint8_t  flag = 0xFF;
+    dynamic_keymap_macro_set_buffer(size - 1, 1, &flag);
+    for (size_t offset = 0; offset < macros.size(); offset += 28) {
+        std::string piece = macros.substr(offset, 28);
+        dynamic_keymap_macro_set_buffer(offset, piece.size(), (uint8_t *)piece.data());
+    }
+    if (finish) {
+        flag = 0;
+        dynamic_keymap_macro_set_buffer(size - 1, 1, &flag);
+    }
+}
+
+TEST_F(DynamicKeymap, MacroSendPlaysNthMacro) {
+    TestDriver driver;
+    upload_macros(std::string("ab") + '\0' + "c" SS_TAP(X_ENTER) + '\0');
+
+    InSequence s;
+    EXPECT_REPORT(driver, (KC_C));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_ENTER));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    dynamic_keymap_macro_send(1);
+    dynamic_keymap_macro_send(0);
+    VERIFY_AND_CLEAR(driver);
+
+    // No such macros in the buffer
+    EXPECT_NO_REPORT(driver);
+    dynamic_keymap_macro_send(2);
+    dynamic_keymap_macro_send(DYNAMIC_KEYMAP_MACRO_COUNT - 1);
+    dynamic_keymap_macro_send(DYNAMIC_KEYMAP_MACRO_COUNT);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(DynamicKeymap, MacroSendAfterUpdate) {
+    TestDriver driver;
+    upload_macros(std::string("a") + '\0' + "b" + '\0');
+
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    dynamic_keymap_macro_send(1);
+    VERIFY_AND_CLEAR(driver);
+
+    // The first macro grows, moving the second one
+    upload_macros(std::string("aaaa") + '\0' + "c" + '\0');
+    EXPECT_REPORT(driver, (KC_C));
+    EXPECT_EMPTY_REPORT(driver);
+    dynamic_keymap_macro_send(1);
+    VERIFY_AND_CLEAR(driver);
+
+    dynamic_keymap_macro_reset();
+    EXPECT_NO_REPORT(driver);
+    dynamic_keymap_macro_send(1);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(DynamicKeymap, MacroSendIgnoresUnfinishedUpload) {
+    TestDriver driver;
+    upload_macros(std::string("a") + '\0', false);
+
+    EXPECT_NO_REPORT(driver);
+    dynamic_keymap_macro_send(0);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(DynamicKeymap, MacroSendLongerThanPrefetch) {
+    TestDriver driver;
+    std::string macro;
+    for (int i = 0; i < 100; i++) {
+        macro += 'a' + i % 26;
+    }
+    upload_macros(std::string("x") + '\0' + macro + '\0');
+
+    InSequence s;
+    for (int i = 0; i < 100; i++) {
+        EXPECT_REPORT(driver, (KC_A + i % 26));
+        EXPECT_EMPTY_REPORT(driver);
+    }
+    dynamic_keymap_macro_send(1);
+    VERIFY_AND_CLEAR(driver);
+}
+
+static double lookups_per_second(uint8_t first_layer, uint8_t last_layer) {
+    const int iterations = 2000;
+    uint32_t  checksum   = 0;
+    uint32_t  lookups    = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        for (uint8_t layer = first_layer; layer <= last_layer; layer++) {
+            for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+                for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                    checksum += dynamic_keymap_get_keycode(layer, row, col);
+                    lookups++;
+                }
+            }
+        }
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    // Keep the loop observable so it cannot be optimised away.
+    EXPECT_NE(checksum, UINT32_MAX);
+    return lookups / elapsed.count();
+}
+
+TEST_F(DynamicKeymap, LookupThroughput) {
+    double uncached = lookups_per_second(DYNAMIC_KEYMAP_CACHE_LAYER_COUNT, DYNAMIC_KEYMAP_LAYER_COUNT - 1);
+    double cached   = lookups_per_second(0, DYNAMIC_KEYMAP_CACHE_LAYER_COUNT - 1);
+
+    std::cout << "dynamic keymap lookups/s: nvm " << uncached << ", cache " << cached << std::endl;
+    RecordProperty("nvm_lookups_per_second", std::to_string(uncached));
+    RecordProperty("cached_lookups_per_second", std::to_string(cached));
+}
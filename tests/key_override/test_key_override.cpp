@@ -0,0 +1,142 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.h"
+#include "test_driver.hpp"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+using testing::_;
+using testing::AnyNumber;
+using testing::InSequence;
+
+extern "C" {
+#include "keymap_introspection.h"
+#include "process_key_override.h"
+
+/* Counts how many overrides a key event looks at, and lets a test shorten the table */
+static uint32_t key_override_get_calls = 0;
+static uint16_t key_override_limit     = UINT16_MAX;
+
+uint16_t key_override_count(void) {
+    return MIN(key_override_count_raw(), key_override_limit);
+}
+
+const key_override_t *key_override_get(uint16_t key_override_idx) {
+    key_override_get_calls++;
+    return key_override_get_raw(key_override_idx);
+}
+}
+
+class KeyOverride : public TestFixture {
+   protected:
+    void SetUp() override {
+        key_override_limit = UINT16_MAX;
+    }
+};
+
+TEST_F(KeyOverride, trigger_with_mods) {
+    TestDriver driver;
+    KeymapKey  key_shift(0, 0, 0, KC_LEFT_SHIFT);
+    KeymapKey  key_bspc(0, 1, 0, KC_BSPC);
+    set_keymap({key_shift, key_bspc});
+
+    InSequence s;
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    EXPECT_REPORT(driver, (KC_DELETE));
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    EXPECT_EMPTY_REPORT(driver);
+    key_shift.press();
+    run_one_scan_loop();
+    tap_key(key_bspc);
+    key_shift.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeyOverride, first_override_in_table_wins) {
+    TestDriver driver;
+    KeymapKey  key_shift(0, 0, 0, KC_LEFT_SHIFT);
+    KeymapKey  key_a(0, 1, 0, KC_A);
+    set_keymap({key_shift, key_a});
+
+    InSequence s;
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    EXPECT_EMPTY_REPORT(driver);
+    key_shift.press();
+    run_one_scan_loop();
+    tap_key(key_a);
+    key_shift.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeyOverride, override_without_trigger) {
+    TestDriver driver;
+    KeymapKey  key_ctrl(0, 0, 0, KC_LEFT_CTRL);
+    KeymapKey  key_alt(0, 1, 0, KC_LEFT_ALT);
+    set_keymap({key_ctrl, key_alt});
+
+    /* The mods are suppressed right away, the replacement follows after the key repeat delay */
+    InSequence s;
+    EXPECT_REPORT(driver, (KC_LEFT_CTRL));
+    EXPECT_EMPTY_REPORT(driver);
+    key_ctrl.press();
+    run_one_scan_loop();
+    key_alt.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_ESCAPE));
+    idle_for(500);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    key_alt.release();
+    run_one_scan_loop();
+    key_ctrl.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeyOverride, event_cost_is_independent_of_override_count) {
+    TestDriver driver;
+    KeymapKey  key_shift(0, 0, 0, KC_LEFT_SHIFT);
+    KeymapKey  key_a(0, 1, 0, KC_A);
+    KeymapKey  key_x(0, 2, 0, KC_X);
+    set_keymap({key_shift, key_a, key_x});
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+
+    uint32_t calls[2][2];
+    uint16_t limits[2] = {4, UINT16_MAX};
+    for (uint8_t i = 0; i < 2; i++) {
+        key_override_limit = limits[i];
+
+        /* The index is rebuilt for the new table on the first event */
+        tap_key(key_x);
+
+        /* A key that triggers no override only looks at the one without a trigger */
+        key_override_get_calls = 0;
+        tap_key(key_x);
+        calls[i][0] = key_override_get_calls;
+
+        /* Shift looks at that one too, A at its own */
+        key_override_get_calls = 0;
+        key_shift.press();
+        run_one_scan_loop();
+        tap_key(key_a);
+        key_shift.release();
+        run_one_scan_loop();
+        calls[i][1] = key_override_get_calls;
+    }
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_LE(calls[0][0], 1);
+    EXPECT_EQ(calls[0][0], calls[1][0]);
+    EXPECT_EQ(calls[0][1], calls[1][1]);
+    EXPECT_LT(calls[1][1], key_override_count_raw());
+}
@@ -0,0 +1,27 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "quantum.h"
+
+// Alt + a key that is never pressed, only there to make the table long
+#define FILLER(kc) &ko_make_basic(MOD_MASK_ALT, kc, KC_NO)
+
+// clang-format off
+const key_override_t *key_overrides[] = {
+    &ko_make_basic(MOD_MASK_SHIFT, KC_BSPC, KC_DEL),
+    &ko_make_basic(MOD_MASK_CA, KC_NO, KC_ESC),
+    &ko_make_basic(MOD_MASK_SHIFT, KC_A, KC_B),
+    FILLER(KC_F1), FILLER(KC_F2), FILLER(KC_F3), FILLER(KC_F4), FILLER(KC_F5), FILLER(KC_F6),
+    FILLER(KC_F7), FILLER(KC_F8), FILLER(KC_F9), FILLER(KC_F10), FILLER(KC_F11), FILLER(KC_F12),
+    FILLER(KC_F13), FILLER(KC_F14), FILLER(KC_F15), FILLER(KC_F16), FILLER(KC_F17), FILLER(KC_F18),
+    FILLER(KC_F19), FILLER(KC_F20), FILLER(KC_F21), FILLER(KC_F22), FILLER(KC_F23), FILLER(KC_F24),
+    FILLER(KC_KP_0), FILLER(KC_KP_1), FILLER(KC_KP_2), FILLER(KC_KP_3), FILLER(KC_KP_4), FILLER(KC_KP_5),
+    FILLER(KC_KP_6), FILLER(KC_KP_7), FILLER(KC_KP_8), FILLER(KC_KP_9), FILLER(KC_KP_SLASH), FILLER(KC_KP_ASTERISK),
+    FILLER(KC_KP_MINUS), FILLER(KC_KP_PLUS), FILLER(KC_KP_ENTER), FILLER(KC_KP_DOT), FILLER(KC_KP_EQUAL), FILLER(KC_KP_COMMA),
+    FILLER(KC_INT1), FILLER(KC_INT2), FILLER(KC_INT3), FILLER(KC_INT4), FILLER(KC_INT5), FILLER(KC_LNG1),
+    FILLER(KC_LNG2), FILLER(KC_LNG3), FILLER(KC_LNG4), FILLER(KC_LNG5), FILLER(KC_EXECUTE), FILLER(KC_HELP),
+    FILLER(KC_MENU), FILLER(KC_SELECT), FILLER(KC_STOP), FILLER(KC_AGAIN), FILLER(KC_UNDO), FILLER(KC_CUT),
+    // Shadowed by the earlier override with the same trigger
+    &ko_make_basic(MOD_MASK_SHIFT, KC_A, KC_C),
+};
+// clang-format on
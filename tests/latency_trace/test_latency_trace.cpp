@@ -0,0 +1,141 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+using testing::_;
+
+extern "C" {
+#include "latency_trace.h"
+}
+
+class LatencyTrace : public TestFixture {
+   protected:
+    void SetUp() override {
+        latency_trace_reset();
+    }
+
+    void command(uint8_t sub_command, uint8_t arg0 = 0, uint8_t arg1 = 0) {
+        memset(report, 0, sizeof(report));
+        report[0] = LATENCY_TRACE_RAW_HID_COMMAND_ID;
+        report[1] = sub_command;
+        report[2] = arg0;
+        report[3] = arg1;
+        EXPECT_TRUE(latency_trace_raw_hid_receive(report, sizeof(report)));
+    }
+
+    uint32_t count(latency_trace_path_t path) {
+        command(id_latency_trace_get_path, path);
+        EXPECT_EQ(report[2], path);
+        return u32(3);
+    }
+
+    uint32_t u32(uint8_t offset) {
+        return (report[offset] << 24) | (report[offset + 1] << 16) | (report[offset + 2] << 8) | report[offset + 3];
+    }
+
+    uint16_t u16(uint8_t offset) {
+        return (report[offset] << 8) | report[offset + 1];
+    }
+
+    uint8_t report[32];
+};
+
+TEST_F(LatencyTrace, ReportsInfo) {
+    command(id_latency_trace_get_info);
+    EXPECT_EQ(report[0], LATENCY_TRACE_RAW_HID_COMMAND_ID);
+    EXPECT_EQ(report[2], LATENCY_TRACE_PROTOCOL_VERSION);
+    EXPECT_EQ(report[3], LATENCY_TRACE_PATH_COUNT);
+    EXPECT_EQ(report[4], LATENCY_TRACE_HISTOGRAM_BUCKETS);
+}
+
+TEST_F(LatencyTrace, TracesPlainKeys) {
+    TestDriver driver;
+    KeymapKey  key(0, 0, 0, KC_A);
+    set_keymap({key});
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key);
+    VERIFY_AND_CLEAR(driver);
+
+    /* Press and release are sent in the loop that scanned them */
+    EXPECT_EQ(count(LATENCY_TRACE_PLAIN), 2);
+    EXPECT_EQ(u32(19), 0); // max
+    EXPECT_EQ(count(LATENCY_TRACE_MOD_TAP), 0);
+
+    command(id_latency_trace_get_histogram, LATENCY_TRACE_PLAIN, 0);
+    EXPECT_EQ(report[4], 13);
+    EXPECT_EQ(u16(5), 2);
+}
+
+TEST_F(LatencyTrace, TracesModTapFromTheResolvingRelease) {
+    TestDriver driver;
+    KeymapKey  key(0, 0, 0, LSFT_T(KC_A));
+    set_keymap({key});
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key, TAPPING_TERM / 2);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(count(LATENCY_TRACE_MOD_TAP), 1);
+    EXPECT_EQ(u32(19), 0); // max, the hold time is not part of the latency
+    EXPECT_EQ(count(LATENCY_TRACE_PLAIN), 0);
+}
+
+TEST_F(LatencyTrace, TracesCombos) {
+    TestDriver driver;
+    KeymapKey  key_y(0, 0, 1, KC_Y);
+    KeymapKey  key_u(0, 0, 2, KC_U);
+    set_keymap({key_y, key_u});
+
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_combo({key_y, key_u});
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_GE(count(LATENCY_TRACE_COMBO), 1);
+    EXPECT_EQ(count(LATENCY_TRACE_PLAIN), 0);
+}
+
+TEST_F(LatencyTrace, TracesTapDanceIncludingTheTimeout) {
+    TestDriver driver;
+    KeymapKey  key(0, 0, 0, TD(0));
+    set_keymap({key});
+
+    EXPECT_REPORT(driver, (KC_ESC));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key);
+    idle_for(TAPPING_TERM);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(count(LATENCY_TRACE_TAP_DANCE), 1);
+    EXPECT_GE(u32(11), (TAPPING_TERM - 1) * 1000); // min
+}
+
+TEST_F(LatencyTrace, ResetClearsStatistics) {
+    TestDriver driver;
+    KeymapKey  key(0, 0, 0, KC_A);
+    set_keymap({key});
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key);
+    VERIFY_AND_CLEAR(driver);
+
+    command(id_latency_trace_reset);
+    EXPECT_EQ(count(LATENCY_TRACE_PLAIN), 0);
+}
+
+TEST_F(LatencyTrace, RejectsUnknownCommands) {
+    command(0x7F);
+    EXPECT_EQ(report[0], 0xFF);
+
+    command(id_latency_trace_get_path, LATENCY_TRACE_PATH_COUNT);
+    EXPECT_EQ(report[0], 0xFF);
+
+    report[0] = 0x01;
+    EXPECT_FALSE(latency_trace_raw_hid_receive(report, sizeof(report)));
+}
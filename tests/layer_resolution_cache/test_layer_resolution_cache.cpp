@@ -0,0 +1,106 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+using testing::_;
+
+class LayerResolutionCache : public TestFixture {};
+
+TEST_F(LayerResolutionCache, TransparentLayersFallThrough) {
+    TestDriver driver;
+    KeymapKey  regular_key = KeymapKey{0, 1, 0, KC_A};
+
+    set_keymap({regular_key, KeymapKey{1, 1, 0, KC_TRNS}, KeymapKey{15, 1, 0, KC_TRNS}});
+    layer_state_set((1 << 1) | (1 << 15));
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(regular_key);
+    VERIFY_AND_CLEAR(driver);
+
+    /* Changing the keymap must not keep serving the previously resolved layer. */
+    set_keymap({regular_key, KeymapKey{1, 1, 0, KC_TRNS}, KeymapKey{15, 1, 0, KC_B}});
+
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(regular_key);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(LayerResolutionCache, MomentaryLayerIsObserved) {
+    TestDriver driver;
+    KeymapKey  layer_key   = KeymapKey{0, 0, 0, MO(15)};
+    KeymapKey  regular_key = KeymapKey{0, 1, 0, KC_A};
+
+    set_keymap({layer_key, regular_key, KeymapKey{15, 0, 0, KC_TRNS}, KeymapKey{15, 1, 0, KC_B}});
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(regular_key);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_NO_REPORT(driver);
+    layer_key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(regular_key);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_NO_REPORT(driver);
+    layer_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(regular_key);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(LayerResolutionCache, DefaultLayerIsObserved) {
+    TestDriver driver;
+    KeymapKey  regular_key = KeymapKey{0, 1, 0, KC_A};
+
+    set_keymap({regular_key, KeymapKey{2, 1, 0, KC_C}});
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(regular_key);
+    VERIFY_AND_CLEAR(driver);
+
+    default_layer_set(1 << 2);
+
+    EXPECT_REPORT(driver, (KC_C));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(regular_key);
+    VERIFY_AND_CLEAR(driver);
+
+    default_layer_set(1 << 0);
+}
+
+TEST_F(LayerResolutionCache, DirectLayerStateAssignmentIsObserved) {
+    TestDriver driver;
+    KeymapKey  regular_key = KeymapKey{0, 1, 0, KC_A};
+
+    set_keymap({regular_key, KeymapKey{15, 1, 0, KC_B}});
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(regular_key);
+    VERIFY_AND_CLEAR(driver);
+
+    /* Split secondaries assign the synchronised state without going through layer_state_set(). */
+    layer_state = (layer_state_t)1 << 15;
+
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(regular_key);
+    VERIFY_AND_CLEAR(driver);
+
+    layer_state = 0;
+}
@@ -0,0 +1,131 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_keymap_key.hpp"
+
+using testing::_;
+
+extern "C" {
+#include "keymap_introspection.h"
+
+/* Lets a test present the table in reverse, which is no longer sorted */
+static bool reversed = false;
+
+const leader_sequence_t *leader_sequence_get(uint16_t leader_sequence_idx) {
+    return leader_sequence_get_raw(reversed ? leader_sequence_count_raw() - 1 - leader_sequence_idx : leader_sequence_idx);
+}
+}
+
+class LeaderSequenceTable : public ::testing::WithParamInterface<bool>, public TestFixture {
+   protected:
+    void SetUp() override {
+        reversed = GetParam();
+        leader_sequence_table_invalidate();
+    }
+};
+
+TEST_P(LeaderSequenceTable, unique_sequence_does_not_wait_for_timeout) {
+    TestDriver driver;
+    auto       key_leader = KeymapKey(0, 0, 0, QK_LEADER);
+    auto       key_d      = KeymapKey(0, 1, 0, KC_D);
+
+    set_keymap({key_leader, key_d});
+
+    EXPECT_NO_REPORT(driver);
+    tap_keys(key_leader, key_d);
+    VERIFY_AND_CLEAR(driver);
+
+    // No other sequence starts with D, D
+    EXPECT_REPORT(driver, (KC_4));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_d);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(leader_sequence_active(), false);
+    EXPECT_EQ(leader_sequence_timed_out(), false);
+    EXPECT_NE(leader_sequence_table_match(), LEADER_SEQUENCE_NOT_FOUND);
+}
+
+TEST_P(LeaderSequenceTable, prefix_of_longer_sequence_waits_for_timeout) {
+    TestDriver driver;
+    auto       key_leader = KeymapKey(0, 0, 0, QK_LEADER);
+    auto       key_a      = KeymapKey(0, 1, 0, KC_A);
+    auto       key_b      = KeymapKey(0, 2, 0, KC_B);
+
+    set_keymap({key_leader, key_a, key_b});
+
+    EXPECT_NO_REPORT(driver);
+    tap_keys(key_leader, key_a, key_b);
+    EXPECT_EQ(leader_sequence_active(), true);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_2));
+    EXPECT_EMPTY_REPORT(driver);
+    idle_for(300);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(leader_sequence_active(), false);
+}
+
+TEST_P(LeaderSequenceTable, longest_sequence_completes_on_last_key) {
+    TestDriver driver;
+    auto       key_leader = KeymapKey(0, 0, 0, QK_LEADER);
+    auto       key_a      = KeymapKey(0, 1, 0, KC_A);
+    auto       key_b      = KeymapKey(0, 2, 0, KC_B);
+    auto       key_c      = KeymapKey(0, 3, 0, KC_C);
+
+    set_keymap({key_leader, key_a, key_b, key_c});
+
+    EXPECT_NO_REPORT(driver);
+    tap_keys(key_leader, key_a, key_b);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_3));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_c);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(leader_sequence_active(), false);
+}
+
+TEST_P(LeaderSequenceTable, sends_modified_keycode) {
+    TestDriver driver;
+    auto       key_leader = KeymapKey(0, 0, 0, QK_LEADER);
+    auto       key_e      = KeymapKey(0, 1, 0, KC_E);
+
+    set_keymap({key_leader, key_e});
+
+    testing::InSequence s;
+    EXPECT_REPORT(driver, (KC_LEFT_CTRL));
+    EXPECT_REPORT(driver, (KC_LEFT_CTRL, KC_C));
+    EXPECT_REPORT(driver, (KC_LEFT_CTRL));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_keys(key_leader, key_e);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_P(LeaderSequenceTable, unknown_sequence_sends_nothing) {
+    TestDriver driver;
+    auto       key_leader = KeymapKey(0, 0, 0, QK_LEADER);
+    auto       key_x      = KeymapKey(0, 1, 0, KC_X);
+
+    set_keymap({key_leader, key_x});
+
+    EXPECT_NO_REPORT(driver);
+    tap_keys(key_leader, key_x);
+    idle_for(300);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(leader_sequence_active(), false);
+    EXPECT_EQ(leader_sequence_table_match(), LEADER_SEQUENCE_NOT_FOUND);
+
+    EXPECT_REPORT(driver, (KC_X));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_x);
+    VERIFY_AND_CLEAR(driver);
+}
+
+INSTANTIATE_TEST_CASE_P(SortedAndUnsorted, LeaderSequenceTable, ::testing::Bool());
@@ -0,0 +1,14 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "quantum.h"
+
+// clang-format off
+const leader_sequence_t PROGMEM leader_sequences[] = {
+    LEADER_SEQUENCE(KC_1, KC_A),
+    LEADER_SEQUENCE(KC_2, KC_A, KC_B),
+    LEADER_SEQUENCE(KC_3, KC_A, KC_B, KC_C),
+    LEADER_SEQUENCE(KC_4, KC_D, KC_D),
+    LEADER_SEQUENCE(LCTL(KC_C), KC_E),
+};
+// clang-format on
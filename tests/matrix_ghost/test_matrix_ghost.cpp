@@ -0,0 +1,123 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+using testing::_;
+using testing::AnyNumber;
+
+extern "C" {
+/* Ghost detection reads the base layer through keycode_at_keymap_location(), not the test fixture keymap */
+static uint16_t base_layer[MATRIX_ROWS][MATRIX_COLS];
+static uint32_t base_layer_lookups = 0;
+
+uint16_t keycode_at_keymap_location(uint8_t layer_num, uint8_t row, uint8_t column) {
+    base_layer_lookups++;
+    return layer_num == 0 ? base_layer[row][column] : KC_NO;
+}
+}
+
+class MatrixGhost : public TestFixture {
+   protected:
+    void SetUp() override {
+        memset(base_layer, 0, sizeof(base_layer));
+    }
+
+    void set_base_layer(std::initializer_list<KeymapKey> keys) {
+        for (auto &key : keys) {
+            base_layer[key.position.row][key.position.col] = key.code;
+        }
+        set_keymap(keys);
+    }
+};
+
+TEST_F(MatrixGhost, IgnoresRowsWithGhostedKeys) {
+    TestDriver driver;
+    KeymapKey  key_a(0, 0, 0, KC_A);
+    KeymapKey  key_b(0, 1, 0, KC_B);
+    KeymapKey  key_c(0, 0, 1, KC_C);
+    KeymapKey  key_d(0, 1, 1, KC_D);
+    set_base_layer({key_a, key_b, key_c, key_d});
+
+    /* Pressing three corners of a rectangle also closes the fourth one */
+    EXPECT_NO_REPORT(driver);
+    key_a.press();
+    key_b.press();
+    key_c.press();
+    key_d.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    key_a.release();
+    key_b.release();
+    key_c.release();
+    key_d.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(MatrixGhost, IgnoresUndefinedKeys) {
+    TestDriver driver;
+    KeymapKey  key_a(0, 0, 0, KC_A);
+    KeymapKey  key_b(0, 1, 0, KC_B);
+    KeymapKey  key_c(0, 0, 1, KC_C);
+    KeymapKey  key_blank(0, 1, 1, KC_NO);
+    set_base_layer({key_a, key_b, key_c, key_blank});
+
+    /* Without a key at the fourth corner there is nothing to ghost */
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_REPORT(driver, (KC_A, KC_B));
+    EXPECT_REPORT(driver, (KC_A, KC_B, KC_C));
+    key_a.press();
+    key_b.press();
+    key_c.press();
+    key_blank.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_B, KC_C));
+    EXPECT_REPORT(driver, (KC_C));
+    EXPECT_EMPTY_REPORT(driver);
+    key_a.release();
+    key_b.release();
+    key_c.release();
+    key_blank.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(MatrixGhost, ReadsTheKeymapOncePerChange) {
+    TestDriver driver;
+    KeymapKey  key_a(0, 0, 0, KC_A);
+    KeymapKey  key_b(0, 1, 0, KC_B);
+    set_base_layer({key_a, key_b});
+
+    EXPECT_REPORT(driver, (KC_A)).Times(AnyNumber());
+    EXPECT_REPORT(driver, (KC_A, KC_B)).Times(AnyNumber());
+    EXPECT_REPORT(driver, (KC_B)).Times(AnyNumber());
+    EXPECT_EMPTY_REPORT(driver).Times(AnyNumber());
+
+    base_layer_lookups = 0;
+    for (int i = 0; i < 3; i++) {
+        key_a.press();
+        key_b.press();
+        run_one_scan_loop();
+        key_a.release();
+        key_b.release();
+        run_one_scan_loop();
+    }
+    EXPECT_EQ(base_layer_lookups, MATRIX_ROWS * MATRIX_COLS);
+
+    /* A keymap change rebuilds the masks on the next chord */
+    matrix_real_keys_invalidate();
+    base_layer_lookups = 0;
+    key_a.press();
+    key_b.press();
+    run_one_scan_loop();
+    key_a.release();
+    key_b.release();
+    run_one_scan_loop();
+    EXPECT_EQ(base_layer_lookups, MATRIX_ROWS * MATRIX_COLS);
+    VERIFY_AND_CLEAR(driver);
+}
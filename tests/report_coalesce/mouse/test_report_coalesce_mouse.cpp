@@ -0,0 +1,92 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "mouse_report_util.hpp"
+#include "test_common.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+extern "C" {
+#include "host.h"
+#include "report_coalesce.h"
+#include "suspend.h"
+}
+
+static void send_mouse(int16_t x, int16_t y, uint8_t buttons) {
+    report_mouse_t report = {};
+    report.x              = x;
+    report.y              = y;
+    report.buttons        = buttons;
+    host_mouse_send(&report);
+}
+
+class ReportCoalesceMouse : public TestFixture {};
+
+TEST_F(ReportCoalesceMouse, movement_is_added_up) {
+    TestDriver driver;
+
+    EXPECT_MOUSE_REPORT(driver, (3, -1, 0, 0, 0));
+    send_mouse(1, 0, 0);
+    send_mouse(2, -1, 0);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_NO_MOUSE_REPORT(driver);
+    send_mouse(1, 1, 0);
+    send_mouse(1, 1, 0);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_MOUSE_REPORT(driver, (2, 2, 0, 0, 0));
+    idle_for(REPORT_COALESCE_INTERVAL);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ReportCoalesceMouse, button_change_ends_the_merge) {
+    TestDriver driver;
+
+    // The click stays where the pointer was, and the movement after it is added up again
+    InSequence s;
+    EXPECT_MOUSE_REPORT(driver, (4, 0, 0, 0, 0));
+    EXPECT_MOUSE_REPORT(driver, (0, 0, 0, 0, 1));
+    EXPECT_MOUSE_REPORT(driver, (4, 0, 0, 0, 1));
+    EXPECT_MOUSE_REPORT(driver, (0, 0, 0, 0, 0));
+    send_mouse(4, 0, 0);
+    send_mouse(0, 0, 1);
+    send_mouse(2, 0, 1);
+    send_mouse(2, 0, 1);
+    send_mouse(0, 0, 0);
+    idle_for(REPORT_COALESCE_INTERVAL * 4);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ReportCoalesceMouse, movement_is_not_merged_past_report_range) {
+    TestDriver driver;
+
+    InSequence s;
+    EXPECT_MOUSE_REPORT(driver, (MOUSE_REPORT_XY_MAX, 0, 0, 0, 0));
+    EXPECT_MOUSE_REPORT(driver, (1, 0, 0, 0, 0));
+    send_mouse(MOUSE_REPORT_XY_MAX, 0, 0);
+    send_mouse(1, 0, 0);
+    idle_for(REPORT_COALESCE_INTERVAL * 2);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ReportCoalesceMouse, suspend_flushes_queued_report) {
+    TestDriver driver;
+
+    EXPECT_MOUSE_REPORT(driver, (1, 0, 0, 0, 1));
+    send_mouse(1, 0, 1);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_MOUSE_REPORT(driver);
+    send_mouse(0, 0, 0);
+    suspend_power_down_quantum();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_NO_MOUSE_REPORT(driver);
+    idle_for(REPORT_COALESCE_INTERVAL);
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,5 @@
+# Copyright 2026 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+REPORT_COALESCE_ENABLE = yes
+NKRO_ENABLE = yes
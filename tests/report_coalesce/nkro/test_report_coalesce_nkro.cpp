@@ -0,0 +1,122 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstring>
+#include <initializer_list>
+
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_keymap_key.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+extern "C" {
+#include "report_coalesce.h"
+#include "suspend.h"
+}
+
+static report_nkro_t nkro_report_of(uint8_t mods, std::initializer_list<uint8_t> keys) {
+    report_nkro_t report = {};
+    report.mods          = mods;
+    for (uint8_t key : keys) {
+        report.bits[key >> 3] |= 1 << (key & 7);
+    }
+    return report;
+}
+
+MATCHER_P(NkroReport, expected, "") {
+    return arg.mods == expected.mods && memcmp(arg.bits, expected.bits, sizeof(arg.bits)) == 0;
+}
+
+#define EXPECT_NKRO_REPORT(driver, mods, ...) EXPECT_CALL((driver), send_nkro_mock(NkroReport(nkro_report_of((mods), {__VA_ARGS__}))))
+
+class ReportCoalesceNkro : public TestFixture {
+   public:
+    void SetUp() override {
+        keymap_config.nkro = true;
+    }
+
+    void TearDown() override {
+        keymap_config.nkro = false;
+    }
+};
+
+TEST_F(ReportCoalesceNkro, releases_are_merged) {
+    TestDriver driver;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+    auto       key_b = KeymapKey(0, 1, 0, KC_B);
+    auto       key_c = KeymapKey(0, 2, 0, KC_C);
+
+    set_keymap({key_a, key_b, key_c});
+
+    InSequence s;
+    EXPECT_NKRO_REPORT(driver, 0, KC_A);
+    EXPECT_NKRO_REPORT(driver, 0, KC_A, KC_B);
+    EXPECT_NKRO_REPORT(driver, 0, KC_A, KC_B, KC_C);
+    key_a.press();
+    idle_for(REPORT_COALESCE_INTERVAL);
+    key_b.press();
+    idle_for(REPORT_COALESCE_INTERVAL);
+    key_c.press();
+    idle_for(REPORT_COALESCE_INTERVAL);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_NKRO_REPORT(driver, 0);
+    key_a.release();
+    key_b.release();
+    key_c.release();
+    idle_for(REPORT_COALESCE_INTERVAL * 2);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ReportCoalesceNkro, modifier_change_ends_the_merge) {
+    TestDriver driver;
+
+    InSequence s;
+    EXPECT_NKRO_REPORT(driver, MOD_BIT(KC_LEFT_SHIFT));
+    EXPECT_NKRO_REPORT(driver, MOD_BIT(KC_LEFT_SHIFT), KC_A);
+    register_code(KC_LEFT_SHIFT);
+    register_code(KC_A);
+    idle_for(REPORT_COALESCE_INTERVAL * 2);
+    VERIFY_AND_CLEAR(driver);
+
+    // The key comes up before its modifier
+    EXPECT_NKRO_REPORT(driver, MOD_BIT(KC_LEFT_SHIFT));
+    EXPECT_NKRO_REPORT(driver, 0);
+    unregister_code(KC_A);
+    unregister_code(KC_LEFT_SHIFT);
+    idle_for(REPORT_COALESCE_INTERVAL * 2);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ReportCoalesceNkro, tap_within_one_scan_is_kept) {
+    TestDriver driver;
+
+    InSequence s;
+    EXPECT_NKRO_REPORT(driver, 0, KC_A);
+    EXPECT_NKRO_REPORT(driver, 0);
+    register_code(KC_A);
+    unregister_code(KC_A);
+    run_one_scan_loop();
+    idle_for(REPORT_COALESCE_INTERVAL);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ReportCoalesceNkro, suspend_flushes_queued_report) {
+    TestDriver driver;
+
+    EXPECT_NKRO_REPORT(driver, 0, KC_A);
+    register_code(KC_A);
+    unregister_code(KC_A);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_NKRO_REPORT(driver, 0);
+    suspend_power_down_quantum();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_CALL(driver, send_nkro_mock(_)).Times(0);
+    idle_for(REPORT_COALESCE_INTERVAL);
+    VERIFY_AND_CLEAR(driver);
+}
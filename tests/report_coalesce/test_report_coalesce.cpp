@@ -0,0 +1,221 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_keymap_key.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+extern "C" {
+#include "host.h"
+#include "report_coalesce.h"
+#include "suspend.h"
+}
+
+MATCHER_P(ExtraUsage, usage, "has usage " + testing::PrintToString(usage)) {
+    return arg.usage == usage;
+}
+
+class ReportCoalesce : public TestFixture {};
+
+TEST_F(ReportCoalesce, first_report_is_not_delayed) {
+    TestDriver driver;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key_a});
+    driver.expect_strict_host(REPORT_COALESCE_INTERVAL);
+
+    EXPECT_REPORT(driver, (KC_A));
+    key_a.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_NO_REPORT(driver);
+    key_a.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    idle_for(REPORT_COALESCE_INTERVAL);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ReportCoalesce, releases_are_merged) {
+    TestDriver driver;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+    auto       key_b = KeymapKey(0, 1, 0, KC_B);
+    auto       key_c = KeymapKey(0, 2, 0, KC_C);
+
+    set_keymap({key_a, key_b, key_c});
+    driver.expect_strict_host(REPORT_COALESCE_INTERVAL);
+
+    InSequence s;
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_REPORT(driver, (KC_A, KC_B));
+    EXPECT_REPORT(driver, (KC_A, KC_B, KC_C));
+    key_a.press();
+    idle_for(REPORT_COALESCE_INTERVAL);
+    key_b.press();
+    idle_for(REPORT_COALESCE_INTERVAL);
+    key_c.press();
+    idle_for(REPORT_COALESCE_INTERVAL);
+    VERIFY_AND_CLEAR(driver);
+
+    // The three releases reach the host as one report
+    EXPECT_EMPTY_REPORT(driver);
+    key_a.release();
+    key_b.release();
+    key_c.release();
+    idle_for(REPORT_COALESCE_INTERVAL * 2);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ReportCoalesce, tap_within_one_scan_is_kept) {
+    TestDriver driver;
+
+    driver.expect_strict_host(REPORT_COALESCE_INTERVAL);
+
+    EXPECT_REPORT(driver, (KC_A));
+    register_code(KC_A);
+    unregister_code(KC_A);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    // The release waits for the next polling interval
+    EXPECT_NO_REPORT(driver);
+    idle_for(REPORT_COALESCE_INTERVAL - 2);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    idle_for(2);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ReportCoalesce, suspend_flushes_queued_report) {
+    TestDriver driver;
+
+    EXPECT_REPORT(driver, (KC_A));
+    register_code(KC_A);
+    unregister_code(KC_A);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    // The release is sent before the host goes to sleep, not once it wakes up
+    EXPECT_EMPTY_REPORT(driver);
+    suspend_power_down_quantum();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_NO_REPORT(driver);
+    idle_for(REPORT_COALESCE_INTERVAL);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ReportCoalesce, direct_send_is_compared_against) {
+    TestDriver driver;
+
+    EXPECT_REPORT(driver, (KC_A));
+    register_code(KC_A);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    report_keyboard_t empty = {};
+    host_keyboard_send_now(&empty);
+    VERIFY_AND_CLEAR(driver);
+
+    // The same report as the last queued one still changes what the host has
+    EXPECT_REPORT(driver, (KC_A));
+    report_keyboard_t pressed = {};
+    pressed.keys[0]           = KC_A;
+    host_keyboard_send(&pressed);
+    idle_for(REPORT_COALESCE_INTERVAL);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    unregister_code(KC_A);
+    idle_for(REPORT_COALESCE_INTERVAL);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ReportCoalesce, modifier_goes_down_before_its_key) {
+    TestDriver driver;
+    auto       key_osm = KeymapKey(0, 0, 0, OSM(MOD_LSFT));
+    auto       key_a   = KeymapKey(0, 1, 0, KC_A);
+
+    set_keymap({key_osm, key_a});
+    driver.expect_strict_host(REPORT_COALESCE_INTERVAL);
+
+    EXPECT_NO_REPORT(driver);
+    tap_key(key_osm);
+    VERIFY_AND_CLEAR(driver);
+
+    // The one-shot modifier is applied in the same report as the key, which is split in two
+    InSequence s;
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT, KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_a);
+    idle_for(REPORT_COALESCE_INTERVAL * 3);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ReportCoalesce, rolled_keys_keep_their_order) {
+    TestDriver driver;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+    auto       key_b = KeymapKey(0, 1, 0, KC_B);
+
+    set_keymap({key_a, key_b});
+    driver.expect_strict_host(REPORT_COALESCE_INTERVAL);
+
+    InSequence s;
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_REPORT(driver, (KC_A, KC_B));
+    key_a.press();
+    key_b.press();
+    idle_for(REPORT_COALESCE_INTERVAL * 2);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_a.release();
+    key_b.release();
+    idle_for(REPORT_COALESCE_INTERVAL * 2);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ReportCoalesce, full_queue_sends_oldest_report_early) {
+    TestDriver driver;
+
+    InSequence s;
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    for (int i = 0; i < 3; i++) {
+        register_code(KC_A);
+        unregister_code(KC_A);
+    }
+    VERIFY_AND_CLEAR(driver);
+
+    // Nothing is dropped
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    idle_for(REPORT_COALESCE_INTERVAL * REPORT_COALESCE_QUEUE_SIZE + 1);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ReportCoalesce, extra_reports_are_spaced_out) {
+    TestDriver driver;
+
+    EXPECT_CALL(driver, send_extra_mock(ExtraUsage(AUDIO_VOL_UP)));
+    register_code(KC_AUDIO_VOL_UP);
+    unregister_code(KC_AUDIO_VOL_UP);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_CALL(driver, send_extra_mock(ExtraUsage(0)));
+    idle_for(REPORT_COALESCE_INTERVAL);
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,204 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_keymap_key.hpp"
+
+using testing::_;
+using testing::AnyNumber;
+using testing::InSequence;
+
+extern "C" {
+static const char      *macro_strings[2] = {};
+static uint8_t          macro_interval   = 0;
+static std::vector<int> completed;
+
+static void on_complete(void *cb_arg) {
+    completed.push_back((int)(intptr_t)cb_arg);
+}
+
+bool process_record_user(uint16_t keycode, keyrecord_t *record) {
+    if (keycode == QK_USER && record->event.pressed) {
+        for (int i = 0; i < 2; i++) {
+            if (macro_strings[i]) {
+                EXPECT_TRUE(send_string_async(macro_strings[i], macro_interval, on_complete, (void *)(intptr_t)(i + 1)));
+            }
+        }
+        return false;
+    }
+    return true;
+}
+}
+
+class SendStringAsync : public TestFixture {
+   public:
+    void SetUp() override {
+        macro_strings[0] = macro_strings[1] = nullptr;
+        macro_interval                      = 0;
+        completed.clear();
+    }
+};
+
+TEST_F(SendStringAsync, types_in_background) {
+    TestDriver driver;
+    auto       key_macro = KeymapKey(0, 0, 0, QK_USER);
+
+    set_keymap({key_macro});
+    macro_strings[0] = "aB";
+
+    InSequence s;
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT, KC_B));
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    EXPECT_EMPTY_REPORT(driver);
+
+    // The main loop carries on in between the reports
+    tap_key(key_macro);
+    EXPECT_TRUE(send_string_async_is_busy());
+    EXPECT_TRUE(completed.empty());
+
+    idle_for(10);
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_FALSE(send_string_async_is_busy());
+    EXPECT_EQ(completed, std::vector<int>({1}));
+}
+
+TEST_F(SendStringAsync, interval_between_reports) {
+    TestDriver driver;
+    auto       key_macro = KeymapKey(0, 0, 0, QK_USER);
+
+    set_keymap({key_macro});
+    macro_strings[0] = "ab";
+    macro_interval   = 10;
+
+    EXPECT_REPORT(driver, (KC_A));
+    key_macro.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_NO_REPORT(driver);
+    idle_for(8);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    idle_for(2);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    key_macro.release();
+    idle_for(50);
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_EQ(completed, std::vector<int>({1}));
+}
+
+TEST_F(SendStringAsync, key_events_wait_for_string) {
+    TestDriver driver;
+    auto       key_macro = KeymapKey(0, 0, 0, QK_USER);
+    auto       key_x     = KeymapKey(0, 1, 0, KC_X);
+
+    set_keymap({key_macro, key_x});
+    macro_strings[0] = "ab";
+    macro_interval   = 5;
+
+    InSequence s;
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_X));
+    EXPECT_EMPTY_REPORT(driver);
+
+    tap_key(key_macro);
+    tap_key(key_x);
+    idle_for(50);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringAsync, queued_strings_in_order) {
+    TestDriver driver;
+    auto       key_macro = KeymapKey(0, 0, 0, QK_USER);
+
+    set_keymap({key_macro});
+    macro_strings[0] = "a";
+    macro_strings[1] = "b" SS_TAP(X_ENTER);
+
+    InSequence s;
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_ENTER));
+    EXPECT_EMPTY_REPORT(driver);
+
+    tap_key(key_macro);
+    idle_for(20);
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_EQ(completed, std::vector<int>({1, 2}));
+}
+
+TEST_F(SendStringAsync, delay_code) {
+    TestDriver driver;
+    auto       key_macro = KeymapKey(0, 0, 0, QK_USER);
+
+    set_keymap({key_macro});
+    macro_strings[0] = "a" SS_DELAY(30) "b";
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_macro);
+    idle_for(20);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    idle_for(20);
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_EQ(completed, std::vector<int>({1}));
+}
+
+TEST_F(SendStringAsync, flush_types_everything_now) {
+    TestDriver driver;
+
+    InSequence s;
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+
+    EXPECT_TRUE(send_string_async("ab", 0, on_complete, (void *)1));
+    send_string_async_flush();
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_FALSE(send_string_async_is_busy());
+    EXPECT_EQ(completed, std::vector<int>({1}));
+
+    // Nothing is left to run
+    EXPECT_NO_REPORT(driver);
+    idle_for(10);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringAsync, full_event_buffer_finishes_string) {
+    TestDriver driver;
+    auto       key_macro = KeymapKey(0, 0, 0, QK_USER);
+    auto       key_x     = KeymapKey(0, 1, 0, KC_X);
+
+    set_keymap({key_macro, key_x});
+    macro_strings[0] = "abcdefgh";
+    macro_interval   = 50;
+
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    tap_key(key_macro);
+    // One release is held already, the taps overflow the buffer
+    for (int i = 0; i < SEND_STRING_ASYNC_EVENT_BUFFER_SIZE / 2; i++) {
+        tap_key(key_x);
+    }
+    EXPECT_FALSE(send_string_async_is_busy());
+    EXPECT_EQ(completed, std::vector<int>({1}));
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,14 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+// Benchmark against a full-size 6x22 matrix rather than the default test matrix.
+#undef MATRIX_ROWS
+#define MATRIX_ROWS 6
+#undef MATRIX_COLS
+#define MATRIX_COLS 22
+
+#define SOURCE_LAYERS_CACHE_BYTE_PER_KEY
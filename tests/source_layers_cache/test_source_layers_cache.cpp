@@ -0,0 +1,54 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <iostream>
+
+#include "test_common.hpp"
+
+extern "C" {
+#include "action_layer.h"
+}
+
+#ifdef SOURCE_LAYERS_CACHE_BYTE_PER_KEY
+#    define SOURCE_LAYERS_CACHE_LAYOUT "byte-per-key"
+#else
+#    define SOURCE_LAYERS_CACHE_LAYOUT "bit-sliced"
+#endif
+
+class SourceLayersCache : public TestFixture {};
+
+TEST_F(SourceLayersCache, EveryLayerRoundTripsWithoutDisturbingNeighbours) {
+    for (uint8_t layer = 0; layer < MAX_LAYER; layer++) {
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                update_source_layers_cache({.col = col, .row = row}, (layer + row + col) % MAX_LAYER);
+            }
+        }
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                EXPECT_EQ(read_source_layers_cache({.col = col, .row = row}), (layer + row + col) % MAX_LAYER);
+            }
+        }
+    }
+}
+
+TEST_F(SourceLayersCache, PressReleaseThroughput) {
+    const int iterations = 20000;
+    uint32_t  checksum   = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                keypos_t key = {.col = col, .row = row};
+                update_source_layers_cache(key, (i + col) % MAX_LAYER);
+                checksum += read_source_layers_cache(key);
+            }
+        }
+    }
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+
+    EXPECT_NE(checksum, UINT32_MAX);
+    std::cout << SOURCE_LAYERS_CACHE_LAYOUT << " source layers cache, " << MATRIX_ROWS << "x" << MATRIX_COLS << ": " << elapsed.count() / (iterations * MATRIX_ROWS * MATRIX_COLS) << " ns per press+release" << std::endl;
+}
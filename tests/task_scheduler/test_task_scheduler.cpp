@@ -0,0 +1,145 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string>
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+using testing::_;
+
+extern "C" {
+#include "task_scheduler.h"
+
+static uint32_t    fake_us          = 0;
+static uint32_t    cosmetic_cost_us = 0;
+static bool        pending_work     = false;
+static std::string task_log;
+
+uint32_t us_timer_read(void) {
+    return fake_us;
+}
+
+static void cosmetic_a(void) {
+    task_log += 'a';
+    fake_us += cosmetic_cost_us;
+}
+static void cosmetic_b(void) {
+    task_log += 'b';
+    fake_us += cosmetic_cost_us;
+}
+static void cosmetic_c(void) {
+    task_log += 'c';
+    fake_us += cosmetic_cost_us;
+}
+static void input(void) {
+    task_log += 'I';
+}
+static void periodic(void) {
+    task_log += 'P';
+}
+static void on_demand(void) {
+    task_log += 'D';
+}
+static bool has_pending_work(void) {
+    return pending_work;
+}
+
+// Cosmetic tasks are registered first to show that input tasks still run ahead of them
+static const task_scheduler_task_t test_tasks[] = {
+    {.task = cosmetic_a, .task_class = TASK_CLASS_COSMETIC, .timing_stage = TASK_SCHEDULER_UNTIMED},
+    {.task = cosmetic_b, .task_class = TASK_CLASS_COSMETIC, .timing_stage = TASK_SCHEDULER_UNTIMED},
+    {.task = cosmetic_c, .task_class = TASK_CLASS_COSMETIC, .timing_stage = TASK_SCHEDULER_UNTIMED},
+    {.task = input, .task_class = TASK_CLASS_INPUT, .timing_stage = TASK_SCHEDULER_UNTIMED},
+    {.task = periodic, .period_ms = 10, .task_class = TASK_CLASS_INPUT, .timing_stage = TASK_SCHEDULER_UNTIMED},
+    {.task = on_demand, .has_pending_work = has_pending_work, .task_class = TASK_CLASS_INPUT, .timing_stage = TASK_SCHEDULER_UNTIMED},
+};
+}
+
+class TaskScheduler : public TestFixture {
+   protected:
+    void SetUp() override {
+        for (auto &task : test_tasks) {
+            EXPECT_TRUE(task_scheduler_register(&task));
+        }
+        cosmetic_cost_us = 0;
+        pending_work     = false;
+        task_log.clear();
+    }
+
+    size_t count(char task) {
+        return std::count(task_log.begin(), task_log.end(), task);
+    }
+};
+
+TEST_F(TaskScheduler, InputTasksRunBeforeCosmeticTasks) {
+    TestDriver driver;
+    EXPECT_NO_REPORT(driver);
+    run_one_scan_loop();
+
+    size_t last_input = task_log.find_last_of("IP");
+    ASSERT_NE(last_input, std::string::npos);
+    EXPECT_EQ(task_log.find_first_of("abc"), last_input + 1);
+    EXPECT_EQ(count('a'), 1);
+    EXPECT_EQ(count('b'), 1);
+    EXPECT_EQ(count('c'), 1);
+}
+
+TEST_F(TaskScheduler, CosmeticTasksShareTheBudget) {
+    TestDriver driver;
+    EXPECT_NO_REPORT(driver);
+    /* Two tasks fit into the budget, the third one waits for the next loop */
+    cosmetic_cost_us = TASK_SCHEDULER_COSMETIC_BUDGET_US / 2 + 1;
+    run_one_scan_loop();
+    EXPECT_EQ(count('I'), 1);
+    EXPECT_EQ(count('a') + count('b') + count('c'), 2);
+
+    /* Round-robin gives each task the same share */
+    for (int i = 0; i < 2; i++) {
+        run_one_scan_loop();
+    }
+    EXPECT_EQ(count('I'), 3);
+    EXPECT_EQ(count('a'), 2);
+    EXPECT_EQ(count('b'), 2);
+    EXPECT_EQ(count('c'), 2);
+}
+
+TEST_F(TaskScheduler, OverBudgetTaskStillRuns) {
+    TestDriver driver;
+    EXPECT_NO_REPORT(driver);
+    cosmetic_cost_us = TASK_SCHEDULER_COSMETIC_BUDGET_US * 4;
+    for (int i = 0; i < 3; i++) {
+        run_one_scan_loop();
+    }
+    EXPECT_EQ(count('I'), 3);
+    EXPECT_EQ(count('a'), 1);
+    EXPECT_EQ(count('b'), 1);
+    EXPECT_EQ(count('c'), 1);
+}
+
+TEST_F(TaskScheduler, HonoursPeriod) {
+    TestDriver driver;
+    EXPECT_NO_REPORT(driver);
+    /* Every 10th loop, whatever the phase */
+    idle_for(30);
+    EXPECT_EQ(count('I'), 30);
+    EXPECT_EQ(count('P'), 3);
+}
+
+TEST_F(TaskScheduler, SkipsTasksWithoutPendingWork) {
+    TestDriver driver;
+    EXPECT_NO_REPORT(driver);
+    idle_for(5);
+    EXPECT_EQ(count('D'), 0);
+
+    pending_work = true;
+    idle_for(5);
+    EXPECT_EQ(count('D'), 5);
+}
+
+TEST_F(TaskScheduler, RegistersTasksOnce) {
+    TestDriver driver;
+    EXPECT_NO_REPORT(driver);
+    EXPECT_TRUE(task_scheduler_register(&test_tasks[3]));
+    run_one_scan_loop();
+    EXPECT_EQ(count('I'), 1);
+}
@@ -0,0 +1,4 @@
+# Copyright 2026 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+TASK_TIMING_ENABLE = yes
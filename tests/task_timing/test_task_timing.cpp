@@ -0,0 +1,186 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+using testing::_;
+
+extern "C" {
+#include "task_timing.h"
+
+/* Every clock read advances by 3us, so a stage with nothing timed inside it takes exactly 3us. */
+static uint32_t fake_us = 0;
+uint32_t        us_timer_read(void) {
+    return fake_us += 3;
+}
+}
+
+class TaskTiming : public TestFixture {
+   protected:
+    void SetUp() override {
+        task_timing_reset();
+    }
+
+    void command(uint8_t sub_command, uint8_t arg0 = 0, uint8_t arg1 = 0) {
+        memset(report, 0, sizeof(report));
+        report[0] = TASK_TIMING_RAW_HID_COMMAND_ID;
+        report[1] = sub_command;
+        report[2] = arg0;
+        report[3] = arg1;
+        EXPECT_TRUE(task_timing_raw_hid_receive(report, sizeof(report)));
+    }
+
+    int find_slot(task_timing_stage_t stage) {
+        command(id_task_timing_get_info);
+        uint8_t slots = report[3];
+        for (uint8_t slot = 0; slot < slots; slot++) {
+            command(id_task_timing_get_stage, slot);
+            if (report[3] == stage) {
+                return slot;
+            }
+        }
+        return -1;
+    }
+
+    uint32_t u32(uint8_t offset) {
+        return (report[offset] << 24) | (report[offset + 1] << 16) | (report[offset + 2] << 8) | report[offset + 3];
+    }
+
+    uint16_t u16(uint8_t offset) {
+        return (report[offset] << 8) | report[offset + 1];
+    }
+
+    uint8_t report[32];
+};
+
+TEST_F(TaskTiming, ReportsInfo) {
+    TestDriver driver;
+    EXPECT_NO_REPORT(driver);
+    run_one_scan_loop();
+
+    command(id_task_timing_get_info);
+    EXPECT_EQ(report[0], TASK_TIMING_RAW_HID_COMMAND_ID);
+    EXPECT_EQ(report[2], TASK_TIMING_PROTOCOL_VERSION);
+    EXPECT_GE(report[3], 4); // keyboard_task, matrix, quantum, host, ...
+    EXPECT_EQ(report[4], TASK_TIMING_MAX_STAGES);
+    EXPECT_EQ(report[5], TASK_TIMING_HISTOGRAM_BUCKETS);
+}
+
+TEST_F(TaskTiming, RecordsStageStatistics) {
+    TestDriver driver;
+    EXPECT_NO_REPORT(driver);
+    for (int i = 0; i < 10; i++) {
+        run_one_scan_loop();
+    }
+
+    int slot = find_slot(TASK_TIMING_MATRIX);
+    ASSERT_GE(slot, 0);
+
+    command(id_task_timing_get_stage, slot);
+    EXPECT_EQ(report[2], slot);
+    EXPECT_EQ(report[3], TASK_TIMING_MATRIX);
+    EXPECT_EQ(u32(4), 10);  // count
+    EXPECT_EQ(u32(8), 30);  // total
+    EXPECT_EQ(u16(12), 3);  // min
+    EXPECT_EQ(u16(14), 3);  // avg
+    EXPECT_EQ(u16(16), 3);  // max
+
+    /* 3us lands in the [2, 4) bucket */
+    command(id_task_timing_get_histogram, slot, 0);
+    EXPECT_EQ(report[4], 13);
+    EXPECT_EQ(u16(5 + 2 * 0), 0);
+    EXPECT_EQ(u16(5 + 2 * 1), 0);
+    EXPECT_EQ(u16(5 + 2 * 2), 10);
+    EXPECT_EQ(u16(5 + 2 * 3), 0);
+
+    command(id_task_timing_get_histogram, slot, 13);
+    EXPECT_EQ(report[4], TASK_TIMING_HISTOGRAM_BUCKETS - 13);
+}
+
+TEST_F(TaskTiming, NestedStagesIncludeInnerTime) {
+    TestDriver driver;
+    EXPECT_NO_REPORT(driver);
+    run_one_scan_loop();
+
+    int keyboard_slot = find_slot(TASK_TIMING_KEYBOARD_TASK);
+    int quantum_slot  = find_slot(TASK_TIMING_QUANTUM);
+    int host_slot     = find_slot(TASK_TIMING_HOST);
+    ASSERT_GE(keyboard_slot, 0);
+    ASSERT_GE(quantum_slot, 0);
+    ASSERT_GE(host_slot, 0);
+
+    command(id_task_timing_get_stage, host_slot);
+    uint16_t host_us = u16(16);
+    command(id_task_timing_get_stage, quantum_slot);
+    uint16_t quantum_us = u16(16);
+    command(id_task_timing_get_stage, keyboard_slot);
+    uint16_t keyboard_us = u16(16);
+
+    EXPECT_GT(quantum_us, host_us);
+    EXPECT_GT(keyboard_us, quantum_us);
+}
+
+TEST_F(TaskTiming, ResetClearsStatistics) {
+    TestDriver driver;
+    EXPECT_NO_REPORT(driver);
+    run_one_scan_loop();
+    int slot = find_slot(TASK_TIMING_MATRIX);
+    ASSERT_GE(slot, 0);
+
+    command(id_task_timing_reset);
+    command(id_task_timing_get_stage, slot);
+    EXPECT_EQ(u32(4), 0);
+    EXPECT_EQ(u16(12), 0);
+    EXPECT_EQ(u16(16), 0);
+}
+
+TEST_F(TaskTiming, StagesWithoutSlotAreCounted) {
+    TestDriver driver;
+    EXPECT_NO_REPORT(driver);
+    run_one_scan_loop();
+
+    // More stages than slots, each is counted once however often it runs
+    for (int i = 0; i < 2; i++) {
+        for (uint8_t stage = 0; stage < TASK_TIMING_STAGE_COUNT; stage++) {
+            task_timing_record((task_timing_stage_t)stage, us_timer_read());
+        }
+    }
+
+    command(id_task_timing_get_info);
+    EXPECT_EQ(report[3], TASK_TIMING_MAX_STAGES);
+    EXPECT_EQ(report[6], TASK_TIMING_STAGE_COUNT - TASK_TIMING_MAX_STAGES);
+}
+
+TEST_F(TaskTiming, SaturatesInsteadOfStopping) {
+    TestDriver driver;
+    EXPECT_NO_REPORT(driver);
+    run_one_scan_loop();
+    int slot = find_slot(TASK_TIMING_MATRIX);
+    ASSERT_GE(slot, 0);
+
+    // A start time just after the clock read inside, as a clock jumping backwards would give
+    task_timing_record(TASK_TIMING_MATRIX, us_timer_read() + 4);
+    command(id_task_timing_get_stage, slot);
+    EXPECT_EQ(u32(4), 2);
+    EXPECT_EQ(u32(8), UINT32_MAX);
+    EXPECT_EQ(u16(16), UINT16_MAX);
+
+    // Later samples are still counted
+    run_one_scan_loop();
+    command(id_task_timing_get_stage, slot);
+    EXPECT_EQ(u32(4), 3);
+    EXPECT_EQ(u32(8), UINT32_MAX);
+    EXPECT_EQ(u16(12), 3);
+}
+
+TEST_F(TaskTiming, RejectsUnknownCommands) {
+    command(0x7F);
+    EXPECT_EQ(report[0], 0xFF);
+
+    command(id_task_timing_get_stage, TASK_TIMING_MAX_STAGES);
+    EXPECT_EQ(report[0], 0xFF);
+
+    report[0] = 0x01;
+    EXPECT_FALSE(task_timing_raw_hid_receive(report, sizeof(report)));
+}
@@ -31,15 +31,12 @@ namespace {
 
 std::vector<uint8_t> get_keys(const report_keyboard_t& report) {
     std::vector<uint8_t> result;
-#if defined(NKRO_ENABLE)
-#    error NKRO support not implemented yet
-#else
+    // NKRO has a report of its own, this is always the 6KRO one
     for (size_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
         if (report.keys[i]) {
             result.emplace_back(report.keys[i]);
         }
     }
-#endif
     std::sort(result.begin(), result.end());
     return result;
 }
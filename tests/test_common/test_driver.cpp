@@ -15,6 +15,9 @@
  */
 
 #include "test_driver.hpp"
+#include <algorithm>
+#include <iterator>
+#include "timer.h"
 
 TestDriver* TestDriver::m_this = nullptr;
 
@@ -46,9 +49,33 @@ uint8_t TestDriver::keyboard_leds(void) {
 
 void TestDriver::send_keyboard(report_keyboard_t* report) {
     test_logger.trace() << *report;
+    if (m_this->m_strict_host) {
+        m_this->check_strict_host(*report);
+    }
     m_this->send_keyboard_mock(*report);
 }
 
+void TestDriver::check_strict_host(const report_keyboard_t& report) {
+    int pressed = 0;
+    for (uint8_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+        if (report.keys[i] && !std::count(std::begin(m_last_report.keys), std::end(m_last_report.keys), report.keys[i])) {
+            pressed++;
+        }
+    }
+    if (pressed && report.mods != m_last_report.mods) {
+        ADD_FAILURE() << "a key is pressed while the modifiers change, from " << m_last_report << "to " << report;
+    }
+    if (pressed > 1) {
+        ADD_FAILURE() << pressed << " keys are pressed in one report, from " << m_last_report << "to " << report;
+    }
+    if (m_has_sent && timer_elapsed32(m_last_sent) < m_min_interval) {
+        ADD_FAILURE() << "report sent " << timer_elapsed32(m_last_sent) << "ms after the one before it, less than " << m_min_interval << "ms";
+    }
+    m_last_report = report;
+    m_has_sent    = true;
+    m_last_sent   = timer_read32();
+}
+
 void TestDriver::send_nkro(report_nkro_t* report) {
     m_this->send_nkro_mock(*report);
 }
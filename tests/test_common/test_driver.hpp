@@ -33,6 +33,16 @@ class TestDriver {
         m_leds = leds;
     }
 
+    /**
+     * @brief Checks every keyboard report against the one before it, the way a strict host sees them.
+     * The test fails when a report presses a key while the modifiers change, presses more than one key,
+     * or comes less than `min_interval` milliseconds after the report before it.
+     */
+    void expect_strict_host(uint32_t min_interval = 0) {
+        m_strict_host  = true;
+        m_min_interval = min_interval;
+    }
+
     MOCK_METHOD1(send_keyboard_mock, void(report_keyboard_t&));
     MOCK_METHOD1(send_nkro_mock, void(report_nkro_t&));
     MOCK_METHOD1(send_mouse_mock, void(report_mouse_t&));
@@ -44,8 +54,14 @@ class TestDriver {
     static void        send_nkro(report_nkro_t* report);
     static void        send_mouse(report_mouse_t* report);
     static void        send_extra(report_extra_t* report);
+    void               check_strict_host(const report_keyboard_t& report);
     host_driver_t      m_driver;
     uint8_t            m_leds = 0;
+    bool               m_strict_host  = false;
+    uint32_t           m_min_interval = 0;
+    report_keyboard_t  m_last_report  = {};
+    bool               m_has_sent     = false;
+    uint32_t           m_last_sent    = 0;
     static TestDriver* m_this;
 };
 
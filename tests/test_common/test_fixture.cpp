@@ -104,6 +104,12 @@ void TestFixture::add_key(KeymapKey key) {
     }
 
     this->keymap.push_back(key);
+#if !defined(NO_ACTION_LAYER) && defined(LAYER_RESOLUTION_CACHE_ENABLE)
+    layer_resolution_cache_invalidate();
+#endif
+#ifdef MATRIX_HAS_GHOST
+    matrix_real_keys_invalidate();
+#endif
 }
 
 void TestFixture::tap_key(KeymapKey key, unsigned delay_ms) {
@@ -131,6 +137,12 @@ void TestFixture::tap_combo(const std::vector<KeymapKey>& chord_keys, unsigned d
 
 void TestFixture::set_keymap(std::initializer_list<KeymapKey> keys) {
     this->keymap.clear();
+#if !defined(NO_ACTION_LAYER) && defined(LAYER_RESOLUTION_CACHE_ENABLE)
+    layer_resolution_cache_invalidate();
+#endif
+#ifdef MATRIX_HAS_GHOST
+    matrix_real_keys_invalidate();
+#endif
     for (auto& key : keys) {
         add_key(key);
     }
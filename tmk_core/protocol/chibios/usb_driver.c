@@ -74,6 +74,13 @@ static void obnotify(io_buffers_queue_t *bqp) {
     }
 }
 
+/**
+ * @brief   The number of reports in the output buffers queue, including the one being transmitted.
+ */
+static uint8_t usb_endpoint_in_depth_i(usb_endpoint_in_t *endpoint) {
+    return endpoint->obqueue.bn - bqSpaceI(&endpoint->obqueue);
+}
+
 /*===========================================================================*/
 /* Driver exported functions.                                                */
 /*===========================================================================*/
@@ -127,6 +134,7 @@ void usb_endpoint_in_stop(usb_endpoint_in_t *endpoint) {
     if (endpoint->report_storage != NULL) {
         endpoint->report_storage->reset_report(endpoint->report_storage->reports);
     }
+    endpoint->last_report.length = 0;
     osalOsRescheduleS();
     osalSysUnlock();
 }
@@ -146,6 +154,7 @@ void usb_endpoint_out_stop(usb_endpoint_out_t *endpoint) {
 void usb_endpoint_in_suspend_cb(usb_endpoint_in_t *endpoint) {
     bqSuspendI(&endpoint->obqueue);
     obqResetI(&endpoint->obqueue);
+    endpoint->last_report.length = 0;
 
     if (endpoint->report_storage != NULL) {
         endpoint->report_storage->reset_report(endpoint->report_storage->reports);
@@ -169,6 +178,7 @@ void usb_endpoint_in_configure_cb(usb_endpoint_in_t *endpoint) {
     usbInitEndpointI(endpoint->config.usbp, endpoint->config.ep, &endpoint->ep_config);
     obqResetI(&endpoint->obqueue);
     bqResumeX(&endpoint->obqueue);
+    endpoint->last_report.length = 0;
 }
 
 void usb_endpoint_out_configure_cb(usb_endpoint_out_t *endpoint) {
@@ -267,6 +277,12 @@ bool usb_endpoint_in_send(usb_endpoint_in_t *endpoint, const uint8_t *data, size
     if (endpoint->timed_out && timeout != TIME_INFINITE) {
         timeout = TIME_IMMEDIATE;
     }
+
+    /* Every buffer is waiting for the host, so the write below blocks until
+     * the next transfer completes. */
+    if (!buffered && bqSpaceI(&endpoint->obqueue) == 0) {
+        endpoint->stats.stalls++;
+    }
     osalSysUnlock();
 
     while (true) {
@@ -275,6 +291,8 @@ bool usb_endpoint_in_send(usb_endpoint_in_t *endpoint, const uint8_t *data, size
         if (sent < size) {
             osalSysLock();
             endpoint->timed_out |= sent == 0;
+            endpoint->stats.dropped += usb_endpoint_in_depth_i(endpoint);
+            endpoint->last_report.length = 0;
             bqSuspendI(&endpoint->obqueue);
             obqResetI(&endpoint->obqueue);
             bqResumeX(&endpoint->obqueue);
@@ -287,6 +305,19 @@ bool usb_endpoint_in_send(usb_endpoint_in_t *endpoint, const uint8_t *data, size
             obqFlush(&endpoint->obqueue);
         }
 
+        osalSysLock();
+        endpoint->stats.sent++;
+        endpoint->stats.max_depth = MAX(endpoint->stats.max_depth, usb_endpoint_in_depth_i(endpoint));
+        /* Buffered sends are pieces of a stream rather than reports. */
+        if (buffered) {
+            endpoint->last_report.length = 0;
+        } else {
+            memcpy(endpoint->last_report.data, data, size);
+            endpoint->last_report.length   = size;
+            endpoint->last_report.protocol = usb_device_state_get_protocol();
+        }
+        osalSysUnlock();
+
         return true;
     }
 }
@@ -320,6 +351,43 @@ bool usb_endpoint_in_is_inactive(usb_endpoint_in_t *endpoint) {
     return inactive;
 }
 
+/**
+ * @brief Whether a report is the same as the last one queued on the endpoint in
+ * the current protocol, which the host has or will have once the queue drains.
+ * Only meaningful for reports that carry the whole state, like keyboard reports.
+ */
+bool usb_endpoint_in_is_duplicate(usb_endpoint_in_t *endpoint, const uint8_t *data, size_t size) {
+    osalDbgCheck((endpoint != NULL) && (data != NULL) && (size > 0U));
+
+    usb_endpoint_in_last_report_t *last = &endpoint->last_report;
+
+    osalSysLock();
+    bool duplicate = last->length == size && last->protocol == usb_device_state_get_protocol() && memcmp(last->data, data, size) == 0;
+    if (duplicate) {
+        endpoint->stats.deduplicated++;
+    }
+    osalSysUnlock();
+
+    return duplicate;
+}
+
+void usb_endpoint_in_get_stats(usb_endpoint_in_t *endpoint, usb_endpoint_in_stats_t *stats) {
+    osalDbgCheck((endpoint != NULL) && (stats != NULL));
+
+    osalSysLock();
+    *stats       = endpoint->stats;
+    stats->depth = usb_endpoint_in_depth_i(endpoint);
+    osalSysUnlock();
+}
+
+void usb_endpoint_in_reset_stats(usb_endpoint_in_t *endpoint) {
+    osalDbgCheck(endpoint != NULL);
+
+    osalSysLock();
+    memset(&endpoint->stats, 0, sizeof(usb_endpoint_in_stats_t));
+    osalSysUnlock();
+}
+
 bool usb_endpoint_out_receive(usb_endpoint_out_t *endpoint, uint8_t *data, size_t size, sysinterval_t timeout) {
     osalDbgCheck((endpoint != NULL) && (data != NULL) && (size > 0U));
 
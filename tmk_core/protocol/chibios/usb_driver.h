@@ -10,6 +10,7 @@
 #include "usb_descriptor.h"
 #include "chibios_config.h"
 #include "usb_report_handling.h"
+#include "usb_device_state.h"
 #include "string.h"
 #include "timer.h"
 
@@ -36,6 +37,7 @@
 #define QMK_USB_ENDPOINT_IN(mode, ep_size, ep_num, _buffer_capacity, _usb_requests_cb, _report_storage) \
     {                                                                                                   \
         .usb_requests_cb = _usb_requests_cb, .report_storage = _report_storage,                         \
+        .last_report = {.data = (uint8_t[ep_size]){0}},                                                 \
         .ep_config =                                                                                    \
             {                                                                                           \
                 mode,                           /* EP Mode */                                           \
@@ -87,6 +89,7 @@
 #    define QMK_USB_ENDPOINT_IN_SHARED(mode, ep_size, ep_num, _buffer_capacity, _usb_requests_cb, _report_storage) \
         {                                                                                                          \
             .usb_requests_cb = _usb_requests_cb, .is_shared = true, .report_storage = _report_storage,             \
+            .last_report = {.data = (uint8_t[ep_size]){0}},                                                        \
             .ep_config =                                                                                           \
                 {                                                                                                  \
                     mode,                            /* EP Mode */                                                 \
@@ -154,6 +157,61 @@ typedef struct {
     uint8_t *buffer;
 } usb_endpoint_config_t;
 
+/**
+ * @brief Counters of an IN endpoint's report queue, to size its capacity
+ */
+typedef struct {
+    /**
+     * @brief The number of reports queued, including the one being transmitted
+     */
+    uint8_t depth;
+
+    /**
+     * @brief The highest depth seen since the counters were reset
+     */
+    uint8_t max_depth;
+
+    /**
+     * @brief Reports handed to the endpoint
+     */
+    uint32_t sent;
+
+    /**
+     * @brief Reports that were not queued because they repeated the report before them
+     */
+    uint32_t deduplicated;
+
+    /**
+     * @brief Sends that had to wait for a free buffer, stalling the caller
+     */
+    uint32_t stalls;
+
+    /**
+     * @brief Queued reports discarded after the host did not poll the endpoint in time
+     */
+    uint32_t dropped;
+} usb_endpoint_in_stats_t;
+
+/**
+ * @brief The last report an IN endpoint queued, to skip sending it again
+ */
+typedef struct {
+    /**
+     * @brief Copy of the report, as large as the endpoint's buffers
+     */
+    uint8_t *data;
+
+    /**
+     * @brief Size of the report, 0 while the report the host has last is not known
+     */
+    size_t length;
+
+    /**
+     * @brief The protocol the report was queued in, boot protocol keyboard reports lack the report ID
+     */
+    usb_hid_protocol_t protocol;
+} usb_endpoint_in_last_report_t;
+
 typedef struct {
     output_buffers_queue_t obqueue;
     USBEndpointConfig      ep_config;
@@ -162,10 +220,12 @@ typedef struct {
     USBOutEndpointState ep_out_state;
     bool                is_shared;
 #endif
-    usb_endpoint_config_t config;
-    usbreqhandler_t       usb_requests_cb;
-    bool                  timed_out;
-    usb_report_storage_t *report_storage;
+    usb_endpoint_config_t         config;
+    usbreqhandler_t               usb_requests_cb;
+    bool                          timed_out;
+    usb_report_storage_t         *report_storage;
+    usb_endpoint_in_stats_t       stats;
+    usb_endpoint_in_last_report_t last_report;
 } usb_endpoint_in_t;
 
 typedef struct {
@@ -187,6 +247,10 @@ void usb_endpoint_in_stop(usb_endpoint_in_t *endpoint);
 bool usb_endpoint_in_send(usb_endpoint_in_t *endpoint, const uint8_t *data, size_t size, sysinterval_t timeout, bool buffered);
 void usb_endpoint_in_flush(usb_endpoint_in_t *endpoint, bool padded);
 bool usb_endpoint_in_is_inactive(usb_endpoint_in_t *endpoint);
+bool usb_endpoint_in_is_duplicate(usb_endpoint_in_t *endpoint, const uint8_t *data, size_t size);
+
+void usb_endpoint_in_get_stats(usb_endpoint_in_t *endpoint, usb_endpoint_in_stats_t *stats);
+void usb_endpoint_in_reset_stats(usb_endpoint_in_t *endpoint);
 
 void usb_endpoint_in_suspend_cb(usb_endpoint_in_t *endpoint);
 void usb_endpoint_in_wakeup_cb(usb_endpoint_in_t *endpoint);
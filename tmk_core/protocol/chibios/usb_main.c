@@ -393,6 +393,103 @@ bool send_report(usb_endpoint_in_lut_t endpoint, void *report, size_t size) {
     return usb_endpoint_in_send(&usb_endpoints_in[endpoint], (uint8_t *)report, size, TIME_MS2I(100), false);
 }
 
+/**
+ * @brief Send a report that carries the whole state of its device, unless it
+ * repeats the last report queued on the endpoint in the same protocol, which
+ * the host already has or gets once the queue drains. This keeps the queue
+ * free for reports that change something.
+ *
+ * @param endpoint USB IN endpoint to send the report from
+ * @param report pointer to the report
+ * @param size size of the report
+ * @return true Success
+ * @return false Failure
+ */
+static bool send_report_deduplicated(usb_endpoint_in_lut_t endpoint, void *report, size_t size) {
+    if (usb_endpoint_in_is_duplicate(&usb_endpoints_in[endpoint], (uint8_t *)report, size)) {
+        return true;
+    }
+    return send_report(endpoint, report, size);
+}
+
+/**
+ * @brief Read the counters of the report queue of an IN endpoint.
+ *
+ * @param endpoint USB IN endpoint to read the counters of
+ * @param stats the counters
+ */
+void usb_get_endpoint_in_stats(usb_endpoint_in_lut_t endpoint, usb_endpoint_in_stats_t *stats) {
+    usb_endpoint_in_get_stats(&usb_endpoints_in[endpoint], stats);
+}
+
+/**
+ * @brief Reset the counters of the report queue of an IN endpoint.
+ *
+ * @param endpoint USB IN endpoint to reset the counters of
+ */
+void usb_reset_endpoint_in_stats(usb_endpoint_in_lut_t endpoint) {
+    usb_endpoint_in_reset_stats(&usb_endpoints_in[endpoint]);
+}
+
+#if defined(RAW_ENABLE) && defined(USB_ENDPOINT_STATS_RAW_HID_ENABLE)
+static uint8_t *put_u32(uint8_t *data, uint32_t value) {
+    *data++ = value >> 24;
+    *data++ = value >> 16;
+    *data++ = value >> 8;
+    *data++ = value;
+    return data;
+}
+
+bool usb_endpoint_stats_raw_hid_receive(uint8_t *data, uint8_t length) {
+    // data = [ command_id, sub_command_id, args... ]
+    if (data[0] != USB_ENDPOINT_STATS_RAW_HID_COMMAND_ID) {
+        return false;
+    }
+
+    uint8_t *command_data = &data[2];
+    switch (data[1]) {
+        case id_usb_endpoint_stats_get_info: {
+            command_data[0] = USB_ENDPOINT_IN_COUNT;
+            break;
+        }
+        case id_usb_endpoint_stats_get_endpoint: {
+            uint8_t index = command_data[0];
+            if (index >= USB_ENDPOINT_IN_COUNT) {
+                data[0] = 0xFF;
+                break;
+            }
+
+            usb_endpoint_in_stats_t stats;
+            usb_get_endpoint_in_stats(index, &stats);
+            uint8_t *out = &command_data[1];
+
+            *out++ = usb_endpoints_in[index].config.ep;
+            *out++ = usb_endpoints_in[index].config.buffer_capacity;
+            *out++ = stats.depth;
+            *out++ = stats.max_depth;
+            out    = put_u32(out, stats.sent);
+            out    = put_u32(out, stats.deduplicated);
+            out    = put_u32(out, stats.stalls);
+            put_u32(out, stats.dropped);
+            break;
+        }
+        case id_usb_endpoint_stats_reset: {
+            for (uint8_t i = 0; i < USB_ENDPOINT_IN_COUNT; i++) {
+                usb_reset_endpoint_in_stats(i);
+            }
+            break;
+        }
+        default: {
+            // The sub-command is not known
+            // Return the unhandled state
+            data[0] = 0xFF;
+            break;
+        }
+    }
+    return true;
+}
+#endif
+
 /**
  * @brief Send a report to the host, but delay the sending until the size of
  * endpoint report is reached or the incompletely filled buffer is flushed with
@@ -437,15 +534,15 @@ static bool receive_report(usb_endpoint_out_lut_t endpoint, void *report, size_t
 void send_keyboard(report_keyboard_t *report) {
     /* If we're in Boot Protocol, don't send any report ID or other funky fields */
     if (usb_device_state_get_protocol() == USB_PROTOCOL_BOOT) {
-        send_report(USB_ENDPOINT_IN_KEYBOARD, &report->mods, 8);
+        send_report_deduplicated(USB_ENDPOINT_IN_KEYBOARD, &report->mods, 8);
     } else {
-        send_report(USB_ENDPOINT_IN_KEYBOARD, report, KEYBOARD_REPORT_SIZE);
+        send_report_deduplicated(USB_ENDPOINT_IN_KEYBOARD, report, KEYBOARD_REPORT_SIZE);
     }
 }
 
 void send_nkro(report_nkro_t *report) {
 #ifdef NKRO_ENABLE
-    send_report(USB_ENDPOINT_IN_SHARED, report, sizeof(report_nkro_t));
+    send_report_deduplicated(USB_ENDPOINT_IN_SHARED, report, sizeof(report_nkro_t));
 #endif
 }
 
@@ -456,7 +553,12 @@ void send_nkro(report_nkro_t *report) {
 
 void send_mouse(report_mouse_t *report) {
 #ifdef MOUSE_ENABLE
-    send_report(USB_ENDPOINT_IN_MOUSE, report, sizeof(report_mouse_t));
+    /* Movement is relative, so only a report without any is a repeat */
+    if (report->x == 0 && report->y == 0 && report->h == 0 && report->v == 0) {
+        send_report_deduplicated(USB_ENDPOINT_IN_MOUSE, report, sizeof(report_mouse_t));
+    } else {
+        send_report(USB_ENDPOINT_IN_MOUSE, report, sizeof(report_mouse_t));
+    }
 #endif
 }
 
@@ -467,7 +569,7 @@ void send_mouse(report_mouse_t *report) {
 
 void send_extra(report_extra_t *report) {
 #ifdef EXTRAKEY_ENABLE
-    send_report(USB_ENDPOINT_IN_SHARED, report, sizeof(report_extra_t));
+    send_report_deduplicated(USB_ENDPOINT_IN_SHARED, report, sizeof(report_extra_t));
 #endif
 }
 
@@ -517,7 +619,7 @@ void send_raw_hid(uint8_t *data, uint8_t length) {
 void raw_hid_task(void) {
     uint8_t buffer[RAW_EPSIZE];
     while (receive_report(USB_ENDPOINT_OUT_RAW, buffer, sizeof(buffer))) {
-        raw_hid_receive(buffer, sizeof(buffer));
+        raw_hid_receive_quantum(buffer, sizeof(buffer));
     }
 }
 
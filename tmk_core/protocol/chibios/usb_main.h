@@ -34,6 +34,28 @@ void restart_usb_driver(USBDriver *usbp);
 
 bool send_report(usb_endpoint_in_lut_t endpoint, void *report, size_t size);
 
+/* Read and reset the counters of an IN endpoint's report queue */
+void usb_get_endpoint_in_stats(usb_endpoint_in_lut_t endpoint, usb_endpoint_in_stats_t *stats);
+void usb_reset_endpoint_in_stats(usb_endpoint_in_lut_t endpoint);
+
+#if defined(RAW_ENABLE) && defined(USB_ENDPOINT_STATS_RAW_HID_ENABLE)
+
+/* Raw HID sub-commands, sent as [ USB_ENDPOINT_STATS_RAW_HID_COMMAND_ID, sub-command, ... ] */
+enum usb_endpoint_stats_command_id {
+    id_usb_endpoint_stats_get_info     = 0x01, // -> [ endpoint count ]
+    id_usb_endpoint_stats_get_endpoint = 0x02, // [ index ] -> [ index, endpoint, capacity, depth, max depth, sent:4, deduplicated:4, stalls:4, dropped:4 ]
+    id_usb_endpoint_stats_reset        = 0x03,
+};
+
+#    ifndef USB_ENDPOINT_STATS_RAW_HID_COMMAND_ID
+#        define USB_ENDPOINT_STATS_RAW_HID_COMMAND_ID 0xFB
+#    endif
+
+/* Answer a raw HID report if it is a command for the IN endpoint counters, returns false for any other report */
+bool usb_endpoint_stats_raw_hid_receive(uint8_t *data, uint8_t length);
+
+#endif
+
 /* ---------------
  * USB Event queue
  * ---------------
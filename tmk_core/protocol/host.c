@@ -36,6 +36,14 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #    include "connection.h"
 #endif
 
+#ifdef LATENCY_TRACE_ENABLE
+#    include "latency_trace.h"
+#endif
+
+#ifdef REPORT_COALESCE_ENABLE
+#    include "report_coalesce.h"
+#endif
+
 #ifdef BLUETOOTH_ENABLE
 #    include "bluetooth.h"
 
@@ -95,6 +103,10 @@ static void host_update_active_driver(connection_host_t current, connection_host
 
     if (current != CONNECTION_HOST_NONE) {
         clear_keyboard();
+#    ifdef REPORT_COALESCE_ENABLE
+        // The releases go to the host that saw the presses
+        report_coalesce_flush();
+#    endif
     }
 
     host_connect_active_driver_user(next);
@@ -116,6 +128,10 @@ void host_task(void) {
         active_host = next_host;
     }
 #endif
+
+#ifdef REPORT_COALESCE_ENABLE
+    report_coalesce_task();
+#endif
 }
 
 static host_driver_t *host_get_active_driver(void) {
@@ -175,6 +191,18 @@ led_t host_keyboard_led_state(void) {
 
 /* send report */
 void host_keyboard_send(report_keyboard_t *report) {
+#ifdef REPORT_COALESCE_ENABLE
+    report_coalesce_keyboard(report);
+#else
+    host_keyboard_send_now(report);
+#endif
+}
+
+void host_keyboard_send_now(report_keyboard_t *report) {
+#ifdef REPORT_COALESCE_ENABLE
+    // Also for reports sent around the queue, which the next queued one is compared against
+    report_coalesce_keyboard_sent(report);
+#endif
     host_driver_t *driver = host_get_active_driver();
     if (!driver || !driver->send_keyboard) return;
 
@@ -182,6 +210,9 @@ void host_keyboard_send(report_keyboard_t *report) {
     report->report_id = REPORT_ID_KEYBOARD;
 #endif
     (*driver->send_keyboard)(report);
+#ifdef LATENCY_TRACE_ENABLE
+    latency_trace_report_sent();
+#endif
 
     if (debug_keyboard) {
         dprintf("keyboard_report: %02X | ", report->mods);
@@ -193,11 +224,25 @@ void host_keyboard_send(report_keyboard_t *report) {
 }
 
 void host_nkro_send(report_nkro_t *report) {
+#if defined(REPORT_COALESCE_ENABLE) && defined(NKRO_ENABLE)
+    report_coalesce_nkro(report);
+#else
+    host_nkro_send_now(report);
+#endif
+}
+
+void host_nkro_send_now(report_nkro_t *report) {
+#if defined(REPORT_COALESCE_ENABLE) && defined(NKRO_ENABLE)
+    report_coalesce_nkro_sent(report);
+#endif
     host_driver_t *driver = host_get_active_driver();
     if (!driver || !driver->send_nkro) return;
 
     report->report_id = REPORT_ID_NKRO;
     (*driver->send_nkro)(report);
+#ifdef LATENCY_TRACE_ENABLE
+    latency_trace_report_sent();
+#endif
 
     if (debug_keyboard) {
         dprintf("nkro_report: %02X | ", report->mods);
@@ -209,6 +254,17 @@ void host_nkro_send(report_nkro_t *report) {
 }
 
 void host_mouse_send(report_mouse_t *report) {
+#if defined(REPORT_COALESCE_ENABLE) && defined(MOUSE_ENABLE)
+    report_coalesce_mouse(report);
+#else
+    host_mouse_send_now(report);
+#endif
+}
+
+void host_mouse_send_now(report_mouse_t *report) {
+#if defined(REPORT_COALESCE_ENABLE) && defined(MOUSE_ENABLE)
+    report_coalesce_mouse_sent(report);
+#endif
     host_driver_t *driver = host_get_active_driver();
     if (!driver || !driver->send_mouse) return;
 
@@ -227,28 +283,37 @@ void host_system_send(uint16_t usage) {
     if (usage == last_system_usage) return;
     last_system_usage = usage;
 
-    host_driver_t *driver = host_get_active_driver();
-    if (!driver || !driver->send_extra) return;
-
     report_extra_t report = {
         .report_id = REPORT_ID_SYSTEM,
         .usage     = usage,
     };
-    (*driver->send_extra)(&report);
+#if defined(REPORT_COALESCE_ENABLE) && defined(EXTRAKEY_ENABLE)
+    report_coalesce_extra(&report);
+#else
+    host_extra_send_now(&report);
+#endif
 }
 
 void host_consumer_send(uint16_t usage) {
     if (usage == last_consumer_usage) return;
     last_consumer_usage = usage;
 
-    host_driver_t *driver = host_get_active_driver();
-    if (!driver || !driver->send_extra) return;
-
     report_extra_t report = {
         .report_id = REPORT_ID_CONSUMER,
         .usage     = usage,
     };
-    (*driver->send_extra)(&report);
+#if defined(REPORT_COALESCE_ENABLE) && defined(EXTRAKEY_ENABLE)
+    report_coalesce_extra(&report);
+#else
+    host_extra_send_now(&report);
+#endif
+}
+
+void host_extra_send_now(report_extra_t *report) {
+    host_driver_t *driver = host_get_active_driver();
+    if (!driver || !driver->send_extra) return;
+
+    (*driver->send_extra)(report);
 }
 
 #ifdef JOYSTICK_ENABLE
@@ -46,6 +46,12 @@ void    host_consumer_send(uint16_t usage);
 void    host_programmable_button_send(uint32_t data);
 void    host_raw_hid_send(uint8_t *data, uint8_t length);
 
+/* send a report right away, even with REPORT_COALESCE_ENABLE */
+void host_keyboard_send_now(report_keyboard_t *report);
+void host_nkro_send_now(report_nkro_t *report);
+void host_mouse_send_now(report_mouse_t *report);
+void host_extra_send_now(report_extra_t *report);
+
 uint16_t host_last_system_usage(void);
 uint16_t host_last_consumer_usage(void);
 